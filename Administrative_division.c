@@ -5,10 +5,66 @@
  * @date 2024-12-09
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <ctype.h>
+#include <stdint.h>
+#include <signal.h>
+#include <time.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <pthread.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <iconv.h>
+#endif
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#include <linux/futex.h>
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1
+#endif
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define THREAD_LOCAL __declspec(thread)
+#define POPCOUNT64(x) ((int)__popcnt64(x))
+#define CTZ64(x) ((int)_tzcnt_u64(x))
+#else
+#define THREAD_LOCAL __thread
+#define POPCOUNT64(x) __builtin_popcountll(x)
+#define CTZ64(x) __builtin_ctzll(x)
+#endif
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 /**
  * @brief 系统常量定义
@@ -18,6 +74,76 @@
 #define MAX_CODE_LENGTH 20     ///< 地区代码最大字符数
 #define MAX_LINE_LENGTH 1024   ///< CSV单行最大字符数
 #define MAX_REGIONS 700000     ///< 系统支持的最大地区数量
+#define CODE_SCHEME_MAX_LEVELS 5  ///< 代码方案最多级数（不含虚拟根节点，与各级数组一致）
+#define CODE_SCHEME_MAX_DIGITS 18  ///< 代码方案最多位数（代码须能存为64位整数）
+#define CODE_BLOCK_SIZE 128    ///< 代码列每块代码数（4路交错存储，须为4的倍数）
+#define CODE_BLOCK_RAW 64      ///< 块位宽标记：跨度超过32位的块按原始64位存储
+#define HUGE_PAGE_SIZE (2u << 20) ///< 大页尺寸，内存区按此对齐
+#define MAX_NUMA_NODES 64      ///< 支持的最大NUMA节点数
+#define INDEX_BLOB_MAGIC "ADIDX003"      ///< 索引文件标识（含版本）
+#define INDEX_BLOB_BYTE_ORDER 0x01020304u ///< 字节序标记，与生成时不一致则拒绝加载
+#define MPH_KEYS_PER_BUCKET 5  ///< 完美哈希平均每桶键数（16位引导值约3.2位/键）
+#define MPH_LOAD_PERCENT 99    ///< 完美哈希中间表装载率
+#define FILTER_MAX_TYPES 16    ///< 查询条件中类型列表的最大长度
+#define QUERY_ARG_MAX 512      ///< 服务请求参数（含查询语句）最大字节数
+#define QL_DEFAULT_LIMIT 100   ///< 查询语句未写LIMIT时的结果条数
+#define QL_MAX_LIMIT 10000     ///< 查询语句LIMIT上限
+#define QL_MAX_FIELDS 8        ///< RETURN最多字段数
+#define QL_MAX_TERMS 8         ///< 一条语句中以集合运算连接的子查询数
+#define BITMAP_ARRAY_MAX 4096  ///< 位图容器元素不超过此数时以有序数组存储
+#define BITMAP_WORDS 1024      ///< 位图容器的64位字数（覆盖低16位）
+#define RESOLVE_BATCH_BYTES (256u << 10) ///< 地址解析每批输入字节上限
+#define RESOLVE_BATCH_LINES 4096 ///< 地址解析每批行数上限
+#define RESOLVE_BATCHES 32     ///< 地址解析流水线中的批对象数（决定内存上限）
+#define RESOLVE_MAX_THREADS 64 ///< 地址解析每阶段最多线程数
+#define PIPE_QUEUE_SIZE 64     ///< 流水线队列槽位数（2的幂，不小于批对象数）
+#define RESOLVE_MAX_STATES 4096 ///< 单条地址解析的候选状态上限
+#define RESOLVE_MAX_GAP 12     ///< 候选链中连续跳过的未识别字节上限
+#define RESOLVE_SKIP_PENALTY 4 ///< 候选链每跳过一级的扣分
+#define RESOLVE_STEM_PENALTY 2 ///< 以专名（省略通名）匹配的扣分
+#define RESOLVE_BEAM_MARGIN 20 ///< 得分低于已知最高得分超过此值的候选链不再展开
+#define RESOLVE_MIN_COVERED 9  ///< 候选链至少识别的字节数（三个汉字），不足时视为未解析
+#define BOUNDARY_MAX_CELLS (1 << 22) ///< 边界网格格数上限
+#define BOUNDARY_MAX_FILES 8   ///< 命令行最多指定的边界文件数
+#define CENTROID_LEVELS 6      ///< 质心索引按级别（1-5）分别建树
+#define COLLATION_LEVELS 6     ///< 名称排序按级别（0-5）分段
+#define COLLATION_PINYIN_KEY 0x8000   ///< 拼音表内汉字的两字节排序键起点（首字节0x80-0xDF）
+#define COLLATION_GBK_KEY 0xE00000    ///< 拼音表外的GBK字符：0xE0加GBK两字节，排在拼音表内汉字之后
+#define NEAREST_DEFAULT_K 10   ///< 最近区划查询默认返回条数
+#define EARTH_RADIUS_KM 6371.0088 ///< 地球平均半径（千米）
+#define NEIGHBOR_MAX_HOPS 16   ///< 邻接查询最大跳数
+#define SAMPLE_MAX_TYPES 64    ///< 分层抽样时一个级别最多的类型数
+#define SAMPLE_MAX_PER_STRATUM 100000 ///< 分层抽样每层最多条数
+#define LEGACY_CODE_DIGITS 6   ///< GB/T 2260县级代码位数
+#define LEGACY_CODE_SCALE 1000000ULL ///< 6位代码补为12位时乘的基数（其后补6个0）
+#define CODE_BATCH_CHUNK 65536 ///< 批量代码查找每轮排序的条数（批内位置占排序键低16位）
+#define CODE_BATCH_MAX_VALUE (1ULL << 48) ///< 可放入排序键的代码值上限
+#define SCRATCH_ARENA_SIZE (8u << 20) ///< 每线程查询临时区大小（按需映射，实际只占用用到的页）
+#define PLAN_POSTING_COST 2    ///< 查询计划中倒排候选相对顺序扫描每行的代价（随机访问）
+#define ASYNC_READ_DEPTH 8     ///< 异步读取同时在途的请求数
+#define ASYNC_CHUNK_SIZE (1u << 20) ///< 异步读取单块大小
+#define QUERY_MAX_RESULTS 100  ///< 服务接口单次名称查询最多返回的结果数
+#define IPC_MAGIC 0x41444950u  ///< 共享内存IPC段标识
+#define IPC_MAX_CHANNELS 8     ///< IPC通道数（每个客户端独占一个）
+#define IPC_RING_SIZE 64       ///< 每个环的槽位数
+#define IPC_ARG_MAX 112        ///< 请求参数最大字节数
+#define IPC_RESPONSE_MAX 4080  ///< 响应数据最大字节数
+#define IPC_SPIN_LIMIT 2000    ///< futex模式下休眠前的自旋次数
+#define IPC_WAIT_TIMEOUT_MS 100 ///< futex单次等待上限，便于检查退出信号
+#define NET_REQUEST_HEADER 12  ///< 请求帧头：长度4 + 编号4 + 操作1 + 标志1 + 条数上限2
+#define NET_RESPONSE_HEADER 12 ///< 响应帧头：长度4 + 编号4 + 状态1 + 标志1 + 保留2
+#define NET_FLAG_TRUNCATED 0x01 ///< 响应标志：结果被截断
+#define NET_READ_BUFFER (64u << 10) ///< 每连接读缓冲区，也是单个请求帧上限
+#define NET_MAX_INFLIGHT 256   ///< 每连接在途请求上限，超出时暂停读取
+#define NET_POLL_INTERVAL_MS 200 ///< 监听循环检查退出信号的间隔
+#define NET_CHEAP_COST 1024    ///< 估算代价不超过该值的请求归为轻量类
+#define NET_HEAVY_BACKLOG (4L * MAX_REGIONS) ///< 重量类排队总代价上限，超出即拒绝
+#define NET_CONN_HEAVY_LIMIT 4 ///< 每连接在途重量类请求上限
+#define PAR_GRAIN 4096         ///< 子树节点数不超过该值时不再拆分，整段顺序处理
+#define PAR_DEQUE_SIZE 1024    ///< 每个工作线程的任务队列容量（满时就地执行）
+#define PAR_MAX_WORKERS 64     ///< 并行调度器最多工作线程数
+#define RESP_MAX_ARGS 8        ///< RESP命令最多参数个数
+#define RESP_FLUSH_BYTES (256u << 10) ///< RESP应答缓冲超过该值时先写出
 /** @} */
 
 /**
@@ -39,6 +165,226 @@ const char* LEVEL_NAMES[] = {
     "村级(5)"
 };
 
+/**
+ * @brief 内存区页类型
+ */
+enum ArenaPageMode {
+    ARENA_PAGES_NORMAL,   ///< 普通页
+    ARENA_PAGES_THP,      ///< 已建议内核使用透明大页（madvise）
+    ARENA_PAGES_HUGETLB,  ///< 显式大页（MAP_HUGETLB）
+    ARENA_PAGES_HEAP      ///< 不支持mmap的平台，使用堆内存
+};
+
+/**
+ * @brief 连续内存区
+ * @details 一次性映射、顺序分配、整体释放；足够大时优先使用大页，
+ *          降低遍历大量节点时的TLB缺失
+ */
+struct Arena {
+    const char* label;   ///< 名称（用于启动报告）
+    char* base;          ///< 起始地址
+    size_t size;         ///< 映射大小
+    size_t used;         ///< 已分配字节数
+    size_t guard;        ///< 末尾保护页字节数
+    int page_mode;       ///< 页类型（ArenaPageMode）
+};
+
+static struct Arena g_node_arena = { .label = "节点区" };     ///< 树节点（含名称等字段）
+static struct Arena g_child_arena = { .label = "子节点区" };  ///< 子节点指针数组
+static struct Arena g_index_arena = { .label = "索引区" };    ///< DFS序节点表与代码列
+static THREAD_LOCAL struct Arena t_scratch = { .label = "临时区" }; ///< 每线程查询临时区，按请求重置
+
+/**
+ * @brief 服务接口查询类型
+ */
+enum QueryOp {
+    QUERY_OP_CODE = 1,      ///< 按代码查询
+    QUERY_OP_NAME = 2,      ///< 按名称模糊查询
+    QUERY_OP_CHILDREN = 3,  ///< 列出直接下级 "代码[,偏移[,code|name]]"
+    QUERY_OP_SUBTREE = 4,   ///< 导出整棵子树（DFS序）
+    QUERY_OP_STATS = 5,     ///< 子树统计（各级数量、平均房价）
+    QUERY_OP_QL = 6,        ///< 查询语句（见compileQuery）
+    QUERY_OP_LOCATE = 7,    ///< 坐标反查 "纬度,经度"（需加载边界文件）
+    QUERY_OP_NEAREST = 8,   ///< 最近区划 "纬度,经度,级别[,所属代码]"（需加载质心文件）
+    QUERY_OP_NEIGHBORS = 9, ///< 相邻区划 "代码[,跳数[,仅同上级]]"（需加载邻接文件）
+    QUERY_OP_SIBLINGS = 10, ///< 列出同级（同一上级的全部下级，含自身）"代码[,偏移[,code|name]]"
+    QUERY_OP_ANCESTORS = 11, ///< 列出各级上级，自上而下
+    QUERY_OP_SAMPLE = 12,   ///< 分层抽样 "所属代码,级别,分组级别,每层条数[,按类型[,种子]]"
+    QUERY_OP_CONVERT = 13   ///< 6位与12位代码互换 "代码[,代码...]"
+};
+
+/**
+ * @brief 服务接口查询状态
+ */
+enum QueryStatus {
+    QUERY_STATUS_OK = 0,         ///< 成功
+    QUERY_STATUS_NOT_FOUND = 1,  ///< 无结果
+    QUERY_STATUS_INVALID = 2,    ///< 请求无效
+    QUERY_STATUS_OVERLOADED = 3  ///< 服务过载，请求被拒绝（可稍后重试）
+};
+
+/**
+ * @brief 查询调度类别，按执行前估算的代价划分
+ */
+enum QueryClass {
+    QUERY_CLASS_CHEAP,   ///< 代码查询、小范围下级列表
+    QUERY_CLASS_HEAVY,   ///< 名称全表扫描、大子树导出
+    QUERY_CLASS_COUNT
+};
+
+/**
+ * @brief 网络服务协议
+ */
+enum NetProtocol {
+    NET_PROTO_BINARY,  ///< 二进制帧，工作线程池执行，响应可乱序
+    NET_PROTO_RESP     ///< Redis协议（RESP），按连接顺序执行和应答
+};
+
+/**
+ * @brief 查询结果输出缓冲区
+ * @details 每个结果一行：代码\t名称\t级别\t层级路径；定长缓冲区写满时截断到完整行
+ */
+struct QueryOutput {
+    char* data;        ///< 输出内容（以'\0'结尾）
+    size_t length;     ///< 已写字节数
+    size_t capacity;   ///< 缓冲区容量
+    int growable;      ///< 是否允许realloc扩容
+    int truncated;     ///< 是否因空间不足截断
+};
+
+/**
+ * @brief IPC等待方式
+ */
+enum IpcWaitMode {
+    IPC_WAIT_FUTEX,  ///< 自旋后在futex上休眠
+    IPC_WAIT_POLL    ///< 持续忙等，延迟最低但独占CPU
+};
+
+#ifdef __linux__
+/**
+ * @brief IPC请求槽
+ */
+struct IpcRequest {
+    uint64_t id;              ///< 请求号，原样带回
+    uint32_t op;              ///< QueryOp
+    uint32_t limit;           ///< 名称查询最多返回条数
+    char arg[IPC_ARG_MAX];    ///< 代码或名称
+};
+
+/**
+ * @brief IPC响应槽
+ */
+struct IpcResponse {
+    uint64_t id;                   ///< 对应的请求号
+    int32_t status;                ///< QueryStatus
+    uint32_t length;               ///< data有效字节数
+    char data[IPC_RESPONSE_MAX];   ///< 每个结果一行：代码\t名称\t级别\t层级路径
+};
+
+/**
+ * @brief IPC通道：一对单生产者/单消费者无锁环
+ * @details 客户端写请求环、读响应环，服务端相反；双方写入的下标分处不同缓存行
+ */
+struct IpcChannel {
+    uint32_t owner __attribute__((aligned(64)));     ///< 持有通道的客户端进程号，0为空闲
+    uint32_t client_waiting;                          ///< 客户端是否在futex上休眠
+    uint32_t req_tail;                                ///< 请求环写入位置（客户端）
+    uint32_t resp_head;                               ///< 响应环读取位置（客户端）
+    uint32_t req_head __attribute__((aligned(64)));  ///< 请求环读取位置（服务端）
+    uint32_t resp_tail;                               ///< 响应环写入位置（服务端）
+    uint32_t resp_seq;                                ///< 响应序号，客户端在其上等待
+    struct IpcRequest requests[IPC_RING_SIZE] __attribute__((aligned(64)));
+    struct IpcResponse responses[IPC_RING_SIZE];
+};
+
+/**
+ * @brief IPC共享内存段
+ */
+struct IpcSegment {
+    uint32_t magic;                                   ///< IPC_MAGIC，服务端初始化完成后写入
+    uint32_t server_pid;                              ///< 服务端进程号
+    uint32_t wait_mode;                               ///< 服务端等待方式
+    uint32_t doorbell __attribute__((aligned(64)));  ///< 请求序号，服务端在其上等待
+    uint32_t server_waiting;                          ///< 服务端是否在futex上休眠
+    struct IpcChannel channels[IPC_MAX_CHANNELS];
+};
+#endif
+
+/**
+ * @brief 异步读取方式
+ */
+enum AsyncMode {
+    ASYNC_MODE_PREAD,  ///< 内核预读 + 同步pread（io_uring不可用时）
+    ASYNC_MODE_URING   ///< io_uring
+};
+
+/**
+ * @brief 异步读取缓冲区状态
+ */
+enum AsyncBufferState {
+    ASYNC_BUFFER_IDLE,     ///< 无待读数据
+    ASYNC_BUFFER_PENDING,  ///< 读取在途
+    ASYNC_BUFFER_READY     ///< 数据可用
+};
+
+/**
+ * @brief 异步读取缓冲区（对应文件中的一块）
+ */
+struct AsyncBuffer {
+    char* data;          ///< 缓冲区
+    uint64_t offset;     ///< 文件偏移
+    size_t wanted;       ///< 应读字节数
+    size_t length;       ///< 已读字节数
+    int state;           ///< AsyncBufferState
+    int via_uring;       ///< 是否经io_uring提交
+};
+
+#ifdef __linux__
+/**
+ * @brief io_uring环（直接使用系统调用，不依赖liburing）
+ */
+struct AsyncUring {
+    int fd;                       ///< io_uring文件描述符
+    int ready;                    ///< 是否已建立
+    unsigned inflight;            ///< 在途请求数
+    void* sq_ptr;                 ///< 提交环映射
+    size_t sq_len;
+    void* cq_ptr;                 ///< 完成环映射（与提交环共用时为NULL）
+    size_t cq_len;
+    struct io_uring_sqe* sqes;    ///< 提交项数组
+    size_t sqes_len;
+    unsigned* sq_tail;
+    unsigned sq_mask;
+    unsigned* sq_array;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned cq_mask;
+    struct io_uring_cqe* cqes;    ///< 完成项数组
+};
+#endif
+
+/**
+ * @brief 顺序异步文件读取器
+ * @details 文件按ASYNC_CHUNK_SIZE分块，ASYNC_READ_DEPTH个缓冲区轮转，
+ *          消费者处理当前块时其余块的读取仍在进行
+ */
+struct AsyncReader {
+#ifdef _WIN32
+    FILE* file;
+#else
+    int fd;
+#endif
+    uint64_t file_size;     ///< 文件大小
+    uint64_t next_offset;   ///< 下一次提交的文件偏移
+    int mode;               ///< AsyncMode
+    int current;            ///< 当前交给消费者的缓冲区
+    int failed;             ///< 是否发生读取错误
+    struct AsyncBuffer buffers[ASYNC_READ_DEPTH];
+#ifdef __linux__
+    struct AsyncUring ring;
+#endif
+};
+
 /**
  * @brief 行政区划实体结构
  * @details 含基本信息及扩展数据字段
@@ -63,384 +409,9397 @@ struct TreeNode {
     struct TreeNode* parent;         ///< 父节点指针
     int child_count;                 ///< 当前子节点数量
     int child_capacity;              ///< 子节点数组容量
+    int dfs_index;                   ///< 深度优先序号（由buildRegionIndex设置）
+    int subtree_end;                 ///< 子树在DFS序中的结束位置（不含）
 };
 
-// === 函数声明部分 ===
+/**
+ * @brief 区划代码方案：各级位数与根代码
+ * @details 代码的解析、压缩、上级推导与校验都经由当前方案；
+ *          内置方案（cn12、cn6）的函数按常量位数展开，其他方案按位数表逐级计算
+ */
+struct CodeScheme {
+    char name[24];                              ///< 方案名称
+    int level_count;                            ///< 级数（不含虚拟根节点）
+    int digits[CODE_SCHEME_MAX_LEVELS];         ///< 各级位数
+    int total_digits;                           ///< 代码总位数
+    char root_code[MAX_CODE_LENGTH];            ///< 虚拟根节点代码
+    uint64_t units[CODE_SCHEME_MAX_LEVELS];     ///< 取模基数：代码对units[l]取模即第l+1级及以下各位
+    int (*parse)(const char* code, uint64_t* value);     ///< 解析为整数，位数或字符不符返回-1
+    int (*level)(uint64_t value);                        ///< 由代码推出级别，虚拟根节点为0
+    int (*parent)(uint64_t value, uint64_t* parent);     ///< 推出上级代码，虚拟根节点返回-1
+};
 
-// 树节点操作函数
-struct TreeNode* createNode(struct Region data);
-void addChild(struct TreeNode* parent, struct TreeNode* child);
-static int compareCodeToNode(const void* a, const void* b);
-struct TreeNode* buildTree(struct Region regions[], int size);
-void freeTree(struct TreeNode* root);
+/**
+ * @brief 区划代码列（分块增量 + 位压缩）
+ * @details 代码按DFS序（与代码序一致）存储为整数，每CODE_BLOCK_SIZE个一块：
+ * - 块内存储相邻代码的增量，按块内最大位宽紧凑打包
+ * - 打包采用4路交错布局，解码时可用SIMD一次处理4个增量
+ * - 各块首代码与数据偏移构成跳跃指针，按代码或序号随机访问只需解码一块
+ */
+struct CodeColumn {
+    int count;                 ///< 代码总数
+    int block_count;           ///< 块数
+    uint64_t* block_base;      ///< 各块首代码（跳跃指针）
+    uint32_t* block_offset;    ///< 各块数据在packed中的起始字偏移
+    uint8_t* block_bits;       ///< 各块增量位宽，CODE_BLOCK_RAW表示原始存储
+    uint32_t* packed;          ///< 压缩数据区
+    size_t packed_words;       ///< 压缩数据区字数
+};
 
-// 数据查询函数
-struct TreeNode* findNodeByCode(struct TreeNode* root, const char* code);
-void findByNameRecursive(struct TreeNode* root, const char* name, int* found);
-void findByCode(struct TreeNode* node, const char* code);
-void findByName(struct TreeNode* root, const char* name);
+/**
+ * @brief 代码最小完美哈希（PTHash式）
+ * @details 生成索引文件时离线构建：键先散列到桶，每桶搜索一个16位引导值，
+ *          使桶内各键落到中间表[0, m)的不同位置；落在[n, m)的位置再经
+ *          重映射表回填到[0, n)的空位。查询固定一次探测，无分支
+ */
+struct CodeMph {
+    uint64_t seed;          ///< 散列种子
+    uint32_t key_count;     ///< 键数n
+    uint32_t bucket_count;  ///< 桶数
+    uint64_t table_size;    ///< 中间表大小m（m > n）
+    uint16_t* pilots;       ///< 各桶引导值
+    uint32_t* remap;        ///< [n, m)位置的重映射表，下标0为占位
+    uint32_t* slots;        ///< 槽位到DFS序号
+};
 
-// 数据验证函数
-static int validateCode(const char* code);
-static int validateName(const char* name);
+/**
+ * @brief 区划索引
+ * @details 树构建完成后按DFS序编号，节点的子树对应连续区间
+ *          [dfs_index, subtree_end)，代码查询经代码列定位到序号
+ */
+struct RegionIndex {
+    struct TreeNode* root;        ///< 建立索引的根节点
+    struct TreeNode** dfs_nodes;  ///< 按DFS序排列的节点指针
+    int count;                    ///< 节点总数（含虚拟根节点）
+    struct CodeColumn codes;      ///< 压缩代码列
+    struct CodeMph mph;           ///< 代码完美哈希（仅从索引文件加载时可用）
+};
 
-// 数据显示函数
-static void displayNodeInfo(struct TreeNode* node, int show_separator);
+static struct RegionIndex g_index;  ///< 全局区划索引
 
-// 数据加载函数
-int loadRegionsFromCSV(struct Region regions[], const char* filename);
+/**
+ * @brief 预构建索引文件头
+ * @details 文件内只含偏移不含指针，可直接嵌入可执行文件或从磁盘读入；
+ *          各段按64字节对齐，节点记录按DFS序排列
+ */
+struct IndexBlobHeader {
+    char magic[8];                 ///< INDEX_BLOB_MAGIC
+    uint32_t byte_order;           ///< INDEX_BLOB_BYTE_ORDER
+    uint32_t node_count;           ///< 节点数（含虚拟根节点）
+    uint32_t block_count;          ///< 代码列块数
+    uint32_t extra_count;          ///< 扩展数据条数
+    uint64_t packed_words;         ///< 代码列压缩数据字数
+    uint64_t records_offset;       ///< 节点记录段
+    uint64_t extras_offset;        ///< 扩展数据段
+    uint64_t block_base_offset;    ///< 代码列块首代码段
+    uint64_t block_offset_offset;  ///< 代码列块偏移段
+    uint64_t block_bits_offset;    ///< 代码列块位宽段
+    uint64_t packed_offset;        ///< 代码列压缩数据段
+    uint64_t strings_offset;       ///< 字符串池
+    uint64_t strings_size;         ///< 字符串池字节数
+    uint64_t mph_seed;             ///< 完美哈希种子
+    uint64_t mph_table_size;       ///< 完美哈希中间表大小
+    uint32_t mph_bucket_count;     ///< 完美哈希桶数
+    uint32_t code_levels;          ///< 代码方案级数
+    uint8_t code_digits[8];        ///< 代码方案各级位数（自上而下，其余为0）
+    uint64_t mph_pilots_offset;    ///< 完美哈希引导值段
+    uint64_t mph_remap_offset;     ///< 完美哈希重映射段
+    uint64_t mph_slots_offset;     ///< 完美哈希槽位段
+    uint64_t total_size;           ///< 文件总字节数
+};
 
-// 用户界面函数
-static int getInput(char* buffer, int max_len, const char* prompt);
-int showMainMenu(struct TreeNode* root);
+/**
+ * @brief 索引文件中的节点记录
+ * @details 子节点由子树区间推出：首个子节点为i+1，下一个为前一子节点的subtree_end
+ */
+struct IndexBlobRecord {
+    uint32_t subtree_end;  ///< 子树结束位置（不含）
+    uint32_t name_offset;  ///< 名称在字符串池中的偏移
+    uint32_t extra;        ///< 扩展数据序号，UINT32_MAX表示无
+    uint16_t type;         ///< 区划类型
+    uint8_t level;         ///< 行政级别
+    uint8_t reserved;
+};
 
-// === 函数实现部分 ===
+/**
+ * @brief 索引文件中的扩展数据
+ */
+struct IndexBlobExtra {
+    double avg_house_price;      ///< 平均房价
+    uint32_t employment_offset;  ///< 就业率在字符串池中的偏移，UINT32_MAX表示无
+    uint32_t reserved;
+};
 
-// 1. 树节点操作函数组
-struct TreeNode* createNode(struct Region data) {
-    struct TreeNode* node = (struct TreeNode*)malloc(sizeof(struct TreeNode));
-    if (node == NULL) {
-        perror("内存分配失败");
-        return NULL;
-    }
-    node->data = data;
-    node->child_capacity = 10;
-    node->children = (struct TreeNode**)malloc(node->child_capacity * sizeof(struct TreeNode*));
-    if (node->children == NULL) {
-        perror("内存分配失败");
-        free(node);
-        return NULL;
-    }
-    node->child_count = 0;
-    node->parent = NULL;  // 初始父节点指针为NULL
-    return node;
-}
+#ifdef EMBED_INDEX
+#ifndef EMBED_INDEX_FILE
+#define EMBED_INDEX_FILE "area_data.idx"  ///< 编译时嵌入的索引文件
+#endif
+/**
+ * @brief 编译时嵌入的预构建索引（需先用 --build-index 生成，仅支持ELF目标）
+ */
+__asm__(
+    ".section .rodata\n"
+    ".balign 64\n"
+    "embedded_index_start:\n"
+    ".incbin \"" EMBED_INDEX_FILE "\"\n"
+    "embedded_index_end:\n"
+    ".previous\n"
+);
+extern const unsigned char embedded_index_start[] __asm__("embedded_index_start");
+extern const unsigned char embedded_index_end[] __asm__("embedded_index_end");
+#endif
 
-void addChild(struct TreeNode* parent, struct TreeNode* child) {
-    if (parent->child_count >= parent->child_capacity) {
-        parent->child_capacity *= 2;
-        parent->children = (struct TreeNode**)realloc(parent->children, 
-            parent->child_capacity * sizeof(struct TreeNode*));
-        if (parent->children == NULL) {
-            perror("内存重新分配失败");
-            exit(1);
-        }
-    }
-    parent->children[parent->child_count++] = child;
-    child->parent = parent;  // 设置子节点的父节点指针
-}
+/**
+ * @brief 倒排表：键 → 按DFS序排列的节点序号
+ * @details 键到编号用开放寻址哈希，各键的倒排链连续存放（offsets为前缀和）
+ */
+struct PostingSlot {
+    uint64_t key;          ///< 键，0表示空槽
+    uint32_t id;           ///< 键编号
+};
 
-static int compareCodeToNode(const void* a, const void* b) {
-    const struct {
-        char code[MAX_CODE_LENGTH];
-        struct TreeNode* node;
-    } *nodeA = a, *nodeB = b;
-    
-    return strcmp(nodeA->code, nodeB->code);
-}
+struct PostingTable {
+    struct PostingSlot* slots; ///< 哈希槽（键与编号同槽存放，查找只访问一次缓存行）
+    uint32_t mask;         ///< 槽数减一
+    uint32_t key_count;    ///< 不同键数
+    uint32_t* offsets;     ///< 各键倒排链起始位置（key_count+1项）
+    int* postings;         ///< 全部倒排链（DFS序号）
+    size_t posting_count;  ///< 倒排项总数
+};
 
-struct TreeNode* buildTree(struct Region regions[], int size) {
-    // 为所有节点分配内存
-    struct TreeNode** nodes = (struct TreeNode**)malloc(size * sizeof(struct TreeNode*));
-    if (nodes == NULL) {
-        perror("内存分配失败");
-        return NULL;
-    }
+/**
+ * @brief 名称与级别索引
+ * @details 倒排项是DFS序号而非节点指针，各NUMA副本共用同一份
+ */
+struct NameIndex {
+    struct PostingTable grams;   ///< 名称中的单字与相邻两字 → 节点
+    struct PostingTable exact;   ///< 完整名称哈希 → 节点（需再比较名称）
+    struct PostingTable levels;  ///< 级别+1 → 节点
+    struct PostingTable address; ///< 完整名称与去掉通名后缀的专名哈希 → 节点（地址解析用）
+    struct PostingTable strata;  ///< (级别+1)<<32|类型 → 节点（分层抽样用）
+    uint64_t* prefixes;          ///< 名称前缀（不少于两个汉字）哈希位图，地址解析据此提前结束查找
+    uint64_t prefix_mask;        ///< 位图位数-1
+    size_t longest_name;         ///< 最长名称的字节数，限定地址解析的查找长度
+    int ready;                   ///< 构建完成后置位，此前查询计划只用顺序扫描
+#ifndef _WIN32
+    pthread_t builder;           ///< 后台构建线程
+    int building;                ///< 后台构建线程尚未回收
+#endif
+};
 
-    // 创建用于快速查找的临时映射数组
-    struct {
-        char code[MAX_CODE_LENGTH];
-        struct TreeNode* node;
-    } *codeToNode = malloc(size * sizeof(*codeToNode));
-    
-    if (codeToNode == NULL) {
-        free(nodes);
-        perror("内存分配失败");
-        return NULL;
-    }
+static struct NameIndex g_name_index;  ///< 名称索引
 
-    printf("开始创建节点...");
-    // 创建所有节点并建立索引
-    for (int i = 0; i < size; i++) {
-        nodes[i] = createNode(regions[i]);
-        if (nodes[i] == NULL) {
-            printf("创建节点失败: %d\n", i);
-            for (int j = 0; j < i; j++) {
-                free(nodes[j]->children);
-                free(nodes[j]);
-            }
-            free(nodes);
-            free(codeToNode);
-            return NULL;
-        }
-        
-        // 保存代码到节点的映射
-        strncpy(codeToNode[i].code, regions[i].code, MAX_CODE_LENGTH - 1);
-        codeToNode[i].code[MAX_CODE_LENGTH - 1] = '\0';
-        codeToNode[i].node = nodes[i];
-        
-        if (i % 1000 == 0 || i == size - 1) {
-            printf("\r已创建 %d/%d 个节点... (%.1f%%)", i + 1, size, (float)(i + 1)/size*100);
-            fflush(stdout);
-        }
-    }
-    printf("\n节点创建完成\n");
+/**
+ * @brief 名称排序（拼音序），均以DFS序号表示，各NUMA副本通用
+ */
+struct Collation {
+    uint32_t* ranks;           ///< DFS序号 -> 名称位次，同名同位次
+    int* order;                ///< 全部节点按名称排序
+    int* levels;               ///< 各级节点按名称排序，第l级为levels[level_offsets[l], level_offsets[l+1])
+    int level_offsets[COLLATION_LEVELS + 1];
+    int* children;             ///< 各节点的下级按名称排序
+    int* child_offsets;        ///< DFS序号为d的节点的下级为children[child_offsets[d], child_offsets[d+1])
+    int count;
+    int ready;                 ///< 构建完成后置位，此前按名称排序的请求等待构建完成
+};
+
+static struct Collation g_collation;  ///< 名称排序
+#ifndef _WIN32
+static pthread_mutex_t g_collation_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_collation_built = PTHREAD_COND_INITIALIZER;  ///< 后台构建结束（成功或失败）
+static int g_collation_building;                                     ///< 后台构建进行中
+#endif
+
+/**
+ * @brief 分层抽样参数：在所属区划内，按分组级别的上级（和类型）分层，每层抽取若干个指定级别的区划
+ */
+struct SampleSpec {
+    char within[MAX_CODE_LENGTH];  ///< 所属区划
+    int level;                     ///< 抽取的级别
+    int group_level;               ///< 按该级上级分组（如1为每省一组），不深于所属区划时不分组
+    int by_type;                   ///< 组内再按类型分层
+    int per_stratum;               ///< 每层抽取条数，层内不足时全取
+    uint64_t seed;                 ///< 随机种子，相同参数与种子得到相同样本
+};
+
+/**
+ * @brief 抽样中的一层
+ */
+struct SampleStratum {
+    const int* candidates;     ///< 层内全部节点（有序DFS序号，指向倒排链；扫描得到时返回后为NULL）
+    int population;            ///< 层内节点数
+    int group;                 ///< 分组节点的DFS序号
+    int type;                  ///< 类型，不按类型分层时为-1
+    int offset;                ///< 本层样本在SampleResult.nodes中的起始位置
+    int count;                 ///< 本层样本数
+};
+
+struct SampleResult {
+    struct SampleStratum* strata;  ///< 按分组（DFS序）、类型（升序）排列
+    int stratum_count;
+    int* nodes;                    ///< 各层样本的DFS序号，层内按DFS序
+    int node_count;
+};
+
+/**
+ * @brief 下级、同级列表的排列顺序
+ */
+enum NavOrder {
+    NAV_ORDER_CODE,            ///< 代码序
+    NAV_ORDER_NAME             ///< 名称拼音序
+};
+
+/**
+ * @brief 节点序列的一页（只读视图，不复制）
+ * @details 代码序时指向子节点区中的指针数组，名称序时指向名称排序中的DFS序号段，用sliceNode取节点
+ */
+struct NodeSlice {
+    struct TreeNode* const* nodes; ///< 代码序时有效
+    const int* dfs;                ///< 名称序时有效
+    int count;                     ///< 本页条数
+    int total;                     ///< 分页前的总条数
+};
+
+/**
+ * @brief 下级、同级查询参数
+ */
+struct NavigationQuery {
+    char code[MAX_CODE_LENGTH];
+    int offset;                ///< 从第几条开始（0起）
+    int order;                 ///< NavOrder
+};
+
+/**
+ * @brief 区划边界中的一个多边形（MultiPolygon的每一块各为一个）
+ */
+struct BoundaryPolygon {
+    int node;                  ///< 区划的DFS序号（各NUMA副本通用）
+    int level;                 ///< 区划级别，多个多边形包含同一点时取最深的
+    uint32_t ring_begin;       ///< 第一个环（外环）在rings中的下标，其后为洞
+    uint32_t ring_count;       ///< 环数
+    double min_x, min_y;       ///< 外包框（经度、纬度）
+    double max_x, max_y;
+};
+
+/**
+ * @brief 区划边界与均匀网格索引
+ */
+struct Boundaries {
+    struct BoundaryPolygon* polygons;
+    size_t polygon_count, polygon_capacity;
+    uint32_t* rings;           ///< 各环第一个点在points中的下标，末尾多一个哨兵
+    size_t ring_count, ring_capacity;
+    double* points;            ///< 经度、纬度交替存放
+    size_t point_count, point_capacity;
+    double min_x, min_y;       ///< 网格覆盖范围
+    double max_x, max_y;
+    double cell_size;          ///< 格边长（度）
+    int columns, rows;
+    uint32_t* cell_offsets;    ///< 每格多边形列表在cell_items中的起点（CSR）
+    uint32_t* cell_items;      ///< 多边形下标
+};
+
+static struct Boundaries g_boundaries;  ///< 区划边界（加载后只读）
+
+/**
+ * @brief 区划质心（单位球面三维坐标）
+ */
+struct CentroidPoint {
+    double v[3];
+    int node;                  ///< 区划的DFS序号
+};
+
+/**
+ * @brief 某一级区划质心的隐式k-d树：区间[lo, hi)的中点为节点，左右半区间为子树
+ */
+struct CentroidTree {
+    struct CentroidPoint* points;
+    uint8_t* axes;             ///< 各节点的切分轴
+    int* dfs_min;              ///< 各节点子树内最小的DFS序号
+    int* dfs_max;              ///< 各节点子树内最大的DFS序号
+    int count;
+};
+
+struct CentroidIndex {
+    struct CentroidTree levels[CENTROID_LEVELS];  ///< 按级别分别建树
+};
+
+static struct CentroidIndex g_centroids;  ///< 区划质心（加载后只读）
+
+/**
+ * @brief 最近区划查询参数
+ */
+struct NearestQuery {
+    double lat, lon;
+    int level;                       ///< 要找的区划级别
+    char within[MAX_CODE_LENGTH];    ///< 限定在该区划内，空串为不限
+};
+
+/**
+ * @brief 区划邻接图（CSR）：顶点为出现在邻接文件中的区划，按DFS序编号
+ */
+struct AdjacencyGraph {
+    int* vertex_nodes;         ///< 顶点号 -> DFS序号（递增）
+    int* offsets;              ///< 顶点v的邻居为targets[offsets[v], offsets[v+1])
+    int* targets;              ///< 邻居顶点号，每段内递增
+    int vertex_count;
+    int edge_count;            ///< 有向边数（每对相邻区划计两条）
+};
+
+static struct AdjacencyGraph g_adjacency;  ///< 区划邻接图（加载后只读）
+
+/**
+ * @brief 相邻区划查询参数
+ */
+struct NeighborQuery {
+    char code[MAX_CODE_LENGTH];
+    int hops;                  ///< 最多几跳，默认1
+    int same_parent;           ///< 只返回与起点同一上级的区划
+};
+
+/**
+ * @brief 批量解析的输入类型
+ */
+enum ResolveInput {
+    RESOLVE_INPUT_ADDRESS,     ///< 每行一个地址
+    RESOLVE_INPUT_POINT,       ///< 每行 "纬度,经度"
+    RESOLVE_INPUT_NEAREST,     ///< 每行 "纬度,经度,级别[,所属代码]"，取最近的一个
+    RESOLVE_INPUT_NEIGHBORS,   ///< 每行 "代码[,跳数[,仅同上级]]"，列出全部相邻区划
+    RESOLVE_INPUT_CODES        ///< 每行一个6位或12位代码，互相转换
+};
+
+/**
+ * @brief 查询条件（各条件同时满足）
+ */
+struct RegionFilter {
+    const char* name_contains;  ///< 名称包含，NULL表示不限
+    const char* name_equals;    ///< 名称等于，NULL表示不限
+    uint32_t level_mask;        ///< 允许的级别（第n位对应级别n），0表示不限
+    int types[FILTER_MAX_TYPES]; ///< 允许的区划类型
+    int type_count;             ///< 类型个数，0表示不限
+    int begin;                  ///< DFS区间起点（所属子树）
+    int end;                    ///< DFS区间终点（不含）
+};
+
+/**
+ * @brief 查询访问路径
+ */
+enum AccessPath {
+    ACCESS_SCAN,        ///< 顺序扫描子树区间
+    ACCESS_EXACT_NAME,  ///< 精确名称索引
+    ACCESS_NAME_GRAM,   ///< 名称片段（n-gram）索引
+    ACCESS_LEVEL        ///< 按级别的节点数组
+};
+
+/**
+ * @brief 查询计划：选定的访问路径及其候选节点
+ */
+struct QueryPlan {
+    int path;               ///< 访问路径（AccessPath）
+    const int* candidates;  ///< 候选DFS序号（已截取到子树区间），顺序扫描时为NULL
+    int candidate_count;    ///< 候选数
+    long cost;              ///< 估算代价
+};
+
+/**
+ * @brief 节点位图容器类型
+ */
+enum BitmapContainerKind {
+    BITMAP_CONTAINER_ARRAY,  ///< 有序uint16数组（稀疏）
+    BITMAP_CONTAINER_BITS    ///< 65536位位图（稠密）
+};
+
+/**
+ * @brief 位图集合运算
+ */
+enum BitmapOp {
+    BITMAP_AND,     ///< 交集
+    BITMAP_OR,      ///< 并集
+    BITMAP_ANDNOT   ///< 差集
+};
+
+/**
+ * @brief 位图容器：存放高16位相同的一组DFS序号的低16位
+ */
+struct BitmapContainer {
+    uint32_t key;          ///< 高16位
+    int kind;              ///< 容器类型（BitmapContainerKind）
+    int cardinality;       ///< 元素数
+    int capacity;          ///< 数组容器容量
+    uint16_t* values;      ///< 数组容器数据
+    uint64_t* words;       ///< 位图容器数据（BITMAP_WORDS个字）
+};
+
+/**
+ * @brief 压缩节点位图（roaring式），按容器键升序
+ * @details 元素为DFS序号，集合运算逐容器进行，无需展开为节点列表
+ */
+struct NodeBitmap {
+    struct BitmapContainer* containers;  ///< 容器数组
+    int count;                           ///< 容器数
+    int capacity;                        ///< 容器数组容量
+};
+
+/**
+ * @brief 查询语句RETURN可选字段
+ */
+enum QueryField {
+    QUERY_FIELD_CODE,        ///< 区划代码
+    QUERY_FIELD_NAME,        ///< 名称
+    QUERY_FIELD_LEVEL,       ///< 级别
+    QUERY_FIELD_TYPE,        ///< 类型
+    QUERY_FIELD_PATH,        ///< 层级路径
+    QUERY_FIELD_PARENT,      ///< 上级代码
+    QUERY_FIELD_PRICE,       ///< 平均房价
+    QUERY_FIELD_EMPLOYMENT,  ///< 就业率
+    QUERY_FIELD_COUNT
+};
+
+const char* QUERY_FIELD_NAMES[] = { "code", "name", "level", "type", "path", "parent", "price", "employment" };
+const char* ACCESS_PATH_NAMES[] = { "顺序扫描", "精确名称索引", "名称片段索引", "级别数组" };
+
+/**
+ * @brief 查询语句中的一个子查询
+ */
+struct QueryTerm {
+    struct RegionFilter filter;         ///< 条件（名称指针指向下面的缓冲区）
+    char contains[MAX_NAME_LENGTH];     ///< name CONTAINS 的值
+    char equals[MAX_NAME_LENGTH];       ///< name = 的值
+    int set_op;                         ///< 与前面结果的运算（BitmapOp），首项不用
+    struct QueryPlan plan;              ///< 编译期选定的访问路径
+};
+
+/**
+ * @brief 编译后的查询语句：子查询、投影与查询计划，编译一次可重复执行
+ */
+struct CompiledQuery {
+    struct TreeNode* root;              ///< 查询所在的树
+    struct QueryTerm terms[QL_MAX_TERMS]; ///< 子查询，按顺序做集合运算
+    int term_count;                     ///< 子查询数
+    int limit;                          ///< 最多结果数
+    int fields[QL_MAX_FIELDS];          ///< RETURN字段（QueryField）
+    int field_count;                    ///< 字段数
+    int explain;                        ///< 仅输出查询计划
+    int count_only;                     ///< 仅输出结果数
+    int order_by_name;                  ///< 按名称（拼音序）输出，默认按DFS序
+};
+
+/**
+ * @brief 预编译的查询语句：估算代价时编译一次，执行时直接使用
+ */
+struct PreparedQuery {
+    int status;                  ///< 编译结果：0成功，否则为QUERY_STATUS_INVALID
+    char error[256];             ///< 编译失败时的错误信息
+    struct CompiledQuery query;  ///< 编译后的语句（名称条件指向自身缓冲区，不可按值复制）
+};
+
+/**
+ * @brief 单个NUMA节点上的只读索引副本
+ * @details 节点区、子节点区和索引区整体复制到绑定该节点的内存，
+ *          内部指针重定位到副本，DFS序号与主索引一致
+ */
+struct IndexReplica {
+    int numa_node;            ///< 所属NUMA节点
+    struct Arena nodes;       ///< 节点区副本
+    struct Arena children;    ///< 子节点区副本
+    struct Arena index;       ///< 索引区副本
+    struct RegionIndex view;  ///< 指向副本数据的索引
+};
+
+#ifndef _WIN32
+struct NetConnection;
+
+/**
+ * @brief 二进制协议的一个待执行请求
+ */
+struct NetJob {
+    struct NetConnection* conn;  ///< 所属连接
+    struct NetJob* next;         ///< 工作队列或空闲链表中的下一项
+    uint32_t id;                 ///< 客户端请求编号，原样带回响应
+    int op;                      ///< 操作（QueryOp）
+    int limit;                   ///< 结果条数上限，0表示默认
+    int query_class;             ///< 调度类别（QueryClass）
+    long cost;                   ///< 估算代价（预计访问节点数）
+    char arg[QUERY_ARG_MAX];     ///< 代码、名称或查询语句
+    struct PreparedQuery* prepared; ///< 查询语句的编译结果，槽位首次收到查询语句时分配，之后复用
+};
+
+/**
+ * @brief 二进制协议连接
+ * @details 读取线程解析流水线请求，工作线程完成后直接写回，响应顺序与请求无关
+ */
+struct NetConnection {
+    int fd;                          ///< 套接字
+    struct NetServer* server;        ///< 所属服务
+    pthread_t reader;                ///< 读取线程
+    pthread_mutex_t write_lock;      ///< 响应写锁，保证帧不交错
+    int broken;                      ///< 写失败后不再写回
+    pthread_mutex_t slot_lock;       ///< 保护请求槽位和在途计数
+    pthread_cond_t slot_freed;       ///< 请求槽位归还
+    struct NetJob* free_jobs;        ///< 空闲请求槽位
+    int inflight;                    ///< 在途请求数
+    int heavy_inflight;              ///< 在途重量类请求数（受服务锁保护）
+    int finished;                    ///< 读取线程已结束，可回收
+    struct NetConnection* next;      ///< 连接链表
+    struct NetJob jobs[NET_MAX_INFLIGHT]; ///< 请求槽位
+};
+
+/**
+ * @brief 二进制协议服务的工作队列
+ */
+struct NetServer {
+    int protocol;                ///< 连接使用的协议（NetProtocol）
+    struct TreeNode* root;       ///< 主索引根节点，工作线程各自换成本地副本
+    pthread_mutex_t lock;        ///< 保护队列和准入计数
+    pthread_cond_t ready;        ///< 队列非空或停止
+    struct NetJob* queue_head[QUERY_CLASS_COUNT]; ///< 各类别待执行请求
+    struct NetJob* queue_tail[QUERY_CLASS_COUNT];
+    long heavy_backlog;          ///< 排队中的重量类请求总代价
+    int heavy_running;           ///< 正在执行的重量类请求数
+    int heavy_limit;             ///< 重量类并发上限，其余线程留给轻量类
+    int stopping;                ///< 停止工作线程
+    unsigned long long served;   ///< 已处理请求数
+    unsigned long long shed;     ///< 因过载拒绝的请求数
+};
+#endif
+
+/**
+ * @brief 子树并行任务
+ * @details 调度器按下级拆分子树，每个工作线程对分到的DFS区间调用run，
+ *          run通过worker编号写入各自的局部结果，结束后由调用方合并
+ */
+struct ParallelJob {
+    void (*run)(struct ParallelJob* job, int worker, int begin, int end); ///< 顺序处理DFS区间[begin, end)
+    void* context;   ///< 调用方数据（通常为按工作线程划分的局部结果）
+    int pending;     ///< 已拆出但未完成的任务数
+};
+
+#ifndef _WIN32
+/**
+ * @brief 工作线程的任务队列：本线程从底部压入弹出，其他线程从顶部窃取
+ */
+struct ParallelDeque {
+    pthread_mutex_t lock;
+    int top;                      ///< 窃取位置
+    int bottom;                   ///< 压入/弹出位置
+    int tasks[PAR_DEQUE_SIZE];    ///< 子树根节点的DFS序号
+};
+
+/**
+ * @brief 工作窃取调度器（首次使用时启动，同一时刻执行一个任务）
+ */
+struct ParallelPool {
+    int workers;                  ///< 工作线程数（含调用线程）
+    pthread_t threads[PAR_MAX_WORKERS];
+    pthread_mutex_t busy;         ///< 调度器占用锁，占用时其他查询退回顺序执行
+    pthread_mutex_t lock;         ///< 保护以下字段
+    pthread_cond_t wake;          ///< 新任务或停止
+    pthread_cond_t done;          ///< 辅助线程全部退出当前任务
+    struct ParallelJob* job;      ///< 当前任务
+    unsigned generation;          ///< 任务代数
+    int active;                   ///< 正在参与当前任务的辅助线程数
+    int stopping;                 ///< 停止调度器
+    struct ParallelDeque deques[PAR_MAX_WORKERS];
+};
+
+static struct ParallelPool g_pool;
+#endif
+
+static struct IndexReplica* g_replicas[MAX_NUMA_NODES];  ///< 各NUMA节点的副本
+#ifdef __linux__
+static int g_replica_next = 0;                            ///< 下一个查询线程分到的副本序号
+#endif
+static THREAD_LOCAL const struct RegionIndex* t_local_index;  ///< 当前线程使用的本地副本
+static volatile sig_atomic_t g_stop_requested = 0;  ///< 服务模式收到SIGINT/SIGTERM后置位
+static FILE* g_result_output = NULL;  ///< 批量结果写到标准输出（"-"）时的原标准输出，此时提示信息改写到标准错误
+
+// === 函数声明部分 ===
+
+// 内存区函数
+int arenaInit(struct Arena* arena, size_t size);
+void* arenaAlloc(struct Arena* arena, size_t size, size_t align);
+int arenaOwns(const struct Arena* arena, const void* ptr);
+void arenaRelease(struct Arena* arena);
+void reportArenas(void);
+void* scratchAlloc(size_t size);
+size_t scratchMark(void);
+void scratchReset(size_t mark);
+void scratchRelease(void);
+
+// 代码方案函数
+int setCodeScheme(const char* spec);
+int codeLevel(const char* code);
+void formatSchemeCode(uint64_t value, char* out);
+int deriveParentCode(const char* code, char* parent);
+
+// 树节点操作函数
+struct TreeNode* createNode(struct Region data);
+void addChild(struct TreeNode* parent, struct TreeNode* child);
+static int compareCodeToNode(const void* a, const void* b);
+struct TreeNode* buildTree(struct Region regions[], int size);
+void freeTree(struct TreeNode* root);
+
+// 区划索引函数
+static int parseCode(const char* code, uint64_t* value);
+size_t codeColumnBytes(const uint64_t* codes, int count);
+static int buildCodeColumn(struct CodeColumn* col, const uint64_t* codes, int count, struct Arena* arena);
+static int decodeCodeBlock(const struct CodeColumn* col, int block, uint32_t* out);
+uint64_t codeColumnGet(const struct CodeColumn* col, int index);
+void decodeCodeValues(const struct CodeColumn* col, int block, uint64_t* out);
+int codeColumnFind(const struct CodeColumn* col, uint64_t code);
+int buildCodeMph(struct CodeMph* mph, const uint64_t* codes, int count);
+void freeCodeMph(struct CodeMph* mph);
+int codeMphLookup(const struct CodeMph* mph, uint64_t code);
+int buildRegionIndex(struct TreeNode* root);
+void freeRegionIndex(void);
+
+// 名称索引函数
+int buildNameIndex(void);
+int startNameIndexBuild(void);
+void freeNameIndex(void);
+const int* postingLookup(const struct PostingTable* table, uint64_t key, int* length);
+
+// 名称排序函数
+int buildCollation(void);
+int sortedChildren(const struct TreeNode* node, const int** children);
+int sortedLevel(int level, const int** nodes);
+int orderNodesByName(int* nodes, int count, int k);
+void freeCollation(void);
+
+// 区划导航函数
+struct TreeNode* sliceNode(const struct NodeSlice* slice, int i);
+int navigateChildren(const struct TreeNode* node, int order, int offset, int limit, struct NodeSlice* slice);
+int navigateSiblings(const struct TreeNode* node, int order, int offset, int limit, struct NodeSlice* slice);
+int navigateAncestors(const struct TreeNode* node, struct TreeNode** chain, int max_results);
+int parseNavigationQuery(const char* text, struct NavigationQuery* query);
+
+// NUMA副本函数
+int replicateIndexPerNode(void);
+void freeIndexReplicas(void);
+int bindLocalReplica(void);
+static const struct RegionIndex* currentIndex(void);
+struct TreeNode* localRoot(struct TreeNode* root);
+
+// 并行调度函数
+int parallelWorkerCount(void);
+int parallelForSubtree(struct ParallelJob* job, const struct TreeNode* node);
+void parallelShutdown(void);
+
+// 数据查询函数
+struct TreeNode* findNodeByCode(struct TreeNode* root, const char* code);
+void findByNameRecursive(struct TreeNode* root, const char* name, int* found);
+void findByCode(struct TreeNode* node, const char* code);
+void findByName(struct TreeNode* root, const char* name);
+int matchFilter(const struct TreeNode* node, const struct RegionFilter* filter);
+void planQuery(const struct RegionFilter* filter, struct QueryPlan* plan);
+int runQueryPlan(const struct RegionFilter* filter, const struct QueryPlan* plan,
+                 struct TreeNode** results, int max_results);
+int collectByName(struct TreeNode* root, const char* name, struct TreeNode** results, int max_results);
+int formatNodePath(const struct TreeNode* node, char* out, size_t cap);
+int formatNodeLine(const struct TreeNode* node, char* out, size_t cap);
+void queryOutputReset(struct QueryOutput* out);
+int executeQuery(struct TreeNode* root, int op, const char* arg, int limit, struct PreparedQuery* prepared,
+                 struct QueryOutput* out);
+long estimateQueryCost(struct TreeNode* root, int op, const char* arg, int limit, struct PreparedQuery* prepared);
+
+// 代码转换函数
+int findCodeValues(const uint64_t* values, int count, int* nodes);
+int parseConvertCode(const char* text, uint64_t* value);
+void formatLegacyCode(uint64_t value, char* out);
+int appendConvertedCodes(const char* const* codes, int count, struct QueryOutput* out);
+
+// 区划抽样函数
+int sampleRegions(struct TreeNode* root, const struct SampleSpec* spec, struct SampleResult* result);
+int parseSampleSpec(const char* text, struct SampleSpec* spec);
+int appendSampleLines(const struct SampleResult* result, struct QueryOutput* out, int limit);
+void freeSampleResult(struct SampleResult* result);
+int runSampleCommand(struct TreeNode* root, const char* spec_text, const char* output);
+
+// 位图函数
+int bitmapAdd(struct NodeBitmap* bitmap, uint32_t value);
+int bitmapAddRange(struct NodeBitmap* bitmap, uint32_t begin, uint32_t end);
+int bitmapCombine(const struct NodeBitmap* a, const struct NodeBitmap* b, int op, struct NodeBitmap* out);
+long bitmapCardinality(const struct NodeBitmap* bitmap);
+int bitmapToArray(const struct NodeBitmap* bitmap, int* out, int max_values);
+
+// 查询语言函数
+int compileQuery(struct TreeNode* root, const char* text, struct CompiledQuery* query, char* error, size_t error_cap);
+int runCompiledQuery(const struct CompiledQuery* query, struct TreeNode** results, int max_results);
+long countCompiledQuery(const struct CompiledQuery* query);
+int executeCompiledQuery(const struct CompiledQuery* query, struct QueryOutput* out);
+
+// 数据验证函数
+static int validateCode(const char* code);
+static int validateName(const char* name);
+static int hasHousePrice(const struct Region* data);
+static int hasEmploymentRate(const struct Region* data);
+
+// 数据显示函数
+static void displayNodeInfo(struct TreeNode* node, int show_separator);
+
+// 异步读取函数
+struct AsyncReader* asyncReaderOpen(const char* filename);
+const char* asyncReaderNext(struct AsyncReader* reader, size_t* length);
+const char* asyncReaderModeName(const struct AsyncReader* reader);
+void asyncReaderClose(struct AsyncReader* reader);
+char* readWholeFile(const char* filename, size_t* size);
+
+// 数据加载函数
+int loadRegionsFromCSV(struct Region regions[], const char* filename);
+struct TreeNode* loadDataset(const char* filename);
+
+// 地址解析函数
+void normalizeAddress(const char* in, char* out);
+struct TreeNode* resolveAddress(struct TreeNode* root, const char* text, size_t* matched);
+int runResolvePipeline(struct TreeNode* root, const char* input, const char* output, int kind);
+
+// 区划边界函数
+int loadBoundaries(const char* filename);
+struct TreeNode* locatePoint(double lat, double lon);
+int parseLatLon(const char* text, double* lat, double* lon);
+void freeBoundaries(void);
+
+// 区划质心函数
+int loadCentroids(const char* filename);
+int nearestRegions(double lat, double lon, int level, const struct TreeNode* within, int k,
+                   struct TreeNode** results, double* kilometers);
+int parseNearestQuery(const char* text, struct NearestQuery* query);
+struct TreeNode* resolveNearestLine(struct TreeNode* root, const char* line, double* kilometers);
+void freeCentroids(void);
+
+// 区划邻接函数
+int loadAdjacency(const char* filename);
+int regionNeighbors(const struct TreeNode* source, int hops, int same_parent, struct TreeNode** results,
+                    int* distances, int max_results);
+int parseNeighborQuery(const char* text, struct NeighborQuery* query);
+int appendNeighborLine(struct TreeNode* root, const char* line, struct QueryOutput* out);
+void freeAdjacency(void);
+
+// 索引文件函数
+int writeIndexBlob(const char* filename);
+struct TreeNode* loadTreeFromBlob(const unsigned char* blob, size_t size);
+int isIndexBlobFile(const char* filename);
+struct TreeNode* loadTreeFromBlobFile(const char* filename);
+
+// 共享内存IPC函数
+int runIpcServer(struct TreeNode* root, const char* name, int wait_mode);
+int runIpcClient(const char* name, int wait_mode, int repeat);
+
+// 网络服务函数
+int runQueryServer(struct TreeNode* root, const char* endpoint, int protocol);
+
+// 用户界面函数
+static int getInput(char* buffer, int max_len, const char* prompt);
+int showMainMenu(struct TreeNode* root);
+
+// === 函数实现部分 ===
+
+// 1. 内存区函数组
+int arenaInit(struct Arena* arena, size_t size) {
+    arenaRelease(arena);
+    // 预留一页余量供对齐使用
+    size += 4096;
+
+#ifdef _WIN32
+    arena->base = malloc(size);
+    arena->page_mode = ARENA_PAGES_HEAP;
+#else
+    size_t huge_size = (size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    void* base = MAP_FAILED;
+
+    // 不足一个大页的内存区使用普通页，避免整页浪费
+    if (size >= HUGE_PAGE_SIZE) {
+#ifdef MAP_HUGETLB
+        base = mmap(NULL, huge_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (base != MAP_FAILED) {
+            arena->page_mode = ARENA_PAGES_HUGETLB;
+            size = huge_size;
+        }
+#endif
+    }
+    if (base == MAP_FAILED) {
+        // 显式大页不可用（未预留或不支持），退回普通映射并建议内核使用透明大页
+        // 末尾加一个不可访问的保护页，防止内核把相邻内存区合并为同一映射，便于分别统计大页；
+        // 大小先取整到页，保护页才能按页对齐设置
+        size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        size = size >= HUGE_PAGE_SIZE ? huge_size : (size + page - 1) / page * page;
+        base = mmap(NULL, size + page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        arena->page_mode = ARENA_PAGES_NORMAL;
+        if (base != MAP_FAILED) {
+            if (mprotect((char*)base + size, page, PROT_NONE) == 0) {
+                arena->guard = page;
+            } else {
+                munmap((char*)base + size, page);
+            }
+        }
+#ifdef MADV_HUGEPAGE
+        if (base != MAP_FAILED && size >= HUGE_PAGE_SIZE && madvise(base, size, MADV_HUGEPAGE) == 0) {
+            arena->page_mode = ARENA_PAGES_THP;
+        }
+#endif
+    }
+    arena->base = base == MAP_FAILED ? NULL : base;
+#endif
+
+    if (arena->base == NULL) {
+        perror("内存区分配失败");
+        return -1;
+    }
+    arena->size = size;
+    arena->used = 0;
+    return 0;
+}
+
+void* arenaAlloc(struct Arena* arena, size_t size, size_t align) {
+    size_t offset = (arena->used + align - 1) & ~(align - 1);
+    if (arena->base == NULL || offset + size > arena->size) {
+        fprintf(stderr, "内存区 %s 空间不足\n", arena->label);
+        exit(1);
+    }
+    arena->used = offset + size;
+    return arena->base + offset;
+}
+
+int arenaOwns(const struct Arena* arena, const void* ptr) {
+    const char* p = ptr;
+    return arena->base != NULL && p >= arena->base && p < arena->base + arena->size;
+}
+
+void arenaRelease(struct Arena* arena) {
+    if (arena->base == NULL) return;
+#ifdef _WIN32
+    free(arena->base);
+#else
+    munmap(arena->base, arena->size + arena->guard);
+#endif
+    arena->base = NULL;
+    arena->guard = 0;
+    arena->size = 0;
+    arena->used = 0;
+}
+
+/**
+ * @brief 映射当前线程的临时区
+ * @details 不走arenaInit的显式大页策略：每个线程只预留地址空间，页在首次写入时才分配，
+ *          只建议内核使用透明大页
+ */
+static int scratchInit(void) {
+#ifdef _WIN32
+    t_scratch.base = malloc(SCRATCH_ARENA_SIZE);
+    t_scratch.page_mode = ARENA_PAGES_HEAP;
+#else
+    void* base = mmap(NULL, SCRATCH_ARENA_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                      -1, 0);
+    t_scratch.base = base == MAP_FAILED ? NULL : base;
+    t_scratch.page_mode = ARENA_PAGES_NORMAL;
+#ifdef MADV_HUGEPAGE
+    if (t_scratch.base != NULL && madvise(t_scratch.base, SCRATCH_ARENA_SIZE, MADV_HUGEPAGE) == 0) {
+        t_scratch.page_mode = ARENA_PAGES_THP;
+    }
+#endif
+#endif
+    if (t_scratch.base == NULL) return -1;
+    t_scratch.size = SCRATCH_ARENA_SIZE;
+    t_scratch.used = 0;
+    t_scratch.guard = 0;
+    return 0;
+}
+
+/**
+ * @brief 从当前线程的临时区分配（16字节对齐）
+ * @details 首次使用时映射；临时区满时返回NULL而不退出，由调用方按内存不足处理
+ */
+void* scratchAlloc(size_t size) {
+    if (t_scratch.base == NULL && scratchInit() != 0) return NULL;
+
+    size_t offset = (t_scratch.used + 15) & ~(size_t)15;
+    if (offset + size > t_scratch.size) return NULL;
+    t_scratch.used = offset + size;
+    return t_scratch.base + offset;
+}
+
+/**
+ * @brief 记录临时区当前位置，配合scratchReset释放其后分配的全部内存
+ */
+size_t scratchMark(void) {
+    return t_scratch.used;
+}
+
+void scratchReset(size_t mark) {
+    if (mark < t_scratch.used) t_scratch.used = mark;
+}
+
+/**
+ * @brief 线程退出前释放临时区映射
+ */
+void scratchRelease(void) {
+    arenaRelease(&t_scratch);
+}
+
+/**
+ * @brief 统计内存区中实际由透明大页承载的字节数
+ * @details 读取/proc/self/smaps中对应映射的AnonHugePages，非Linux平台返回0
+ */
+static size_t arenaHugeBytes(const struct Arena* arena) {
+    size_t bytes = 0;
+#ifdef __linux__
+    FILE* smaps = fopen("/proc/self/smaps", "r");
+    if (smaps == NULL) return 0;
+
+    char line[256];
+    int in_arena = 0;
+    while (fgets(line, sizeof(line), smaps)) {
+        unsigned long start, end;
+        size_t kb;
+        if (sscanf(line, "%lx-%lx ", &start, &end) == 2 && strchr(line, '-') < strchr(line, ' ')) {
+            in_arena = (char*)start >= arena->base && (char*)start < arena->base + arena->size;
+        } else if (in_arena && sscanf(line, "AnonHugePages: %zu kB", &kb) == 1) {
+            bytes += kb * 1024;
+        }
+    }
+    fclose(smaps);
+#else
+    (void)arena;
+#endif
+    return bytes;
+}
+
+void reportArenas(void) {
+    struct Arena* arenas[] = { &g_node_arena, &g_child_arena, &g_index_arena };
+
+    printf("内存区分配情况：\n");
+    for (size_t i = 0; i < sizeof(arenas) / sizeof(arenas[0]); i++) {
+        const struct Arena* arena = arenas[i];
+        if (arena->base == NULL) continue;
+
+        printf("  %s：%.1f MB，", arena->label, arena->used / 1048576.0);
+        switch (arena->page_mode) {
+            case ARENA_PAGES_HUGETLB:
+                printf("显式大页\n");
+                break;
+            case ARENA_PAGES_THP:
+                printf("透明大页（已生效 %.1f MB）\n", arenaHugeBytes(arena) / 1048576.0);
+                break;
+            case ARENA_PAGES_HEAP:
+                printf("堆内存\n");
+                break;
+            default:
+                printf("普通页\n");
+        }
+    }
+}
+
+// 2. 代码方案函数组
+/**
+ * @brief 按固定位数解析数字代码；digits为常量时编译器展开为无循环的专用代码
+ */
+static inline int parseFixedDigits(const char* code, int digits, uint64_t* value) {
+    uint64_t v = 0;
+    for (int i = 0; i < digits; i++) {
+        unsigned int d = (unsigned int)(unsigned char)code[i] - '0';
+        if (d > 9) return -1;
+        v = v * 10 + d;
+    }
+    if (code[digits] != '\0') return -1;
+    *value = v;
+    return 0;
+}
+
+/**
+ * @brief 由代码推出级别：自最深一级起，末尾整级为0的不计
+ * @param units units[l]为第l+1级及以下各位的取模基数
+ */
+static inline int levelFromUnits(uint64_t value, const uint64_t* units, int levels) {
+    for (int l = levels; l > 0; l--) {
+        if (value % units[l - 1] != 0) return l;
+    }
+    return 0;
+}
+
+/**
+ * @brief 上级代码：把最深的非0一级清零（可跨过中间为0的级，如不设区县的地级市下的乡镇）
+ */
+static inline int parentFromUnits(uint64_t value, const uint64_t* units, int levels, uint64_t* parent) {
+    int level = levelFromUnits(value, units, levels);
+    if (level == 0) return -1;
+    *parent = value - value % units[level - 1];
+    return 0;
+}
+
+// 12位国家标准代码（省2、地2、县2、乡3、村3）：取模基数为常量，除法化为乘法
+static const uint64_t CN12_UNITS[] = { 1000000000000ULL, 10000000000ULL, 100000000ULL, 1000000ULL, 1000ULL };
+static int parseCodeCN12(const char* code, uint64_t* value) { return parseFixedDigits(code, 12, value); }
+static int codeLevelCN12(uint64_t value) { return levelFromUnits(value, CN12_UNITS, 5); }
+static int codeParentCN12(uint64_t value, uint64_t* parent) { return parentFromUnits(value, CN12_UNITS, 5, parent); }
+
+// 6位GB/T 2260县级代码（省2、地2、县2）
+static const uint64_t CN6_UNITS[] = { 1000000ULL, 10000ULL, 100ULL };
+static int parseCodeCN6(const char* code, uint64_t* value) { return parseFixedDigits(code, 6, value); }
+static int codeLevelCN6(uint64_t value) { return levelFromUnits(value, CN6_UNITS, 3); }
+static int codeParentCN6(uint64_t value, uint64_t* parent) { return parentFromUnits(value, CN6_UNITS, 3, parent); }
+
+static struct CodeScheme g_code_scheme = {
+    .name = "cn12",
+    .level_count = 5,
+    .digits = { 2, 2, 2, 3, 3 },
+    .total_digits = 12,
+    .root_code = "000000000000",
+    .units = { 1000000000000ULL, 10000000000ULL, 100000000ULL, 1000000ULL, 1000ULL },
+    .parse = parseCodeCN12,
+    .level = codeLevelCN12,
+    .parent = codeParentCN12
+};
+
+// 其他方案按描述符中的位数表逐级计算
+static int parseCodeGeneric(const char* code, uint64_t* value) {
+    return parseFixedDigits(code, g_code_scheme.total_digits, value);
+}
+
+static int codeLevelGeneric(uint64_t value) {
+    return levelFromUnits(value, g_code_scheme.units, g_code_scheme.level_count);
+}
+
+static int codeParentGeneric(uint64_t value, uint64_t* parent) {
+    return parentFromUnits(value, g_code_scheme.units, g_code_scheme.level_count, parent);
+}
+
+int setCodeScheme(const char* spec) {
+    struct CodeScheme scheme = { 0 };
+    const char* digits = spec;
+
+    // cn12 | cn6 | 各级位数（逗号分隔）[:根代码]
+    if (strcmp(spec, "cn12") == 0) {
+        digits = "2,2,2,3,3";
+    } else if (strcmp(spec, "cn6") == 0) {
+        digits = "2,2,2";
+    }
+    for (const char* p = digits; *p != '\0' && *p != ':';) {
+        char* end;
+        long n = strtol(p, &end, 10);
+        if (end == p || n < 1 || scheme.level_count >= CODE_SCHEME_MAX_LEVELS ||
+            scheme.total_digits + n > CODE_SCHEME_MAX_DIGITS) {
+            return -1;
+        }
+        if (*end != ',' && *end != ':' && *end != '\0') return -1;
+        scheme.digits[scheme.level_count++] = (int)n;
+        scheme.total_digits += (int)n;
+        p = *end == ',' ? end + 1 : end;
+    }
+    if (scheme.level_count == 0) return -1;
+
+    uint64_t unit = 1;
+    for (int l = scheme.level_count - 1; l >= 0; l--) {
+        for (int d = 0; d < scheme.digits[l]; d++) unit *= 10;
+        scheme.units[l] = unit;
+    }
+
+    const char* root = strchr(digits, ':');
+    if (root != NULL) {
+        uint64_t value;
+        if (strlen(root + 1) >= sizeof(scheme.root_code) ||
+            parseFixedDigits(root + 1, scheme.total_digits, &value) != 0) {
+            return -1;
+        }
+        strcpy(scheme.root_code, root + 1);
+    } else {
+        memset(scheme.root_code, '0', scheme.total_digits);
+        scheme.root_code[scheme.total_digits] = '\0';
+    }
+
+    // 与内置方案位数相同时使用常量展开的专用函数
+    static const int cn12_digits[] = { 2, 2, 2, 3, 3 };
+    static const int cn6_digits[] = { 2, 2, 2 };
+    if (scheme.level_count == 5 && memcmp(scheme.digits, cn12_digits, sizeof(cn12_digits)) == 0) {
+        snprintf(scheme.name, sizeof(scheme.name), "cn12");
+        scheme.parse = parseCodeCN12;
+        scheme.level = codeLevelCN12;
+        scheme.parent = codeParentCN12;
+    } else if (scheme.level_count == 3 && memcmp(scheme.digits, cn6_digits, sizeof(cn6_digits)) == 0) {
+        snprintf(scheme.name, sizeof(scheme.name), "cn6");
+        scheme.parse = parseCodeCN6;
+        scheme.level = codeLevelCN6;
+        scheme.parent = codeParentCN6;
+    } else {
+        snprintf(scheme.name, sizeof(scheme.name), "%d级%d位", scheme.level_count, scheme.total_digits);
+        scheme.parse = parseCodeGeneric;
+        scheme.level = codeLevelGeneric;
+        scheme.parent = codeParentGeneric;
+    }
+    g_code_scheme = scheme;
+    return 0;
+}
+
+int codeLevel(const char* code) {
+    uint64_t value;
+    if (g_code_scheme.parse(code, &value) != 0) return -1;
+    return g_code_scheme.level(value);
+}
+
+void formatSchemeCode(uint64_t value, char* out) {
+    for (int i = g_code_scheme.total_digits - 1; i >= 0; i--) {
+        out[i] = (char)('0' + value % 10);
+        value /= 10;
+    }
+    out[g_code_scheme.total_digits] = '\0';
+}
+
+int deriveParentCode(const char* code, char* parent) {
+    uint64_t value, parent_value;
+    if (g_code_scheme.parse(code, &value) != 0 || g_code_scheme.parent(value, &parent_value) != 0) return -1;
+
+    // 顶级区划的上级为虚拟根节点
+    if (g_code_scheme.level(parent_value) == 0) {
+        strcpy(parent, "0");
+    } else {
+        formatSchemeCode(parent_value, parent);
+    }
+    return 0;
+}
+
+// 3. 树节点操作函数组
+static void initNode(struct TreeNode* node, struct Region data) {
+    node->data = data;
+    node->children = NULL;
+    node->child_count = 0;
+    node->child_capacity = 0;
+    node->parent = NULL;  // 初始父节点指针为NULL
+    node->dfs_index = -1;
+    node->subtree_end = -1;
+}
+
+struct TreeNode* createNode(struct Region data) {
+    struct TreeNode* node = (struct TreeNode*)malloc(sizeof(struct TreeNode));
+    if (node == NULL) {
+        perror("内存分配失败");
+        return NULL;
+    }
+    initNode(node, data);
+    node->child_capacity = 10;
+    node->children = (struct TreeNode**)malloc(node->child_capacity * sizeof(struct TreeNode*));
+    if (node->children == NULL) {
+        perror("内存分配失败");
+        free(node);
+        return NULL;
+    }
+    return node;
+}
+
+void addChild(struct TreeNode* parent, struct TreeNode* child) {
+    if (parent->child_count >= parent->child_capacity) {
+        struct TreeNode** old = parent->children;
+        int in_arena = arenaOwns(&g_child_arena, old);
+        parent->child_capacity = parent->child_capacity > 0 ? parent->child_capacity * 2 : 10;
+        // 子节点区中的数组不能realloc，扩容时复制到堆上
+        parent->children = (struct TreeNode**)realloc(in_arena ? NULL : old, 
+            parent->child_capacity * sizeof(struct TreeNode*));
+        if (parent->children != NULL && in_arena) {
+            memcpy(parent->children, old, parent->child_count * sizeof(struct TreeNode*));
+        }
+        if (parent->children == NULL) {
+            perror("内存重新分配失败");
+            exit(1);
+        }
+    }
+    parent->children[parent->child_count++] = child;
+    child->parent = parent;  // 设置子节点的父节点指针
+}
+
+static int compareCodeToNode(const void* a, const void* b) {
+    const struct {
+        char code[MAX_CODE_LENGTH];
+        struct TreeNode* node;
+    } *nodeA = a, *nodeB = b;
+    
+    return strcmp(nodeA->code, nodeB->code);
+}
+
+struct TreeNode* buildTree(struct Region regions[], int size) {
+    // 节点连续存放于节点区：下标0为虚拟根节点，其后依次为各地区
+    if (arenaInit(&g_node_arena, (size_t)(size + 1) * sizeof(struct TreeNode)) != 0) {
+        return NULL;
+    }
+    struct TreeNode* nodes = arenaAlloc(&g_node_arena, (size_t)(size + 1) * sizeof(struct TreeNode), 64);
+    int* parent_of = malloc(size * sizeof(int));
+
+    // 创建用于快速查找的临时映射数组
+    struct {
+        char code[MAX_CODE_LENGTH];
+        struct TreeNode* node;
+    } *codeToNode = malloc(size * sizeof(*codeToNode));
+    
+    if (codeToNode == NULL || parent_of == NULL) {
+        free(codeToNode);
+        free(parent_of);
+        arenaRelease(&g_node_arena);
+        perror("内存分配失败");
+        return NULL;
+    }
+
+    // 创建虚拟的全国根节点
+    struct Region china = {
+        .code = "",
+        .name = "中华人民共和国",
+        .level = 0,
+        .parent_code = "0",
+        .type = 0,
+        .avg_house_price = NULL,
+        .employment_rate = NULL
+    };
+    strcpy(china.code, g_code_scheme.root_code);
+    struct TreeNode* root = &nodes[0];
+    initNode(root, china);
+
+    printf("开始创建节点...");
+    // 创建所有节点并建立索引
+    for (int i = 0; i < size; i++) {
+        initNode(&nodes[i + 1], regions[i]);
+        
+        // 保存代码到节点的映射
+        strncpy(codeToNode[i].code, regions[i].code, MAX_CODE_LENGTH - 1);
+        codeToNode[i].code[MAX_CODE_LENGTH - 1] = '\0';
+        codeToNode[i].node = &nodes[i + 1];
+        
+        if (i % 1000 == 0 || i == size - 1) {
+            printf("\r已创建 %d/%d 个节点... (%.1f%%)", i + 1, size, (float)(i + 1)/size*100);
+            fflush(stdout);
+        }
+    }
+    printf("\n节点创建完成\n");
+
+    printf("正在对节点进行排序...");
+    qsort(codeToNode, size, sizeof(*codeToNode), compareCodeToNode);
+    printf("完成\n");
+
+    printf("开始建立父子关系...");
+    // 使用二分查找定位父节点，先统计各节点子节点数
+    for (int i = 0; i < size; i++) {
+        parent_of[i] = -1;
+        // 上级代码列不是本方案的有效代码（如填"-"）时，由本级代码推出
+        if (strcmp(regions[i].parent_code, "0") != 0 && validateCode(regions[i].parent_code) != 0) {
+            deriveParentCode(regions[i].code, regions[i].parent_code);
+        }
+        if (strcmp(regions[i].parent_code, "0") == 0) {
+            // 省级节点直接添加到根节点下
+            parent_of[i] = 0;
+        } else {
+            // 使用二分查找快速定位父节点
+            int left = 0, right = size - 1;
+            
+            while (left <= right) {
+                int mid = (left + right) / 2;
+                int cmp = strcmp(codeToNode[mid].code, regions[i].parent_code);
+                
+                if (cmp == 0) {
+                    parent_of[i] = (int)(codeToNode[mid].node - nodes);
+                    break;
+                } else if (cmp < 0) {
+                    left = mid + 1;
+                } else {
+                    right = mid - 1;
+                }
+            }
+        }
+        if (parent_of[i] >= 0) {
+            nodes[parent_of[i]].child_capacity++;
+        }
+        
+        if (i % 1000 == 0 || i == size - 1) {
+            printf("\r已处理 %d/%d 个节点的父子关系... (%.1f%%)", 
+                   i + 1, size, (float)(i + 1)/size*100);
+            fflush(stdout);
+        }
+    }
+
+    // 子节点指针数组按实际数量从子节点区切分，无需扩容
+    if (arenaInit(&g_child_arena, (size_t)size * sizeof(struct TreeNode*)) != 0) {
+        free(codeToNode);
+        free(parent_of);
+        arenaRelease(&g_node_arena);
+        return NULL;
+    }
+    for (int i = 0; i <= size; i++) {
+        if (nodes[i].child_capacity > 0) {
+            nodes[i].children = arenaAlloc(&g_child_arena,
+                nodes[i].child_capacity * sizeof(struct TreeNode*), sizeof(struct TreeNode*));
+        }
+    }
+    for (int i = 0; i < size; i++) {
+        // 找到父节点后建立关系
+        if (parent_of[i] >= 0) {
+            struct TreeNode* parent = &nodes[parent_of[i]];
+            parent->children[parent->child_count++] = &nodes[i + 1];
+            nodes[i + 1].parent = parent;
+        }
+    }
+    printf("\n父子关系建立完成\n");
+
+    // 清理临时数据结构
+    free(codeToNode);
+    free(parent_of);
+    return root;
+}
+
+void freeTree(struct TreeNode* root) {
+    if (root == NULL) return;
+
+    // buildTree建立的树整体位于节点区，直接释放各内存区
+    if (arenaOwns(&g_node_arena, root)) {
+        arenaRelease(&g_child_arena);
+        arenaRelease(&g_node_arena);
+        return;
+    }
+    
+    // 递归释放所有子节点
+    for (int i = 0; i < root->child_count; i++) {
+        freeTree(root->children[i]);
+    }
+    
+    // 释放当前节点的资源
+    free(root->children);
+    free(root);
+}
+
+// 4. 区划索引函数组
+static int parseCode(const char* code, uint64_t* value) {
+    return g_code_scheme.parse(code, value);
+}
+
+static int bitWidth(uint32_t v) {
+    int bits = 0;
+    while (v) {
+        bits++;
+        v >>= 1;
+    }
+    return bits;
+}
+
+/**
+ * @brief 计算一块代码的增量及位宽
+ * @return 增量位宽，跨度超过32位的块返回CODE_BLOCK_RAW
+ */
+static int codeBlockDeltas(const uint64_t* codes, int first, int n, uint32_t* deltas) {
+    // 块跨度超过32位（如跨省）时无法用32位前缀和还原，按原始值存储
+    if (codes[first + n - 1] - codes[first] > UINT32_MAX) return CODE_BLOCK_RAW;
+
+    uint32_t max_delta = 0;
+    for (int j = 0; j < CODE_BLOCK_SIZE; j++) {
+        deltas[j] = (j > 0 && j < n) ? (uint32_t)(codes[first + j] - codes[first + j - 1]) : 0;
+        if (deltas[j] > max_delta) max_delta = deltas[j];
+    }
+    return bitWidth(max_delta);
+}
+
+size_t codeColumnBytes(const uint64_t* codes, int count) {
+    int blocks = (count + CODE_BLOCK_SIZE - 1) / CODE_BLOCK_SIZE;
+    size_t words = 0;
+    uint32_t deltas[CODE_BLOCK_SIZE];
+
+    for (int b = 0; b < blocks; b++) {
+        int first = b * CODE_BLOCK_SIZE;
+        int n = count - first < CODE_BLOCK_SIZE ? count - first : CODE_BLOCK_SIZE;
+        int bits = codeBlockDeltas(codes, first, n, deltas);
+        words += bits == CODE_BLOCK_RAW ? CODE_BLOCK_SIZE * 2 : (size_t)bits * 4;
+    }
+    // 另加对齐余量
+    return words * sizeof(uint32_t) + (size_t)blocks * 13 + 64;
+}
+
+static int buildCodeColumn(struct CodeColumn* col, const uint64_t* codes, int count, struct Arena* arena) {
+    memset(col, 0, sizeof(*col));
+    int blocks = (count + CODE_BLOCK_SIZE - 1) / CODE_BLOCK_SIZE;
+    uint8_t* bits_of = malloc(blocks);
+    if (bits_of == NULL) {
+        perror("内存分配失败");
+        return -1;
+    }
+
+    // 第一遍确定各块位宽与总字数，第二遍写入
+    size_t words = 0;
+    uint32_t deltas[CODE_BLOCK_SIZE];
+    for (int b = 0; b < blocks; b++) {
+        int first = b * CODE_BLOCK_SIZE;
+        int n = count - first < CODE_BLOCK_SIZE ? count - first : CODE_BLOCK_SIZE;
+        bits_of[b] = (uint8_t)codeBlockDeltas(codes, first, n, deltas);
+        words += bits_of[b] == CODE_BLOCK_RAW ? CODE_BLOCK_SIZE * 2 : (size_t)bits_of[b] * 4;
+    }
+
+    col->block_base = arenaAlloc(arena, blocks * sizeof(uint64_t), sizeof(uint64_t));
+    col->block_offset = arenaAlloc(arena, blocks * sizeof(uint32_t), sizeof(uint32_t));
+    col->block_bits = arenaAlloc(arena, blocks, 1);
+    col->packed = arenaAlloc(arena, words * sizeof(uint32_t), 16);
+
+    words = 0;
+    for (int b = 0; b < blocks; b++) {
+        int first = b * CODE_BLOCK_SIZE;
+        int n = count - first < CODE_BLOCK_SIZE ? count - first : CODE_BLOCK_SIZE;
+        int bits = codeBlockDeltas(codes, first, n, deltas);
+
+        col->block_base[b] = codes[first];
+        col->block_offset[b] = (uint32_t)words;
+        col->block_bits[b] = (uint8_t)bits;
+
+        if (bits == CODE_BLOCK_RAW) {
+            for (int j = 0; j < CODE_BLOCK_SIZE; j++) {
+                uint64_t v = codes[first + (j < n ? j : n - 1)];
+                col->packed[words++] = (uint32_t)v;
+                col->packed[words++] = (uint32_t)(v >> 32);
+            }
+            continue;
+        }
+
+        // 4路交错：第l路依次存放增量 l, l+4, l+8, ...，每路恰好占bits个字
+        for (int lane = 0; lane < 4; lane++) {
+            uint64_t acc = 0;
+            int filled = 0, w = 0;
+            for (int k = 0; k < CODE_BLOCK_SIZE / 4; k++) {
+                acc |= (uint64_t)deltas[k * 4 + lane] << filled;
+                filled += bits;
+                if (filled >= 32) {
+                    col->packed[words + w * 4 + lane] = (uint32_t)acc;
+                    acc >>= 32;
+                    filled -= 32;
+                    w++;
+                }
+            }
+        }
+        words += (size_t)bits * 4;
+    }
+
+    free(bits_of);
+    col->packed_words = words;
+    col->count = count;
+    col->block_count = blocks;
+    return 0;
+}
+
+/**
+ * @brief 解码一块代码
+ * @param out 输出块内各代码相对块首代码的偏移（原始块不使用）
+ * @return 块位宽，原始块返回CODE_BLOCK_RAW
+ */
+static int decodeCodeBlock(const struct CodeColumn* col, int block, uint32_t* out) {
+    int bits = col->block_bits[block];
+    const uint32_t* in = col->packed + col->block_offset[block];
+
+    if (bits == CODE_BLOCK_RAW) return bits;
+    if (bits == 0) {
+        memset(out, 0, CODE_BLOCK_SIZE * sizeof(uint32_t));
+        return bits;
+    }
+
+#ifdef __SSE2__
+    // 4路同时解包：各路位偏移相同，可共用移位量
+    const __m128i mask = _mm_set1_epi32(bits == 32 ? -1 : (int)((1u << bits) - 1));
+    const __m128i* p = (const __m128i*)in;
+    __m128i w = _mm_loadu_si128(p++);
+    int shift = 0;
+
+    for (int k = 0; k < CODE_BLOCK_SIZE / 4; k++) {
+        __m128i v = _mm_srl_epi32(w, _mm_cvtsi32_si128(shift));
+        shift += bits;
+        if (shift >= 32 && k < CODE_BLOCK_SIZE / 4 - 1) {
+            shift -= 32;
+            w = _mm_loadu_si128(p++);
+            if (shift > 0) {
+                v = _mm_or_si128(v, _mm_sll_epi32(w, _mm_cvtsi32_si128(bits - shift)));
+            }
+        }
+        _mm_storeu_si128((__m128i*)(out + k * 4), _mm_and_si128(v, mask));
+    }
+
+    // 前缀和：组内两次错位相加，再加上前一组的末值
+    __m128i carry = _mm_setzero_si128();
+    for (int k = 0; k < CODE_BLOCK_SIZE / 4; k++) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(out + k * 4));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi32(x, carry);
+        _mm_storeu_si128((__m128i*)(out + k * 4), x);
+        carry = _mm_shuffle_epi32(x, 0xFF);
+    }
+#else
+    uint32_t mask = bits == 32 ? UINT32_MAX : (1u << bits) - 1;
+    for (int lane = 0; lane < 4; lane++) {
+        uint64_t acc = 0;
+        int avail = 0, w = 0;
+        for (int k = 0; k < CODE_BLOCK_SIZE / 4; k++) {
+            if (avail < bits) {
+                acc |= (uint64_t)in[w * 4 + lane] << avail;
+                avail += 32;
+                w++;
+            }
+            out[k * 4 + lane] = (uint32_t)acc & mask;
+            acc >>= bits;
+            avail -= bits;
+        }
+    }
+    for (int j = 1; j < CODE_BLOCK_SIZE; j++) {
+        out[j] += out[j - 1];
+    }
+#endif
+    return bits;
+}
+
+uint64_t codeColumnGet(const struct CodeColumn* col, int index) {
+    uint32_t rel[CODE_BLOCK_SIZE];
+    int block = index / CODE_BLOCK_SIZE;
+    int offset = index % CODE_BLOCK_SIZE;
+
+    if (decodeCodeBlock(col, block, rel) == CODE_BLOCK_RAW) {
+        const uint32_t* raw = col->packed + col->block_offset[block];
+        return (uint64_t)raw[offset * 2] | ((uint64_t)raw[offset * 2 + 1] << 32);
+    }
+    return col->block_base[block] + rel[offset];
+}
+
+void decodeCodeValues(const struct CodeColumn* col, int block, uint64_t* out) {
+    uint32_t rel[CODE_BLOCK_SIZE];
+
+    if (decodeCodeBlock(col, block, rel) == CODE_BLOCK_RAW) {
+        const uint32_t* raw = col->packed + col->block_offset[block];
+        for (int j = 0; j < CODE_BLOCK_SIZE; j++) {
+            out[j] = (uint64_t)raw[j * 2] | ((uint64_t)raw[j * 2 + 1] << 32);
+        }
+        return;
+    }
+    for (int j = 0; j < CODE_BLOCK_SIZE; j++) {
+        out[j] = col->block_base[block] + rel[j];
+    }
+}
+
+int codeColumnFind(const struct CodeColumn* col, uint64_t code) {
+    if (col->count == 0 || code < col->block_base[0]) return -1;
+
+    // 跳跃指针上二分，定位最后一个首代码不大于目标的块
+    int left = 0, right = col->block_count - 1;
+    while (left < right) {
+        int mid = (left + right + 1) / 2;
+        if (col->block_base[mid] <= code) {
+            left = mid;
+        } else {
+            right = mid - 1;
+        }
+    }
+
+    int block = left;
+    int first = block * CODE_BLOCK_SIZE;
+    int n = col->count - first < CODE_BLOCK_SIZE ? col->count - first : CODE_BLOCK_SIZE;
+    uint32_t rel[CODE_BLOCK_SIZE];
+
+    if (decodeCodeBlock(col, block, rel) == CODE_BLOCK_RAW) {
+        const uint32_t* raw = col->packed + col->block_offset[block];
+        for (int j = 0; j < n; j++) {
+            uint64_t v = (uint64_t)raw[j * 2] | ((uint64_t)raw[j * 2 + 1] << 32);
+            if (v == code) return first + j;
+            if (v > code) break;
+        }
+        return -1;
+    }
+
+    uint64_t diff = code - col->block_base[block];
+    if (diff > UINT32_MAX) return -1;
+
+    int lo = 0, hi = n - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (rel[mid] == (uint32_t)diff) return first + mid;
+        if (rel[mid] < (uint32_t)diff) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return -1;
+}
+
+static uint64_t mphHash(uint64_t key, uint64_t seed) {
+    uint64_t x = key ^ seed;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+/**
+ * @brief 在指定种子下搜索各桶的引导值
+ * @return 成功返回0，存在无法安置的桶返回-1
+ */
+static int searchMphPilots(struct CodeMph* mph, const uint64_t* hashes, const int* bucket_keys,
+                           const int* bucket_start, const int* order,
+                           uint8_t* taken, uint64_t* positions) {
+    memset(taken, 0, mph->table_size);
+
+    for (uint32_t b = 0; b < mph->bucket_count; b++) {
+        int bucket = order[b];
+        int first = bucket_start[bucket], last = bucket_start[bucket + 1];
+        if (first == last) break;
+
+        int placed = 0;
+        for (uint32_t pilot = 0; pilot <= UINT16_MAX && !placed; pilot++) {
+            uint64_t pilot_hash = mphHash(pilot, mph->seed);
+            int k = first;
+            for (; k < last; k++) {
+                uint64_t pos = (hashes[bucket_keys[k]] ^ pilot_hash) % mph->table_size;
+                if (taken[pos]) break;
+                taken[pos] = 1;
+                positions[bucket_keys[k]] = pos;
+            }
+            if (k == last) {
+                mph->pilots[bucket] = (uint16_t)pilot;
+                placed = 1;
+            } else {
+                // 撤销本次尝试已占用的位置
+                for (int u = first; u < k; u++) taken[positions[bucket_keys[u]]] = 0;
+            }
+        }
+        if (!placed) return -1;
+    }
+    return 0;
+}
+
+int buildCodeMph(struct CodeMph* mph, const uint64_t* codes, int count) {
+    memset(mph, 0, sizeof(*mph));
+    mph->key_count = (uint32_t)count;
+    mph->bucket_count = (uint32_t)(count / MPH_KEYS_PER_BUCKET + 1);
+    mph->table_size = (uint64_t)count * 100 / MPH_LOAD_PERCENT + 1;
+
+    uint32_t buckets = mph->bucket_count;
+    uint64_t* hashes = malloc(count * sizeof(uint64_t));
+    uint64_t* positions = malloc(count * sizeof(uint64_t));
+    int* bucket_keys = malloc(count * sizeof(int));
+    int* bucket_start = calloc(buckets + 1, sizeof(int));
+    int* order = malloc(buckets * sizeof(int));
+    int* size_count = NULL;
+    uint8_t* taken = malloc(mph->table_size);
+    mph->pilots = calloc(buckets, sizeof(uint16_t));
+    mph->remap = calloc(mph->table_size - count + 1, sizeof(uint32_t));
+    mph->slots = malloc(count * sizeof(uint32_t));
+
+    int result = -1;
+    if (!hashes || !positions || !bucket_keys || !bucket_start || !order || !taken ||
+        !mph->pilots || !mph->remap || !mph->slots) {
+        perror("内存分配失败");
+        goto cleanup;
+    }
+
+    for (int attempt = 0; attempt < 16 && result != 0; attempt++) {
+        mph->seed = mphHash((uint64_t)attempt, 0x9E3779B97F4A7C15ULL);
+
+        // 按桶计数排序键
+        memset(bucket_start, 0, (buckets + 1) * sizeof(int));
+        for (int i = 0; i < count; i++) {
+            hashes[i] = mphHash(codes[i], mph->seed);
+            bucket_start[(hashes[i] >> 32) % buckets + 1]++;
+        }
+        int max_size = 0;
+        for (uint32_t b = 0; b < buckets; b++) {
+            if (bucket_start[b + 1] > max_size) max_size = bucket_start[b + 1];
+            bucket_start[b + 1] += bucket_start[b];
+        }
+        int* fill = malloc(buckets * sizeof(int));
+        size_count = calloc(max_size + 2, sizeof(int));
+        if (fill == NULL || size_count == NULL) {
+            free(fill);
+            perror("内存分配失败");
+            goto cleanup;
+        }
+        memcpy(fill, bucket_start, buckets * sizeof(int));
+        for (int i = 0; i < count; i++) {
+            bucket_keys[fill[(hashes[i] >> 32) % buckets]++] = i;
+        }
+        free(fill);
+
+        // 大桶优先安置：按桶大小降序计数排序
+        for (uint32_t b = 0; b < buckets; b++) {
+            size_count[max_size - (bucket_start[b + 1] - bucket_start[b]) + 1]++;
+        }
+        for (int s = 0; s <= max_size; s++) size_count[s + 1] += size_count[s];
+        for (uint32_t b = 0; b < buckets; b++) {
+            order[size_count[max_size - (bucket_start[b + 1] - bucket_start[b])]++] = (int)b;
+        }
+        free(size_count);
+        size_count = NULL;
+
+        result = searchMphPilots(mph, hashes, bucket_keys, bucket_start, order, taken, positions);
+    }
+    if (result != 0) {
+        printf("错误：最小完美哈希构建失败\n");
+        goto cleanup;
+    }
+
+    // 落在[n, m)的位置重映射到[0, n)中的空位，remap[0]为占位项
+    uint32_t free_slot = 0;
+    for (int i = 0; i < count; i++) {
+        if (positions[i] < (uint64_t)count) mph->slots[positions[i]] = (uint32_t)i;
+    }
+    for (int i = 0; i < count; i++) {
+        if (positions[i] < (uint64_t)count) continue;
+        while (taken[free_slot]) free_slot++;
+        taken[free_slot] = 1;
+        mph->remap[positions[i] - count + 1] = free_slot;
+        mph->slots[free_slot] = (uint32_t)i;
+    }
+
+cleanup:
+    free(hashes);
+    free(positions);
+    free(bucket_keys);
+    free(bucket_start);
+    free(order);
+    free(size_count);
+    free(taken);
+    if (result != 0) freeCodeMph(mph);
+    return result;
+}
+
+void freeCodeMph(struct CodeMph* mph) {
+    free(mph->pilots);
+    free(mph->remap);
+    free(mph->slots);
+    memset(mph, 0, sizeof(*mph));
+}
+
+int codeMphLookup(const struct CodeMph* mph, uint64_t code) {
+    uint64_t hash = mphHash(code, mph->seed);
+    uint16_t pilot = mph->pilots[(hash >> 32) % mph->bucket_count];
+    uint64_t pos = (hash ^ mphHash(pilot, mph->seed)) % mph->table_size;
+
+    // 越界位置经重映射表落回[0, n)，以算术选择代替分支；remap[0]恒可读
+    uint64_t over = pos >= mph->key_count;
+    uint64_t remapped = mph->remap[(pos - mph->key_count + 1) * over];
+    return (int)mph->slots[pos + over * (remapped - pos)];
+}
+
+static int assignDfsOrder(struct TreeNode* node, struct TreeNode** order, int next) {
+    node->dfs_index = next;
+    if (order) order[next] = node;
+    next++;
+    for (int i = 0; i < node->child_count; i++) {
+        next = assignDfsOrder(node->children[i], order, next);
+    }
+    node->subtree_end = next;
+    return next;
+}
+
+int buildRegionIndex(struct TreeNode* root) {
+    freeRegionIndex();
+    if (root == NULL) return -1;
+
+    int count = assignDfsOrder(root, NULL, 0);
+    struct TreeNode** order = malloc(count * sizeof(struct TreeNode*));
+    uint64_t* codes = malloc(count * sizeof(uint64_t));
+    if (order == NULL || codes == NULL) {
+        perror("内存分配失败");
+        free(order);
+        free(codes);
+        return -1;
+    }
+    assignDfsOrder(root, order, 0);
+
+    printf("正在压缩代码列...");
+    int sorted = 1;
+    for (int i = 0; i < count; i++) {
+        if (parseCode(order[i]->data.code, &codes[i]) != 0 || (i > 0 && codes[i] <= codes[i - 1])) {
+            sorted = 0;
+            break;
+        }
+    }
+
+    // DFS序节点表与代码列一并放入索引区
+    size_t column_bytes = sorted ? codeColumnBytes(codes, count) : 0;
+    if (arenaInit(&g_index_arena, count * sizeof(struct TreeNode*) + column_bytes) != 0) {
+        free(order);
+        free(codes);
+        return -1;
+    }
+    g_index.root = root;
+    g_index.dfs_nodes = arenaAlloc(&g_index_arena, count * sizeof(struct TreeNode*), sizeof(struct TreeNode*));
+    memcpy(g_index.dfs_nodes, order, count * sizeof(struct TreeNode*));
+    g_index.count = count;
+
+    // DFS序与代码序不一致时无法增量编码，代码查询退回树遍历
+    if (!sorted) {
+        printf("跳过（DFS序与代码序不一致）\n");
+    } else if (buildCodeColumn(&g_index.codes, codes, count, &g_index_arena) == 0) {
+        printf("完成（%d 个代码，%.2f 字节/代码）\n", count,
+               (double)(g_index.codes.packed_words * 4 + g_index.codes.block_count * 13) / count);
+    }
+    free(order);
+    free(codes);
+    return 0;
+}
+
+void freeRegionIndex(void) {
+    arenaRelease(&g_index_arena);
+    memset(&g_index, 0, sizeof(g_index));
+}
+
+// 5. 名称索引函数组
+/**
+ * @brief 解码一个UTF-8字符
+ * @return 字符字节数，非法编码返回0
+ */
+static int decodeUtf8(const unsigned char* s, uint32_t* cp) {
+    if (s[0] < 0x80) {
+        *cp = s[0];
+        return s[0] ? 1 : 0;
+    }
+    int length = s[0] >= 0xF0 ? 4 : s[0] >= 0xE0 ? 3 : s[0] >= 0xC0 ? 2 : 0;
+    if (length == 0) return 0;
+
+    uint32_t value = s[0] & (0x7F >> length);
+    for (int i = 1; i < length; i++) {
+        if ((s[i] & 0xC0) != 0x80) return 0;
+        value = (value << 6) | (s[i] & 0x3F);
+    }
+    *cp = value;
+    return length;
+}
+
+/**
+ * @brief 提取名称的一元和二元字符片段键（去重）
+ * @details 一元键为 字符<<32，二元键为 前字符<<32 | 后字符，键值均不为0
+ * @return 键数，名称含非法编码时返回-1
+ */
+static int nameGramKeys(const char* name, uint64_t* keys, int max_keys) {
+    const unsigned char* p = (const unsigned char*)name;
+    uint32_t previous = 0;
+    int count = 0;
+
+    while (*p) {
+        uint32_t cp;
+        int length = decodeUtf8(p, &cp);
+        if (length == 0) return -1;
+        p += length;
+
+        uint64_t grams[2] = { (uint64_t)cp << 32, previous ? ((uint64_t)previous << 32) | cp : 0 };
+        for (int g = 0; g < 2; g++) {
+            int seen = grams[g] == 0;
+            for (int k = 0; k < count && !seen; k++) seen = keys[k] == grams[g];
+            if (!seen && count < max_keys) keys[count++] = grams[g];
+        }
+        previous = cp;
+    }
+    return count;
+}
+
+/**
+ * @brief 区划名称常见的通名后缀，按字节长度从长到短排列
+ * @details 地址中常省略通名（如"石家庄长安区"），去掉后缀的专名不少于两个汉字时也可匹配
+ */
+static const char* const ADDRESS_SUFFIXES[] = {
+    "社区居民委员会", "特别行政区", "街道办事处", "居民委员会", "村民委员会", "社区居委会",
+    "自治区", "自治州", "自治县", "自治旗", "居委会", "村委会",
+    "街道", "地区", "林区", "矿区", "社区", "省", "市", "区", "县", "旗", "盟", "镇", "乡", "村"
+};
+
+/**
+ * @brief 去掉通名后缀后的专名长度（字节），专名不足两个汉字或无通名后缀时返回0
+ */
+static size_t nameStemLength(const char* name, size_t length) {
+    for (size_t s = 0; s < sizeof(ADDRESS_SUFFIXES) / sizeof(ADDRESS_SUFFIXES[0]); s++) {
+        size_t suffix = strlen(ADDRESS_SUFFIXES[s]);
+        if (length <= suffix || memcmp(name + length - suffix, ADDRESS_SUFFIXES[s], suffix) != 0) continue;
+        return length - suffix >= 6 ? length - suffix : 0;
+    }
+    return 0;
+}
+
+static uint64_t hashBytes(const char* bytes, size_t length) {
+    // FNV-1a，置最高位保证键非0；地址解析按同样方式逐字节累加
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (unsigned char)bytes[i]) * 0x100000001b3ULL;
+    }
+    return hash | (1ULL << 63);
+}
+
+static uint64_t hashName(const char* name) {
+    return hashBytes(name, strlen(name));
+}
+
+static int gramKeysOf(const struct TreeNode* node, uint64_t* keys, int max_keys) {
+    int count = nameGramKeys(node->data.name, keys, max_keys);
+    return count < 0 ? 0 : count;
+}
+
+static int exactKeysOf(const struct TreeNode* node, uint64_t* keys, int max_keys) {
+    (void)max_keys;
+    keys[0] = hashName(node->data.name);
+    return 1;
+}
+
+static int addressKeysOf(const struct TreeNode* node, uint64_t* keys, int max_keys) {
+    (void)max_keys;
+    size_t length = strlen(node->data.name);
+    size_t stem = nameStemLength(node->data.name, length);
+    keys[0] = hashBytes(node->data.name, length);
+    if (stem == 0) return 1;
+    keys[1] = hashBytes(node->data.name, stem);
+    return 2;
+}
+
+static int levelKeysOf(const struct TreeNode* node, uint64_t* keys, int max_keys) {
+    (void)max_keys;
+    keys[0] = (uint64_t)node->data.level + 1;
+    return 1;
+}
+
+static int strataKeysOf(const struct TreeNode* node, uint64_t* keys, int max_keys) {
+    (void)max_keys;
+    keys[0] = ((uint64_t)node->data.level + 1) << 32 | (uint32_t)node->data.type;
+    return 1;
+}
+
+static inline uint32_t postingSlot(uint64_t key, uint32_t mask) {
+    return (uint32_t)((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+}
+
+/**
+ * @brief 查找键对应的编号，不存在且insert非0时新建
+ * @return 编号，未找到返回-1
+ */
+static int postingKeyId(struct PostingTable* table, uint64_t key, int insert) {
+    uint32_t slot = postingSlot(key, table->mask);
+    while (table->slots[slot].key != 0) {
+        if (table->slots[slot].key == key) return (int)table->slots[slot].id;
+        slot = (slot + 1) & table->mask;
+    }
+    if (!insert) return -1;
+
+    table->slots[slot].key = key;
+    table->slots[slot].id = table->key_count;
+    return (int)table->key_count++;
+}
+
+static int postingTableGrow(struct PostingTable* table) {
+    uint32_t old_size = table->mask + 1;
+    uint32_t mask = old_size * 2 - 1;
+    struct PostingSlot* slots = calloc(mask + 1, sizeof(struct PostingSlot));
+    if (slots == NULL) return -1;
+
+    for (uint32_t i = 0; i < old_size; i++) {
+        if (table->slots[i].key == 0) continue;
+        uint32_t slot = postingSlot(table->slots[i].key, mask);
+        while (slots[slot].key != 0) slot = (slot + 1) & mask;
+        slots[slot] = table->slots[i];
+    }
+    free(table->slots);
+    table->slots = slots;
+    table->mask = mask;
+    return 0;
+}
+
+/**
+ * @brief 按DFS序构建倒排表：第一遍统计各键的节点数并记下键编号，第二遍按编号分发DFS序号
+ * @details 节点按DFS序处理，每个倒排链天然有序，可直接按子树区间二分截取；
+ *          key_hint为预计不同键数，用于预留哈希槽避免扩容
+ */
+static int buildPostingTable(struct PostingTable* table, struct TreeNode* const* nodes, int count,
+                             int (*keys_of)(const struct TreeNode*, uint64_t*, int), uint32_t key_hint) {
+    uint64_t keys[2 * MAX_NAME_LENGTH];
+    uint32_t* counts = NULL;
+    uint32_t counts_capacity = 0;
+    uint32_t* emitted = NULL;          // 按节点顺序记录的键编号
+    size_t emitted_capacity = 0;
+    uint8_t* per_node = malloc(count > 0 ? count : 1);  // 每个节点的键数
+    size_t total = 0;
+    int result = -1;
+
+    memset(table, 0, sizeof(*table));
+    table->mask = 1023;
+    while (table->mask + 1 < key_hint * 2) table->mask = table->mask * 2 + 1;
+    table->slots = calloc(table->mask + 1, sizeof(struct PostingSlot));
+    if (table->slots == NULL || per_node == NULL) goto cleanup;
+
+    for (int i = 0; i < count; i++) {
+        int n = keys_of(nodes[i], keys, (int)(sizeof(keys) / sizeof(keys[0])));
+        if (total + n > emitted_capacity) {
+            emitted_capacity = emitted_capacity ? emitted_capacity * 2 : (size_t)count * 4 + 64;
+            uint32_t* grown = realloc(emitted, sizeof(uint32_t) * emitted_capacity);
+            if (grown == NULL) goto cleanup;
+            emitted = grown;
+        }
+        per_node[i] = (uint8_t)n;
+
+        for (int k = 0; k < n; k++) {
+            // 装载率超过一半时扩容
+            if ((table->key_count + 1) * 2 > table->mask + 1 && postingTableGrow(table) != 0) goto cleanup;
+            uint32_t id = (uint32_t)postingKeyId(table, keys[k], 1);
+            if (id >= counts_capacity) {
+                uint32_t capacity = counts_capacity ? counts_capacity * 2 : key_hint + 1024;
+                uint32_t* grown = realloc(counts, sizeof(uint32_t) * capacity);
+                if (grown == NULL) goto cleanup;
+                memset(grown + counts_capacity, 0, sizeof(uint32_t) * (capacity - counts_capacity));
+                counts = grown;
+                counts_capacity = capacity;
+            }
+            counts[id]++;
+            emitted[total++] = id;
+        }
+    }
+
+    table->offsets = malloc(sizeof(uint32_t) * (table->key_count + 1));
+    table->postings = malloc(sizeof(int) * (total + 1));
+    if (table->offsets == NULL || table->postings == NULL) goto cleanup;
+    table->offsets[0] = 0;
+    for (uint32_t id = 0; id < table->key_count; id++) {
+        table->offsets[id + 1] = table->offsets[id] + counts[id];
+        counts[id] = table->offsets[id];  // 改作填充游标
+    }
+
+    size_t position = 0;
+    for (int i = 0; i < count; i++) {
+        for (int k = 0; k < per_node[i]; k++) {
+            table->postings[counts[emitted[position++]]++] = i;
+        }
+    }
+    table->posting_count = total;
+    result = 0;
+
+cleanup:
+    free(counts);
+    free(emitted);
+    free(per_node);
+    return result;
+}
+
+static void freePostingTable(struct PostingTable* table) {
+    free(table->slots);
+    free(table->offsets);
+    free(table->postings);
+    memset(table, 0, sizeof(*table));
+}
+
+const int* postingLookup(const struct PostingTable* table, uint64_t key, int* length) {
+    *length = 0;
+    if (table->slots == NULL) return NULL;
+
+    int id = postingKeyId((struct PostingTable*)table, key, 0);
+    if (id < 0) return NULL;
+    *length = (int)(table->offsets[id + 1] - table->offsets[id]);
+    return table->postings + table->offsets[id];
+}
+
+/**
+ * @brief 构建名称前缀位图：每个名称在字符边界上的各个前缀（不少于6字节）置一位
+ * @details 每个节点约占32位，误判率约一成；地址解析逐字延长候选文字时，前缀不在位图中即可停止
+ */
+static int buildPrefixBitmap(const struct RegionIndex* index) {
+    uint64_t bits = 1u << 16;
+    while (bits < (uint64_t)index->count * 32) bits *= 2;
+    g_name_index.prefixes = calloc(bits / 64, sizeof(uint64_t));
+    if (g_name_index.prefixes == NULL) return -1;
+    g_name_index.prefix_mask = bits - 1;
+    g_name_index.longest_name = 0;
+
+    for (int i = 1; i < index->count; i++) {
+        const char* name = index->dfs_nodes[i]->data.name;
+        size_t length = strlen(name);
+        for (size_t end = 6; end <= length; end++) {
+            if (end < length && ((unsigned char)name[end] & 0xC0) == 0x80) continue;
+            uint64_t bit = hashBytes(name, end) & g_name_index.prefix_mask;
+            g_name_index.prefixes[bit / 64] |= 1ULL << (bit % 64);
+        }
+        if (length > g_name_index.longest_name) g_name_index.longest_name = length;
+    }
+    return 0;
+}
+
+static int buildNameTables(void) {
+    const struct RegionIndex* index = &g_index;
+    if (index->root == NULL) return -1;
+    if (buildPostingTable(&g_name_index.grams, index->dfs_nodes, index->count, gramKeysOf, index->count / 2) != 0 ||
+        buildPostingTable(&g_name_index.exact, index->dfs_nodes, index->count, exactKeysOf, index->count) != 0 ||
+        buildPostingTable(&g_name_index.levels, index->dfs_nodes, index->count, levelKeysOf, 16) != 0 ||
+        buildPostingTable(&g_name_index.address, index->dfs_nodes, index->count, addressKeysOf, index->count * 2) != 0 ||
+        buildPostingTable(&g_name_index.strata, index->dfs_nodes, index->count, strataKeysOf, 256) != 0 ||
+        buildPrefixBitmap(index) != 0) {
+        freePostingTable(&g_name_index.grams);
+        freePostingTable(&g_name_index.exact);
+        freePostingTable(&g_name_index.levels);
+        freePostingTable(&g_name_index.address);
+        freePostingTable(&g_name_index.strata);
+        return -1;
+    }
+    __atomic_store_n(&g_name_index.ready, 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+int buildNameIndex(void) {
+    clock_t start = clock();
+
+    freeNameIndex();
+    if (buildNameTables() != 0) {
+        printf("错误：名称索引构建失败\n");
+        return -1;
+    }
+    printf("名称索引构建完成：%u 个字符片段，%u 个不同名称，耗时 %.0f 毫秒\n",
+           g_name_index.grams.key_count, g_name_index.exact.key_count,
+           (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC);
+    return 0;
+}
+
+#ifndef _WIN32
+static void* nameIndexBuilderMain(void* arg) {
+    (void)arg;
+    buildNameTables();
+    // 名称排序与名称索引同在后台构建，各自完成后分别可用；结束时唤醒等待名称排序的请求
+    buildCollation();
+    pthread_mutex_lock(&g_collation_lock);
+    g_collation_building = 0;
+    pthread_cond_broadcast(&g_collation_built);
+    pthread_mutex_unlock(&g_collation_lock);
+    return NULL;
+}
+#endif
+
+/**
+ * @brief 在后台线程构建名称索引
+ * @details 片段表的构建受内存延迟限制（数百毫秒），放到后台不拖慢启动；
+ *          完成前的查询由查询计划退回顺序扫描，结果相同；其后再构建名称排序，
+ *          按名称排序的请求等待其完成，不以其他顺序代替
+ */
+int startNameIndexBuild(void) {
+#ifndef _WIN32
+    freeNameIndex();
+    if (g_index.root == NULL) return -1;
+    g_collation_building = 1;
+    if (pthread_create(&g_name_index.builder, NULL, nameIndexBuilderMain, NULL) == 0) {
+        g_name_index.building = 1;
+        printf("名称索引后台构建中\n");
+        return 0;
+    }
+    g_collation_building = 0;
+#endif
+    return buildNameIndex() == 0 && buildCollation() == 0 ? 0 : -1;
+}
+
+void freeNameIndex(void) {
+#ifndef _WIN32
+    if (g_name_index.building) {
+        pthread_join(g_name_index.builder, NULL);
+        g_name_index.building = 0;
+    }
+#endif
+    g_name_index.ready = 0;
+    freePostingTable(&g_name_index.grams);
+    freePostingTable(&g_name_index.exact);
+    freePostingTable(&g_name_index.levels);
+    freePostingTable(&g_name_index.address);
+    freePostingTable(&g_name_index.strata);
+    free(g_name_index.prefixes);
+    g_name_index.prefixes = NULL;
+    freeCollation();
+}
+
+// 6. 名称排序函数组
+/**
+ * @brief 名称排序键（构建期使用）
+ */
+struct CollationKey {
+    uint64_t prefix;           ///< 排序键前8字节（大端），多数名称比较到此为止
+    uint32_t offset;           ///< 完整排序键在键池中的偏移
+    uint32_t length;
+    int node;                  ///< DFS序号
+};
+
+static const unsigned char* g_collation_pool;  ///< 构建期间供比较函数访问的键池
+
+static int compareCollationKeys(const void* a, const void* b) {
+    const struct CollationKey* x = a;
+    const struct CollationKey* y = b;
+    if (x->prefix != y->prefix) return x->prefix < y->prefix ? -1 : 1;
+    if (x->length > 8 || y->length > 8) {
+        uint32_t common = x->length < y->length ? x->length : y->length;
+        int order = common > 8 ? memcmp(g_collation_pool + x->offset + 8, g_collation_pool + y->offset + 8, common - 8) : 0;
+        if (order != 0) return order;
+    }
+    if (x->length != y->length) return x->length < y->length ? -1 : 1;
+    return (x->node > y->node) - (x->node < y->node);
+}
+
+static int collationSameName(const struct CollationKey* x, const struct CollationKey* y) {
+    return x->prefix == y->prefix && x->length == y->length &&
+           (x->length <= 8 || memcmp(g_collation_pool + x->offset + 8, g_collation_pool + y->offset + 8, x->length - 8) == 0);
+}
+
+/**
+ * @brief 按拼音排好的汉字，字在表中的位置（逐行相接）即其拼音位次
+ * @details 离线生成：取 Unicode::Collate::CJK::Pinyin（CLDR 中文拼音排序规则）数据表中的码位，
+ *          依次写为UTF-8，按首字母分组、每行一个短串。覆盖CJK统一汉字基本区（U+4E00-U+9FA5）中
+ *          CLDR给出读音的20892字及"〇"；没有单字读音的10个合成计量字（兙兡嗧桛烪瓧瓰瓱瓼甅）不在表内，
+ *          退回GBK编码序。按音节、声调排列，同音字的先后与CLDR一致；每字均为三字节UTF-8
+ */
+static const char* const PINYIN_ORDER[] = {
+    // A
+    "阿呵锕嗄啊哎哀唉埃娭挨欸溾嗳銰锿噯鎄啀捱皑溰嘊敱敳皚癌騃毐昹娾矮",
+    "蔼躷濭藹霭靄艾伌爱砹硋隘嗌塧嫒愛碍叆暧瑷閡僾壒嬡懓薆鴱懝曖璦餲皧",
+    "瞹馤礙譪譺鑀靉鱫安侒峖桉氨庵菴谙媕萻葊痷腤鹌蓭誝鞌鞍盦諳馣盫鵪韽",
+    "鶕玵啽雸儑垵俺唵埯铵隌揞罯銨犴岸按洝荌案胺豻堓婩晻暗錌闇鮟黯肮骯",
+    "卬岇昂昻枊盎醠凹柪梎軪爊敖厫隞嗷嗸嶅廒滶獓蔜遨摮熬獒璈磝翱聱螯謷",
+    "謸翺鳌鏖鰲鷔鼇抝芺拗袄镺媪媼襖岙扷坳垇岰傲奡奥奧嫯慠骜隩墺嶴懊澳",
+    "擙鏊驁翶",
+    // B
+    "八仈扒朳玐夿岜芭峇柭疤哵巼捌粑羓蚆釛釟豝鲃叐犮抜坺妭拔茇炦癹胈菝",
+    "詙跋軷颰魃墢鼥把钯鈀靶坝弝爸垻耙跁鲅鲌鮊覇矲霸壩灞欛巴叭吧笆紦罢",
+    "魞罷挀掰擘白百佰柏栢捭瓸粨絔摆擺襬庍拝败拜敗猈稗蛽粺贁韛竡薭扳攽",
+    "班般颁斑搬斒頒瘢鳻螌褩癍辬阪坂岅昄板版瓪钣粄舨鈑蝂魬闆办半伴坢姅",
+    "怑拌绊柈秚湴絆鉡靽辦瓣扮螁邦垹帮捠梆浜邫幇幚縍幫鞤绑綁榜牓膀髈玤",
+    "蚌傍棒棓谤塝搒稖蒡蜯磅镑艕謗鎊勹包孢苞枹胞笣煲龅蕔褒襃闁齙窇嫑雹",
+    "薄宝怉饱保鸨宲珤堡堢媬葆寚飽褓駂鳵緥鴇賲寳寶靌勽报抱豹趵铇菢蚫袌",
+    "報鉋鲍靤骲暴髱虣鮑儤曓爆忁鑤鸔佨藵陂卑杯盃桮悲揹椑禆碑鹎錃藣鵯北",
+    "鉳贝孛狈貝邶备昁牬苝背郥钡俻倍悖狽被偝偹梖珼鄁備僃惫焙琲軰辈愂碚",
+    "蓓犕褙誖鞁骳輩鋇憊糒鞴鐾呗唄禙奔泍贲栟犇锛錛本苯奙畚翉楍坋坌倴捹",
+    "桳渀笨逩撪獖輽伻祊奟崩絣閍傰嵭痭嘣綳甭埄埲绷菶琣琫繃鞛泵迸逬塴甏",
+    "镚蹦鏰蠯揼屄偪毴逼楅豍螕鵖鲾鎞鰏荸鼻匕比夶朼佊吡妣沘疕彼柀秕俾笔",
+    "粃舭啚筆鄙箄聛貏币必毕闭佖坒庇诐邲妼怭怶枈畀苾哔柲毖珌疪荜陛毙狴",
+    "畢笓粊袐铋婢庳敝梐萆閇閉堛弻弼愊愎湢皕筚詖貱賁赑嗶彃滗滭煏痹痺睤",
+    "腷蓖蓽蜌裨跸鉍閟飶幣弊熚獙碧箅箆綼蔽鄪馝潷獘罼駜髲壁嬖廦篦篳縪薜",
+    "觱避鮅斃濞臂蹕髀奰璧鄨鏎饆繴襞襣鞸韠魓躃躄驆贔鐴鷝鷩鼊匂萞幤襅嬶",
+    "边辺砭笾揙猵编煸牑甂箯編蝙邉鍽鳊邊鞭鯾鯿籩贬扁窆匾貶惼萹碥稨褊糄",
+    "鴘藊卞弁匥忭抃汳汴苄釆变玣便変昪覍徧缏遍閞辡緶艑辧辨辩辫辮辯變峅",
+    "炞灬杓标飑骉髟淲彪猋脿颩墂幖摽滮蔈颮骠標熛膘瘭磦镖飙飚儦颷瀌藨謤",
+    "爂臕贆鏢穮镳飆飇飈驃鑣驫表婊裱諘褾錶檦俵鳔鰾飊憋蟞鳖鱉鼈虌龞別别",
+    "咇莂蛂徶襒蹩瘪癟彆汃邠玢砏宾彬梹傧斌椕滨缤槟瑸豩賓賔镔儐濒濱虨豳",
+    "檳璸瀕霦繽鑌顮摈殡膑髩擯鬂殯臏髌鬓髕鬢氞濵冫仌仒氷冰兵掤丙邴陃怲",
+    "抦秉苪昞昺柄炳饼眪窉蛃摒禀稟鈵鉼餅餠鞞并並併幷庰倂栤病竝偋傡寎棅",
+    "誁鮩靐垪鞆鋲癶帗拨波癷玻剝剥哱盋砵袚钵饽紴缽菠袰碆鉢僠嶓撥播餑鮁",
+    "蹳驋鱍仢伯犻肑驳帛狛瓝苩侼勃胉郣亳挬浡瓟秡袯钹铂脖舶袹博渤葧鹁愽",
+    "搏猼鈸鉑馎僰煿牔箔艊蔔馛駁踣鋍镈馞駮襏豰嚗懪礡簙鎛餺鵓犦髆髉欂襮",
+    "礴鑮跛箥簸孹檗糪譒蘗卜啵萡膊峬庯逋晡鈽誧鳪轐醭卟补哺捕喸補鵏不布",
+    "佈吥步咘怖抪歨歩柨钚勏埔埗悑捗荹部钸埠瓿蔀踄郶餔篰餢簿",
+    // C
+    "嚓擦攃礤遪囃偲婇猜才犲材财財裁溨纔毝采倸啋寀彩採睬跴綵踩埰菜棌蔡",
+    "縩参參叄飡骖叅喰湌傪嬠餐驂残蚕惭殘慚蝅慙嬱蠶蠺惨朁慘憯穇篸黪黲灿",
+    "掺孱粲摻澯薒燦璨謲儏爘仓仺伧沧苍鸧倉舱傖嵢滄獊蒼艙螥鶬藏鑶賶濸罉",
+    "欌撡操糙曺曹嘈嶆漕蓸槽褿艚螬鏪艸草愺懆騲肏鄵襙艹冊册侧厕恻拺测敇",
+    "畟側厠笧粣萗廁惻測策萴筞筴蓛墄箣憡簎嵾岑涔笒梣曽噌层曾層嶒竲驓蹭",
+    "叉扠杈肞臿挿偛嗏插揷馇銟锸艖疀鍤餷秅垞查茬茶嵖搽猹靫槎詧察碴檫衩",
+    "蹅镲鑔奼汊岔侘诧姹差紁詫芆拆钗釵侪柴豺祡喍儕齜茝虿袃訍瘥蠆囆辿觇",
+    "梴搀覘裧鉆鋓幨襜攙婵谗棎湹禅馋煘缠僝獑蝉誗鋋儃嬋廛潹潺緾澶磛禪毚",
+    "鄽镡瀍蟬儳劖蟾酁嚵巉瀺欃纏纒躔镵艬讒鑱饞产刬旵丳斺浐剗谄啴產産铲",
+    "阐蒇剷嵼摌滻嘽幝蕆諂閳骣燀簅冁繟譂辴鏟闡囅灛讇忏硟摲懴颤懺羼韂顫",
+    "壥伥昌倀娼淐猖菖阊晿琩裮锠錩閶鲳鯧鼚仧兏肠苌镸尝偿常徜瓺萇甞腸嘗",
+    "塲嫦瑺膓鋿償嚐鲿鏛鱨厂场昶惝場僘厰廠氅鋹怅玚畅倡鬯唱悵焻瑒暢畼誯",
+    "韔敞椙蟐抄弨怊欩钞訬焯超鈔勦牊晁巢巣朝鄛鼌漅嘲樔潮窲罺轈鼂謿吵炒",
+    "眧焣煼麨巐仦仯耖觘车伡車俥砗唓莗硨蛼扯偖撦屮彻坼迠烢聅掣硩頙徹撤",
+    "澈勶瞮爡抻郴捵琛嗔綝瞋諃賝縝謓尘臣忱沈沉辰陈迧茞宸莀莐陳敐訦谌軙",
+    "愖揨鈂煁蔯塵樄瘎霃螴諶薼麎曟鷐趻硶碜墋夦磣踸鍖贂醦衬疢龀趁趂榇齓",
+    "儬齔儭嚫谶櫬襯讖烥晨阷泟柽爯棦浾琤称偁蛏湞牚赪僜憆摚稱靗撐撑緽橕",
+    "瞠赬頳檉竀穪蟶鏳鏿饓丞成朾呈承枨诚郕乗城娍宬峸洆荿乘埕挰晟珹脀掁",
+    "珵碀窚脭铖堘惩棖椉程筬絾裎塍塖溗誠畻酲鋮憕澂澄橙檙瀓懲騬侱徎悜逞",
+    "骋庱睈騁秤鯎吃侙哧彨胵蚩鸱瓻眵笞喫訵嗤媸摛痴絺噄瞝誺螭鴟癡魑齝彲",
+    "黐弛池驰迟坻岻茌持竾荎歭蚳赿筂貾遅趍遟馳箎墀漦踟遲篪謘尺叺呎侈卶",
+    "齿垑胣恥粎耻蚇袳欼歯袲裭鉹褫齒彳叱斥杘灻赤饬抶勅恜炽勑翄翅敕烾痓",
+    "啻湁硳飭傺痸腟跮鉓雴憏瘈翤遫銐慗瘛翨熾懘趩饎鶒鷘妛麶充冲忡沖茺浺",
+    "珫翀舂嘃摏徸憃憧衝罿艟蹖虫崇崈隀褈緟蝩蟲爞宠埫寵铳揰銃抽婤搊瘳篘",
+    "犨犫仇怞俦帱栦惆紬绸菗椆畴絒愁皗稠筹裯酧綢踌儔雔嚋嬦幬懤薵燽雠疇",
+    "籌躊醻讎讐丑丒吜杻杽侴偢瞅醜矁魗臭臰遚殠酬出岀初摴樗貙齣刍除芻厨",
+    "滁蒢豠锄媰耡蒭蜍趎鉏雏犓蕏廚篨鋤橱幮櫉藸躇雛櫥蹰鶵躕処杵础椘储楮",
+    "褚濋儲檚礎齭鸀齼亍处竌怵拀绌豖柷欪竐俶敊畜埱珿絀處傗琡鄐搐滀蓫触",
+    "踀閦儊嘼諔憷斶歜臅黜觸矗楚榋橻璴蟵欻歘揣搋膗啜嘬膪踹巛川氚穿剶猭",
+    "瑏伝传舡舩船圌遄傳椽暷篅輲舛荈喘歂僢踳汌串玔钏釧賗鶨刅疮窓窗牎摐",
+    "牕瘡窻床牀噇幢闯傸摤磢闖创怆刱剏剙凔創愴吹炊垂倕埀陲捶菙搥棰椎腄",
+    "槌锤箠錘鎚顀龡旾杶春萅堾媋暙椿瑃箺蝽橁輴膥櫄鰆鶞纯陙唇浱純莼淳脣",
+    "湻犉滣蒓漘蓴醇醕錞鯙偆萶惷睶賰蠢鹑鶉逴踔戳辶辵娕娖婼惙涰绰腏辍酫",
+    "綽趠輟龊擉磭繛歠嚽齪鑡呲疵赼趀偨跐縒骴髊蠀齹词珁垐柌祠茈茨堲瓷詞",
+    "辝慈甆辞磁雌鹚糍辤飺餈嬨濨薋鴜礠辭鶿鷀此佌泚玼皉紪鮆朿次伺佽刺刾",
+    "庛茦栨莿絘蛓赐螆賜匆囪囱苁忩枞怱悤棇焧葱漗聡蓯蔥骢暰樅樬熜瑽璁緫",
+    "聦聪燪瞛篵聰蟌鍯繱鏦騘驄从丛従婃孮徖從悰淙琮慒漎潀潨誴賨賩樷藂叢",
+    "灇欉爜憁謥茐凑湊腠辏輳粗觕麁麄麤徂殂促猝脨酢瘄蔟誎趗噈憱踧醋瘯簇",
+    "縬蹙鼀蹴蹵顣汆撺鋑镩蹿攛躥鑹櫕巑欑穳窜殩熶篡簒竄爨崔催凗缞墔嶉慛",
+    "摧榱獕槯磪縗鏙漼璀趡皠伜忰疩倅粋紣翆脃脆啐啛悴淬萃毳焠脺瘁粹綷翠",
+    "膵膬濢竁襊顇臎乼邨村皴踆澊竴存侟拵刌忖寸吋籿搓瑳遳磋撮蹉醝虘嵯嵳",
+    "痤睉矬蒫蔖鹾酂鹺躦脞剉剒厝夎挫莝莡措逪斮棤锉蓌错歵銼錯",
+    // D
+    "咑哒耷荅笚嗒搭褡噠撘鎝达迖呾妲怛沓炟羍荙畗剳匒畣笪逹答詚達阘靼薘",
+    "鞑蟽鎉躂鐽韃龖龘打大汏眔垯瘩墶燵繨呆呔獃懛歹逮傣代轪垈岱帒甙绐迨",
+    "骀带待怠柋殆玳贷帯軑埭帶紿袋軚貸軩瑇廗叇曃緿鴏戴艜黛簤蹛瀻霴襶黱",
+    "靆鮘丹妉单担単眈砃耼耽郸聃躭單媅殚瘅匰箪褝鄲頕儋勯擔殫甔癉襌簞聸",
+    "伔刐抌玬瓭胆衴疸紞掸赕亶撢撣澸黕膽黮旦但帎沊狚诞柦疍啖啗弹惮淡萏",
+    "蛋啿弾氮腅蜑觛窞誕僤噉馾髧嘾彈憚憺暺澹禫蓞駳鴠癚嚪繵贉霮饏泹当珰",
+    "裆筜當噹澢璫襠簹艡蟷挡党谠擋譡黨攩灙欓讜氹凼圵宕砀垱荡档菪婸愓瓽",
+    "逿嵣雼潒碭儅瞊蕩趤壋檔璗盪礑簜蘯闣铛鐺刀刂叨忉朷氘舠釖鱽魛捯导岛",
+    "島捣祷禂搗隝嶋嶌導隯壔嶹擣蹈禱到倒悼焘盗菿盜道稲箌翢噵稻衜檤衟燾",
+    "翿軇瓙纛屶陦椡槝嘚恴淂惪棏锝徳德鍀地的得脦扥扽灯登豋噔嬁燈璒竳簦",
+    "覴蹬朩等戥邓凳鄧隥墱嶝瞪磴镫櫈鐙艠氐仾低奃彽袛羝隄堤趆滴樀镝磾鍉",
+    "鞮廸狄籴苖迪唙敌涤荻梑笛觌靮滌馰髢嘀嫡翟蔋蔐頔敵篴嚁藡豴蹢鬄鏑糴",
+    "覿鸐厎坘诋邸阺呧底弤抵拞茋柢牴砥埞掋菧觝詆軧聜骶坔弟旳杕玓怟俤帝",
+    "埊娣递逓偙啇啲梊焍珶眱祶第菂谛釱媂棣渧睇缔蒂僀禘腣遞鉪墑墬摕碲蔕",
+    "蝃遰慸甋締嶳諦踶螮鯳嗲甸敁掂傎厧嵮滇槇槙瘨颠蹎巅顚顛癫巓巔攧癲齻",
+    "典奌点婰猠敟跕碘蒧蕇踮點嚸电佃阽坫店垫扂玷钿婝惦淀奠琔殿蜔電墊壂",
+    "橂橝澱靛癜簟驔椣刁叼汈虭凋奝弴彫蛁琱貂碉鳭殦瞗雕鮉鲷鼦鯛鵰扚屌弔",
+    "伄吊钓窎訋调掉釣铞铫竨蓧銱雿魡調瘹窵鋽藋鑃簓爹跌褺苵迭垤峌恎挕昳",
+    "绖胅瓞眣戜谍喋堞惵揲畳絰耋臷詄趃镻叠殜牃牒嵽碟蜨褋艓蝶諜蹀鲽曡疉",
+    "鰈疊氎哋耊眰幉疂丁仃叮帄玎疔盯钉耵虰酊釘靪奵顶頂鼎嵿鼑濎薡鐤订忊",
+    "饤矴定訂飣啶铤椗腚碇锭碠蝊鋌錠磸顁萣聢丟丢铥銩东冬咚岽東苳昸氡倲",
+    "鸫埬娻崠崬涷笗菄徚氭蝀鴤鼕鯟鶇董墥嬞懂箽蕫諌动冻侗垌姛峒恫挏栋洞",
+    "胨迵凍戙胴動硐棟湩絧腖働駧霘鮗鶫吺唗都兜兠蔸橷篼阧抖枓枡陡唞蚪鈄",
+    "斗豆郖浢荳逗饾鬥梪毭脰酘痘閗窦鬦餖斣闘竇鬪鬭鬬乧艔厾剢阇嘟督醏闍",
+    "毒独涜读渎椟牍犊碡裻読蝳獨錖凟匵嬻瀆櫝殰牘犢瓄皾騳黩讀豄贕韣髑鑟",
+    "韇韥黷讟笃堵帾琽赌睹覩賭篤芏妒杜肚妬度荰秺渡靯镀螙殬鍍簵蠧蠹耑偳",
+    "剬媏端褍鍴短段断塅缎葮椴煅瑖腶碫锻緞毈簖鍛斷躖籪襨垖堆塠嵟痽磓鴭",
+    "鐜頧队对兊兌兑対祋怼陮隊碓綐對憞憝濧薱镦懟瀩譈鐓吨惇敦蜳墩墪撴獤",
+    "噸撉橔犜礅蹲蹾驐盹趸躉伅囤庉沌炖盾砘逇钝顿遁鈍楯頓遯潡燉踲碷多夛",
+    "咄哆畓剟崜掇敠毲裰嚉夺铎剫敓敚喥悳敪痥鈬奪凙踱鮵鐸朶哚垛垜挅挆埵",
+    "缍椯趓躱躲憜綞亸鍺軃嚲奲刴剁陊陏饳尮柁柮炨桗堕舵惰跢跥跺飿墮嶞墯",
+    "鵽朵枤",
+    // E
+    "妸妿娿婀屙钶痾讹吪囮迗俄娥峨峩涐莪珴訛皒睋鈋锇鹅蛾磀誐頟额魤隲額",
+    "鵝鵞譌鰪枙砈頋噁騀厄屵戹歺岋阨呃扼苊阸呝砐轭咢咹垩姶峉匎恶砨蚅饿",
+    "偔卾堊悪掠略硆谔軛鄂阏堮崿惡愕湂萼豟軶遌遏鈪廅搤搹琧腭詻僫蝁锷魥",
+    "鹗蕚頞颚餓噩覨諤閼餩貖鍔鳄歞顎礘櫮鰐鶚讍齃鑩齶鱷擜鵈诶誒奀恩蒽煾",
+    "峎摁鞥儿而児侕兒陑峏洏荋栭胹唲袻鸸粫聏輀鲕隭髵鮞鴯轜厼尒尓尔耳迩",
+    "洱饵栮毦珥铒爾餌駬薾邇趰二弍弐佴刵咡贰貮衈貳誀鉺樲",
+    // F
+    "发沷発傠發酦彂醱乏伐姂垡浌疺罚茷阀栰砝筏瞂罰閥罸橃藅佱法灋珐琺髪",
+    "蕟髮鍅帆訉番勫噃嬏幡憣蕃旙旛繙翻藩轓颿籓飜鱕凡凢凣忛杋柉矾籵钒烦",
+    "舧笲棥渢煩緐墦樊橎燔璠膰薠繁襎羳蹯瀪瀿礬蘩鐇鐢蠜鷭反払返釩氾犯奿",
+    "汎泛饭范贩畈軓婏梵盕笵販軬飯飰滼嬎範舤匚方邡汸芳枋牥钫淓蚄鈁鴋防",
+    "妨房肪埅鲂魴鰟仿访彷纺昉昘瓬眆倣旊紡舫訪髣鶭放趽坊堏錺飞妃非飛啡",
+    "婓渄绯菲扉猆靟裶緋蜚霏鲱餥馡騑騛飝肥淝腓蜰蟦朏匪诽奜悱斐棐榧翡蕜",
+    "誹篚吠芾废杮沸狒肺昲胇费俷剕厞疿陫屝萉廃費痱镄廢曊癈鼣濷櫠鯡鐨靅",
+    "婔暃分吩帉纷芬昐氛哛衯兺紛翂兝棻訜酚鈖雰朆燓餴饙坟妢岎汾朌枌炃肦",
+    "羒蚠蚡梤棼焚蒶馚隫墳幩濆蕡魵橨燌豮鼢羵鼖豶轒鐼馩黂粉黺份弅奋忿秎",
+    "偾愤粪僨憤奮膹糞鲼瀵鱝竕躮丰风仹凨凬妦沣沨凮枫封疯盽砜風峯峰偑桻",
+    "烽崶猦葑锋楓犎蜂瘋碸僼篈鄷鋒檒闏豐鏠酆寷灃蘴霻蠭靊飌麷冯夆捀浲逢",
+    "堸馮摓漨綘艂讽覂唪諷凤奉甮俸湗焨煈缝赗鳯鳳鴌縫賵琒溄鎽蘕覅仏坲梻",
+    "紑裦缶否妚缹缻殕雬鴀伕邞呋妋姇玞肤怤柎砆荂衭垺娐尃荴旉紨趺麸痡稃",
+    "跗鈇筟綒鄜孵豧敷膚鳺麩糐麬麱懯乀巿弗伏凫甶佛冹刜孚扶芙芣咈岪彿怫",
+    "拂服枎泭绂绋苻茀俘垘柫氟洑炥玸畉畐祓罘茯郛韨哹栿浮砩莩蚨匐桴涪烰",
+    "琈符笰紱紼翇艴菔虙幅棴絥罦葍福粰綍艀蜉辐鉘鉜颫鳧榑稪箙韍幞澓蝠髴",
+    "鴔諨踾輻鮄癁襆黻鵩鶝呒抚乶府弣拊斧俌俛胕郙鳬俯釜釡捬辅焤盙腑滏蜅",
+    "腐輔嘸撨撫頫鬴簠黼阝父讣付妇负附坿竎阜驸复峊祔訃負赴蚥袝陚偩冨副",
+    "婦蚹媍富復秿萯蛗詂赋圑椱缚腹鲋複褔赙緮蕧蝜蝮賦駙嬔縛輹鮒賻鍑鍢鳆",
+    "覆馥鰒夫甫咐袱酜傅椨覄禣鮲",
+    // G
+    "旮呷嘎嘠钆尜噶錷尕玍尬魀侅该郂陔垓姟峐荄晐赅畡祴絯該豥賅忋改絠丐",
+    "乢匃匄阣杚钙盖摡溉葢鈣隑戤概槩蓋賌漑槪瓂甘忓芉迀攼杆玕肝坩泔矸苷",
+    "乹柑竿疳酐乾粓亁凲尲尴筸漧鳱尶尷魐仠扞皯秆衦赶敢桿笴稈感澉趕橄擀",
+    "簳鰔鳡鱤干旰汵盰绀倝凎淦紺詌骭幹榦檊贑赣贛灨冈罓冮刚杠纲肛岡牨疘",
+    "矼缸钢剛罡堈掆釭棡犅堽綱罁鋼鎠岗崗港焵筻槓戅戆皋羔羙高皐髙臯滜槔",
+    "睾膏槹橰篙糕餻櫜鷎鼛鷱夰杲菒搞缟暠槀槁稾稿镐縞藁檺藳吿告勂叝诰郜",
+    "祮祰锆煰筶禞誥鋯韟戈仡圪犵纥戓肐牫疙咯牱哥胳袼鸽割搁滒戨歌鴐鴚擱",
+    "謌鴿鎶呄佮匌挌茖阁革敋格鬲愅臵葛蛒裓隔嗝塥滆觡搿槅膈閣閤獦镉鞈韐",
+    "骼諽輵鮯韚轕鞷騔哿舸个各虼個硌铬嗰箇彁櫊给給根跟哏艮亘亙茛揯刯庚",
+    "畊浭耕菮搄焿絚赓鹒緪縆羮賡羹鶊郠哽埂峺挭绠耿莄梗綆鲠骾鯁更堩暅掶",
+    "椩工弓公厷功攻杛供玜糼肱宫宮恭躬龚匑塨幊愩觥躳熕碽髸觵龏龔廾巩汞",
+    "拱拲栱珙輁鋛鞏共贡羾唝貢莻蚣慐勾佝沟钩袧缑鈎溝鉤緱褠篝鞲韝芶岣狗",
+    "苟枸玽耇耉笱耈蚼豿坸构诟购垢姤茩冓够夠訽媾彀搆詬遘雊構煹觏撀覯購",
+    "估呱姑孤沽泒苽柧轱唂罛鸪笟菰蛄觚軱軲辜酤鈲箍箛嫴橭鮕鴣鶻夃古扢汩",
+    "诂谷股牯骨唃罟羖钴啒淈脵蛊蛌尳愲蓇詁馉鹄榾毂鈷鼓鼔嘏榖皷鹘穀縎糓",
+    "薣濲皼臌轂餶瀔盬瞽蠱固故凅顾堌崓崮梏牿棝祻雇痼稒锢僱錮鲴鯝顧咕峠",
+    "逧傦菇篐瓜刮胍栝鸹歄煱聒趏劀緺踻銽颳鴰騧冎叧剐剮寡卦坬诖挂啩掛罣",
+    "絓罫褂詿颪乖掴摑拐枴柺箉夬叏怪恠关观官冠覌倌棺蒄窤関瘝癏観闗鳏關",
+    "鰥觀鱞莞馆琯痯筦管輨舘錧館鳤毌丱贯泴悺惯掼涫貫悹祼慣摜潅遦樌盥罆",
+    "雚鏆灌爟瓘矔礶鹳罐鑵鱹鸛光灮侊炗炛咣垙姯洸茪桄烡胱僙輄銧黆广広犷",
+    "廣獷臩俇珖逛臦撗炚欟归圭妫龟规邽皈茥闺帰珪胿亀傀硅窐袿規媯廆椝瑰",
+    "郌嫢摫閨鲑嬀槻槼螝璝膭鮭龜巂歸鬶騩瓌鬹櫷宄氿朹轨庋佹匦诡陒垝姽恑",
+    "攱癸軌鬼庪祪匭晷湀蛫觤詭厬瞡簋蟡攰刽刿昋柜炔贵桂桧猤筀貴蓕跪匱劊",
+    "劌嶡撌槶檜瞶禬簂櫃癐襘鳜鞼鱖鱥椢丨衮惃绲袞袬辊滚蓘滾緄蔉磙輥鲧鮌",
+    "鯀棍睔睴璭謴呙咼埚郭堝崞鈛锅墎瘑嘓彉濄蝈鍋彍蟈囯囶囻国圀國帼腘幗",
+    "慖漍聝蔮膕虢馘果惈淉猓菓馃椁槨粿綶蜾裹輠錁餜鐹过過啯",
+    // H
+    "哈铪蛤奤丷咍咳嗨还孩頦骸還海胲烸酼醢亥妎骇害氦嗐餀駭饚塰嚡佄炶顸",
+    "蚶酣頇嫨谽憨馠歛鼾邗含邯函咁肣凾虷唅圅娢浛崡晗梒涵焓琀寒嵅韩甝筨",
+    "蜬澏鋡魽韓丆厈罕浫喊蔊阚豃鬫汉屽汗闬旱岾哻垾悍捍涆猂莟晘晥焊菡釬",
+    "閈皔睅傼蛿颔馯撖漢蜭貋暵熯銲鋎憾撼翰螒頷顄駻譀雗瀚蘫鶾兯爳夯苀迒",
+    "斻杭绗珩笐航蚢颃貥筕絎頏魧沆垳茠蒿嚆薅薧毜蚝毫椃嗥獆貉噑獔豪嘷獋",
+    "諕儫嚎壕濠籇蠔譹好郝号昊昦秏哠峼恏悎浩耗晧淏傐皓鄗滈聕號暤暭澔皜",
+    "皞曍皡薃皥鎬颢灏顥鰝灝竓诃抲欱喝訶嗬蠚禾合何劾厒咊和姀河郃峆曷柇",
+    "狢盇籺紇阂饸哬敆核盉盍荷啝涸渮盒秴菏萂蚵龁惒訸颌楁毼澕詥貈輅鉌阖",
+    "鲄熆鹖麧頜篕翮螛魺礉闔鞨齕覈鶡皬鑉龢佫垎贺袔焃賀嗃煂碋熇褐赫鹤穒",
+    "翯壑癋謞爀鶮鶴靎鸖靏粭靍黒黑嘿潶拫痕鞎佷很狠詪恨亨哼悙啈脝姮恆恒",
+    "桁烆胻鸻横橫衡鴴蘅鑅堼涥鵆噷叿吽呍灴轰哄訇烘軣揈渹焢硡谾薨輷嚝鍧",
+    "轟仜弘妅红吰宏汯玒纮闳宖泓苰垬娂洪竑紅荭虹峵浤紘翃耾硔紭谹鸿渱竤",
+    "粠葒葓鈜閎綋翝谼潂鉷鞃魟鋐彋蕻霐黉霟鴻黌晎嗊讧訌閧撔澋澒銾闂鬨齁",
+    "侯矦鄇喉帿猴葔瘊睺篌糇翭骺翵鍭餱鯸吼犼后郈厚垕後洉逅堠豞鲎鲘鮜鱟",
+    "候乯匢虍呼垀忽昒曶泘苸恗烀轷匫唿惚淴虖軤嘑寣滹雐幠戯歑膴謼囫抇弧",
+    "狐瓳胡壶隺壷斛焀喖壺媩搰湖猢絗葫楜煳瑚嘝蔛鹕槲箶蝴衚魱縠螜醐頶觳",
+    "鍸餬鵠瀫鬍鰗鶘鶦乕汻虎浒俿萀琥虝滸乥互弖戶户戸冱冴芐帍护沍沪岵怙",
+    "戽昈枑怘祜笏婟扈瓠楛嗀綔鄠雽嫭嫮摢滬蔰槴熩鳸簄鍙嚛鹱護鳠韄頀鱯鸌",
+    "乎粐唬糊錿鯱花芲哗嘩蒊錵华姡骅華釪釫铧滑猾搳撶磆蕐螖鋘譁鏵驊鷨化",
+    "划夻杹画话崋桦婳畫嬅畵觟話劃摦樺嫿槬澅諣黊繣舙譮埖婲椛硴糀璍誮怀",
+    "徊淮槐褢踝懐褱懷瀤櫰耲蘹坏咶諙壊壞蘾犿歓鴅鵍酄嚾懽獾讙貛驩环郇峘",
+    "洹狟荁桓萈萑寏絙雈綄羦貆鉮锾圜嬛寰澴缳阛環豲鍰镮鹮糫繯轘鐶闤鬟瓛",
+    "缓緩攌幻奂肒奐宦唤换浣涣烉患梙焕逭喚喛嵈愌換渙痪睆煥瑍豢漶瘓槵鲩",
+    "擐澣藧鯇鰀欢瞣歡巟肓荒衁朚塃慌皇偟凰隍黄喤堭媓崲徨惶湟葟遑黃楻煌",
+    "瑝墴潢獚锽熿璜篁篊艎蝗癀磺穔諻簧蟥鍠餭鳇趪韹鐄騜兤鰉鱑鷬怳恍炾宺",
+    "晄奛谎幌詤熀謊櫎愰滉榥曂皝鎤皩晃縨灰诙咴恢拻挥洃虺袆晖烣珲豗婎媈",
+    "揮翚辉隓暉楎煇禈詼幑睳褘噅撝噕翬輝麾徽隳瀈蘳鰴囘回囬佪廻廽恛洄茴",
+    "迴烠蚘逥痐蛔蛕蜖鮰悔毀毁毇檓燬譭卉汇会讳泋哕浍绘芔荟诲恚恵烩贿彗",
+    "晦秽喙惠湏絵缋翙阓匯彙彚會滙詯賄颒僡嘒瘣蔧誨圚寭慧憓暳槥潓蕙噦嬒",
+    "徻橞殨澮濊獩薈薉諱頮燴璯篲藱餯嚖瞺穢繢蟪櫘繪翽譓儶鏸闠孈鐬靧譿顪",
+    "屷灳璤懳昏昬荤婚惛涽阍棔殙葷睧睯閽忶浑梡馄堚渾琿魂餛繉轋鼲鯶诨俒",
+    "倱圂掍混焝溷慁觨諢吙剨耠锪劐嚄鍃豁攉騞佸活秮秳火伙邩钬鈥漷夥沎或",
+    "货咟砉俰捇眓获閄掝祸貨惑旤楇湱禍蒦奯濩獲霍檴謋矆穫镬嚯瀖耯艧藿蠖",
+    "嚿曤臛癨矐鑊靃",
+    // J
+    "丌讥击刉叽饥乩刏圾机玑肌芨矶鸡枅咭姫迹剞唧姬屐积笄飢基绩喞嵆嵇敧",
+    "朞犄筓缉赍勣嗘畸稘跡跻鳮僟毄箕銈嘰槣畿稽緝觭賫躸齑墼機激璣禨積襀",
+    "錤隮擊磯簊績羁賷鄿櫅耭蹟雞譏韲鶏譤鐖饑躋鞿鷄齎羇虀鑇覉鑙齏羈鸄覊",
+    "亼及伋吉岌彶忣汲级即极皀亟佶诘郆钑卽姞急狤皍笈級揤疾脊觙偮卙庴焏",
+    "谻戢棘極殛湒集塉嫉愱楫蒺趌槉禝耤膌銡嶯撃潗濈瘠箿蕀蕺踖鹡橶檝螏擮",
+    "藉襋蹐鍓艥籍轚鏶霵鶺鷑雦雧几己丮妀犱泲虮挤掎鱾幾戟鈘嵴麂魢撠擠穖",
+    "蟣魕彐彑旡计记伎纪坖妓忌技芰际剂季哜垍峜既洎济紀茍茤荠計剤紒继觊",
+    "記偈寂寄徛悸旣梞済祭塈惎臮葪蔇兾痵継蓟裚褀際鬾暨漃漈稩穊誋跽霁鲚",
+    "暩稷諅鲫冀劑曁穄薊髻嚌檕濟繋罽薺覬檵鵋齌懻癠穧蘎骥鯚瀱繼蘮鱀蘻霽",
+    "鰶鰿鱭驥亽辑樭輯廭癪加乫夹伽夾抸佳拁泇茄迦枷毠浃珈埉家浹痂梜笳耞",
+    "袈傢猳葭跏犌腵鉫嘉鉿镓豭貑鎵麚圿忦扴郏荚郟唊恝莢戛袷铗戞蛱裌颊蛺",
+    "跲鞂餄鋏頬頰鴶鵊甲仮岬叚玾胛斚贾钾假婽徦斝椵賈鉀榎槚瘕檟价驾架嫁",
+    "幏榢價駕稼糘戋奸尖幵坚歼间冿戔玪肩艰姦姧兼监偂堅惤猏笺菅菺豜湔牋",
+    "犍缄葌間搛椷椾煎瑊睷碊缣蒹豣監箋樫熞緘蕑蕳鲣鳽鹣熸篯縑艱鞬餰馢麉",
+    "瀐鞯鳒礛覸鵳瀸鐧櫼殲鶼韀鰹囏虃鑯韉囝拣枧俭柬茧倹挸捡笕减剪梘检湕",
+    "趼堿揀揃検減睑硷裥詃锏弿暕瑐筧简絸谫戩戬碱儉翦撿檢藆襇襉謇蹇瞼礆",
+    "簡繭謭鬋鰎鹸瀽蠒鐗劗鹻籛譾襺鹼见件見建饯剑洊牮荐贱俴健剣栫涧珔舰",
+    "剱徤渐袸谏釼寋旔楗毽溅腱臶葥践賎鉴键僭榗漸蔪劍劎澗箭糋諓賤趝踐踺",
+    "劒劔薦諫鋻鍵餞瞷磵螹鍳擶濺繝瀳覵鏩艦譼轞鐱鑑鑒鑬鑳彅墹橺礀殱江姜",
+    "将茳浆畕豇將葁畺摪翞僵漿螀壃缰薑橿殭螿鳉疅礓疆繮韁鱂讲奖桨傋蒋奨",
+    "奬蔣槳獎耩膙講顜匞夅弜降洚绛弶袶絳酱勥滰嵹摾彊犟糡醤糨醬謽匠杢櫤",
+    "艽芁交郊姣娇峧浇茭茮骄胶椒焦蛟跤僬嘄虠鲛嬌嶕嶣憍澆膠蕉燋膲礁穚鮫",
+    "鵁鹪簥蟭轇鐎鷍驕鷦鷮臫角佼侥恔挢狡绞饺捁晈烄皎矫脚铰搅湫絞剿敫湬",
+    "煍腳賋僥摷暞踋鉸餃儌劋徺撟撹隦徼憿敽敿燞缴曒璬矯皦蟜繳譑孂攪灚鱎",
+    "叫呌峤挍訆珓窌轿较敎教窖滘較嘂嘦斠漖酵噍嶠潐噭嬓獥藠趭轎醮譥皭釂",
+    "鵤櫵纐阶疖皆接掲痎秸菨階喈嗟堦媘嫅揭椄湝脻街煯稭擑蝔癤謯鶛卩卪孑",
+    "尐节讦刦刧劫岊昅刼劼杰疌衱拮洁结迼倢桀莭訐偼婕崨捷袺傑喼結絜颉嵥",
+    "楬楶滐睫節蜐蝍詰鉣魝截榤碣竭蓵鲒潔羯誱踕鞊幯鍻鮚巀櫭蠞蠘蠽毑媎解",
+    "觧飷檞丯介吤岕庎戒芥屆届玠界畍疥砎衸诫借悈蚧徣堺楐琾蛶骱犗誡褯魪",
+    "鎅躤姐桝巾今斤钅兓金津矜荕衿觔埐珒紟惍堻筋釿嶜鹶黅襟仅尽侭卺巹紧",
+    "堇菫僅厪谨锦嫤廑漌盡緊蓳馑槿瑾儘錦謹饉伒劤劲妗近进枃勁浕荩晉晋浸",
+    "烬赆唫琎祲進寖搢溍禁缙靳墐暜瑨僸凚歏殣璡觐噤濅縉賮嚍嬧濜藎燼璶覲",
+    "贐齽釒砛琻壗坕坙巠京泾经茎亰秔荆荊涇莖婛惊旌旍猄経菁晶稉腈葏粳經",
+    "兢精聙鲸鵛鯨鶁鶄麖鼱驚麠井丼阱刭坓宑汫汬肼剄穽颈景儆頚幜憬憼暻燛",
+    "璟璥頸蟼警妌净弪径迳俓婙浄胫倞凈弳徑痉竞逕婧桱梷淨竫脛竟敬痙竧靓",
+    "傹靖境獍誩踁静靚曔镜靜濪瀞鏡競竸睛橸燝冂冋坰扃埛絅駉駫蘏蘔冏囧泂",
+    "炅迥侰炯逈浻烱煚窘颎綗僒煛熲澃褧丩勼纠朻牞究糺鸠糾赳阄萛啾揂揪揫",
+    "鳩摎樛鬏鬮九久乆乣奺灸玖舏韭紤酒镹韮匛旧臼咎疚柩柾倃捄桕匓厩救媨",
+    "就廄廐舅僦廏慦殧舊鹫匶鯦麔齨鷲汣杦欍凥刟抅匊居拘泃狙苴驹挶疽痀眗",
+    "砠罝陱娵婮崌掬梮涺菹椐琚腒趄跔锔裾雎艍蜛踘踙鋦駒鮈鴡鞠鞫鶋局泦侷",
+    "狊桔毩啹婅淗焗菊郹椈毱湨犑輂僪粷跼閰諊趜躹橘檋駶鵙蹫鵴巈蘜鶪鼳驧",
+    "咀弆沮举莒挙椇筥榉榘蒟龃聥舉踽擧櫸齟欅巨句乬巪讵姖岠怇拒洰苣邭具",
+    "怐怚拠昛歫炬秬钜俱倨倶冣剧粔耟蚷袓埧埾惧据詎距犋跙鉅飓虡豦锯寠愳",
+    "窭聚駏劇勮屦踞鮔壉懅據澽窶遽鋸屨颶貗簴躆醵懼鐻矩爠襷姢娟捐涓焆瓹",
+    "脧裐鹃勬镌鎸鵑鐫蠲卷呟帣埍捲菤锩臇錈奆劵巻倦勌桊狷绢隽淃眷鄄睊絭",
+    "罥雋睠絹飬慻蔨餋獧縳羂噘撅撧屩蹻亅孒孓决刔氒诀弡抉決芵泬玦玨挗珏",
+    "疦砄绝虳觉倔捔欮蚗崛掘斍桷殌覐觖訣赽趹逫傕厥焳絕絶覚趉鈌劂勪瑴谲",
+    "駃嶥憰熦爴獗瘚蕝蕨鴂鴃噱憠橛橜爵臄镢蟨蟩屫爑譎蹶蹷鶌匷嚼矍覺鐍鐝",
+    "爝觼彏戄攫玃鷢欔矡龣貜躩钁军君均汮姰袀軍钧莙蚐桾皲菌鈞碅皸皹覠銁",
+    "銞鲪麇鍕鮶麏麕呁俊郡陖埈峻捃浚馂骏晙焌珺棞畯竣儁箘箟蜠寯懏餕燇濬",
+    "駿鵔鵘攈攟",
+    // K
+    "咔咖喀衉擖卡佧胩鉲垰裃开奒揩锎開鐦凯剀垲恺闿铠凱剴嘅慨蒈塏嵦愷楷",
+    "輆暟锴鍇鎧闓颽忾炌炏欬烗勓愒愾鎎刊栞勘龛堪嵁戡龕冚坎侃砍莰偘埳惂",
+    "欿塪歁槛輡檻顑竷轗看衎崁墈瞰磡闞矙忼闶砊粇康嫝嵻慷漮槺穅糠躿鏮鱇",
+    "扛摃亢伉匟邟囥抗犺炕钪鈧閌尻髛丂攷考拷洘栲烤稁鲓燺铐犒銬靠鮳鯌匼",
+    "苛柯牁珂科胢轲疴砢趷棵萪軻颏嗑搕犐稞窠鈳榼薖颗樖瞌磕蝌錒醘顆髁礚",
+    "壳揢殼翗可坷岢炣渇嵑敤渴嶱礍克刻剋勀勊客恪娔尅课堁氪骒缂愙溘锞碦",
+    "緙艐課礊騍嵙肎肯肻垦恳啃豤龈墾錹懇齦掯裉褃劥阬吭坑妔挳硁牼硜铿硻",
+    "摼誙銵鍞鏗空倥埪崆悾涳硿箜錓鵼孔恐控鞚躻抠芤眍剾彄摳瞘口劶叩扣敂",
+    "冦宼寇釦窛筘滱蔲蔻瞉簆鷇扝刳矻郀枯胐哭桍堀崫圐跍窟骷鮬狜苦库俈绔",
+    "庫秙趶焅袴喾絝裤瘔酷廤褲嚳夸姱誇侉咵垮銙挎胯跨骻舿蒯擓巜凷块快侩",
+    "郐哙狯脍塊筷鲙儈墤鄶噲廥獪膾旝糩鱠圦宽寛寬臗髋髖欵款歀窾窽鑧匡劻",
+    "诓邼匩哐恇洭框硄筐誆軭忹抂狂诳軖誑鵟夼儣懭卝邝圹纩况旷岲況矿昿贶",
+    "眖眶絖貺軦鉱鄺壙黋懬曠爌躀矌礦穬纊鑛砿絋筺亏刲岿悝盔窥聧窺虧顝闚",
+    "巋蘬奎晆逵鄈隗頄馗喹揆葵骙戣暌楏楑魁睽蝰頯櫆藈鍨鍷騤夔蘷巙虁犪躨",
+    "煃跬頍蹞尯匮欳喟媿愦愧溃腃蒉馈瞆嘳嬇憒潰篑聩聭蕢樻謉餽簣聵籄鐀饋",
+    "鑎坤昆堃婫崐崑晜猑菎裈焜琨髠裩貇锟髡鹍蜫褌髨瑻醌錕鲲騉鯤鵾鶤悃捆",
+    "阃壸梱祵硱稇裍壼稛綑閫閸齫困涃睏堒尡潉熴扩拡括挄桰筈萿葀蛞阔廓頢",
+    "髺擴濶闊鞟懖霩鞹鬠韕",
+    // L
+    "垃拉柆翋菈搚邋旯剌砬揦磖喇藞腊揧楋瘌蜡蝋辢辣蝲臈攋爉臘鬎瓎镴鯻蠟",
+    "鑞啦溂鞡嚹来來俫倈崃徕涞莱郲婡崍庲徠梾淶猍萊逨棶琜筙铼箂錸騋鯠鶆",
+    "麳唻赉睐睞赖賚濑賴頼顂癞鵣瀨瀬籁藾櫴癩襰籟兰岚拦栏婪惏嵐葻阑蓝谰",
+    "厱澜褴儖斓篮懢燣燷藍襕镧闌璼襤譋幱攔瀾灆籃繿蘭斕欄礷襴囒灡籣欗讕",
+    "躝钄韊览浨揽缆榄漤罱醂壈懒覧擥嬾懶孄覽孏攬灠囕欖顲纜烂滥燗嚂濫爁",
+    "爛瓓爤鑭糷爦襽啷勆郎郞欴狼阆嫏廊斏桹琅蓈榔瑯硠稂锒筤艆蜋螂躴鋃鎯",
+    "駺朗朖烺塱蓢樃誏朤埌崀浪莨蒗閬唥郒捞撈劳労牢窂哰唠崂浶勞痨铹僗嘮",
+    "嶗憥癆磱簩蟧醪鐒顟髝耂老佬咾姥恅狫荖栳铑銠潦橑轑涝烙耢酪嫪憦澇躼",
+    "橯耮軂珯硓粩蛯朥鮱肋仂阞乐叻忇扐氻艻玏泐竻砳楽韷樂簕鳓鰳了饹餎勒",
+    "雷嫘缧蔂畾擂檑縲礌镭櫑瓃羸礧纍罍蘲蠝鐳轠儽壨鑘靁虆欙纝鼺厽耒诔垒",
+    "絫腂傫誄樏磊蕌磥蕾儡壘癗藟櫐礨灅蘽讄鑸鸓泪洡类涙淚累酹銇頛頪錑攂",
+    "颣類纇蘱禷塁嘞鱩崚塄棱楞碐稜輘薐冷倰堎愣睖踜刕杝厘剓离荲骊悡梨梩",
+    "梸犁琍粚菞喱棃犂鹂剺漓睝筣缡艃蓠蜊嫠孷樆璃盠貍糎蔾褵鋫鲡黎篱縭罹",
+    "錅蟍謧醨嚟藜邌釐離斄瓈鏫鯬鵹黧囄攡灕蘺蠡騹孋廲劙鑗穲籬纚驪鱺鸝礼",
+    "里俚峛峢娌峲浬逦理锂粴裏豊鋰鲤兣澧禮鯉蟸醴鳢邐鱧欚力历厉屴立吏朸",
+    "丽利励呖坜沥苈例岦戾枥沴疠苙隶俐俪栎疬砅茘荔赲轹郦唎悧栗栛涖猁珕",
+    "砺砾秝莅莉唳婯笠粒粝脷蚸蛎傈凓厤棙痢蛠詈跞雳厯塛慄搮溧蒚蒞鉝鳨厲",
+    "暦歴瑮綟蜧蝷勵曆歷篥隷鴗巁濿癘磿隸鬁儮曞櫔爄犡禲蠇鎘嚦壢攊櫟瀝瓅",
+    "矋礪藶麗櫪爏瓑皪盭礫糲蠣儷癧礰蠫酈鷅麜囇攦觻躒轢欐讈轣攭瓥靂鱱鱳",
+    "靋李栃哩娳狸裡檪鯏俩倆奁连帘怜涟莲連梿联裢亷嗹廉慩溓漣蓮匲奩槤熑",
+    "覝劆匳噒嫾憐磏聫褳鲢濂濓縺翴聮薕螊櫣燫聯臁謰蹥鎌镰簾蠊鬑鐮鰱籢籨",
+    "敛琏脸裣摙璉蔹嬚斂臉鄻襝羷蘞练炼恋浰殓僆堜媡湅萰链楝煉瑓潋練澰錬",
+    "殮鍊鏈瀲蘝鰊戀纞聨良俍凉梁涼椋辌粮粱墚綡踉樑輬糧両两兩唡啢掚脼裲",
+    "緉蜽魉魎亮哴悢谅辆喨晾湸量輌諒輛鍄煷簗撩蹽辽疗聊僚寥嵺憀漻膋嘹嫽",
+    "寮嶚嶛敹獠缭遼暸燎璙膫療鹩屪廫簝繚蟟豂賿蹘鐐髎藔飉鷯叾钌釕鄝蓼憭",
+    "瞭曢镽爒尥尦炓料尞廖撂窷镣爎列劣冽劽姴挒洌茢迾哷埒埓栵浖烈捩猎脟",
+    "蛚裂煭睙聗趔巤颲儠鮤鴷擸獵犣躐鬛鬣鱲毟咧挘烮猟拎厸邻林临冧矝啉崊",
+    "淋晽琳粦痳碄箖粼鄰隣嶙潾獜遴斴暽燐璘辚霖瞵磷臨繗翷麐轔壣瀶鏻鳞驎",
+    "鱗麟菻亃凛凜撛廩廪懍懔澟檁檩癛癝吝恡悋赁焛賃僯蔺橉甐膦閵疄藺蹸躏",
+    "躙躪轥〇刢灵囹坽夌姈岺彾泠狑苓昤朎柃玲瓴凌皊砱秢竛铃陵鸰婈掕棂淩",
+    "琌笭紷绫羚翎聆舲菱蛉衑祾詅跉軨裬鈴閝零龄綾蔆霊駖澪蕶錂魿鲮鴒鹷燯",
+    "霛霝齢酃鯪孁蘦齡櫺醽靈欞爧麢龗阾岭袊领領嶺令另呤炩伶蓤霗瀮溜熘蹓",
+    "刘沠畄浏流留旈琉畱硫裗媹嵧旒蒥蓅遛馏骝榴瑠飗劉瑬瘤磂镏駠鹠橊璢疁",
+    "镠癅蟉駵嚠懰瀏藰鎏鎦麍鏐飀騮飅鰡鶹驑柳栁珋桺绺锍鉚飹綹熮罶鋶橮嬼",
+    "羀六畂翏塯廇澑磟鹨霤餾雡鐂飂鬸鷚桞囖龙屸咙泷茏昽栊珑胧眬砻竜笼聋",
+    "隆湰滝嶐漋蕯癃篭龍嚨巃巄瀧簼蘢鏧霳曨朧櫳爖瓏矓礱礲襱龒籠聾蠪蠬豅",
+    "躘鑨靇驡鸗陇垄垅拢篢儱隴壟壠攏竉龓哢挵梇徿贚槞窿瞜剅娄偻婁溇蒌僂",
+    "楼廔慺漊蔞遱樓熡耧蝼耬艛螻謱軁髅鞻髏嵝搂塿嶁摟甊篓簍陋屚漏瘘镂瘺",
+    "瘻鏤喽嘍噜撸卢庐芦垆泸炉栌胪轳鸬玈舻颅鲈魲盧櫚嚧壚廬攎瀘獹璷蘆曥",
+    "櫨爐瓐臚矑籚纑罏艫蠦轤鑪顱髗鱸鸕黸卤虏掳鹵硵鲁虜塷滷蓾樐魯擄橹磠",
+    "镥嚕擼瀂櫓氌艣鏀艪鐪鑥圥甪陆侓坴彔录峍勎赂辂陸娽淕淥渌硉菉逯鹿椂",
+    "琭禄祿僇剹勠盝睩碌稑賂路塶廘摝漉箓粶蔍戮樚熝膔觮趢踛辘醁潞穋蕗錄",
+    "録錴璐簏螰簶蹗轆騄鹭簬鏕鯥鵦鵱麓鏴露騼籙虂鷺枦舮鈩澛氇驴郘闾榈閭",
+    "馿氀膢藘鷜驢吕呂侣侶挔捛捋旅梠祣稆铝屡絽缕屢膂褛鋁履膐褸儢穞縷穭",
+    "寽垏律虑率绿嵂氯葎滤綠緑慮箻膟勴繂濾櫖爈鑢焒娈孪峦挛栾鸾脔滦銮鵉",
+    "圝奱孌孿巒攣曫欒灓羉臠圞灤虊鑾癴癵鸞卵乱釠亂畧锊稤圙鋝鋢擽抡掄仑",
+    "伦囵沦纶侖轮倫陯圇婨崘崙惀淪菕棆腀綸蜦踚輪錀鯩埨碖稐耣论溣論磮罗",
+    "啰頱囉罖猡脶萝逻椤腡覙锣箩骡镙螺羅覶鏍儸覼騾攞玀蘿邏欏驘鸁籮鑼饠",
+    "剆倮蓏裸躶瘰蠃臝曪癳泺峈洛络荦骆洜珞硦笿絡落嗠摞漯犖鉻雒駱鮥鴼鵅",
+    "濼纙",
+    // M
+    "呣妈孖媽嬤嬷麻痲蔴犘蟇马玛码蚂馬溤瑪碼螞鎷鰢鷌犸杩祃閁骂唛傌獁睰",
+    "嘜榪禡罵駡礣鬕亇吗嗎遤嘛嫲蟆埋薶霾买荬買嘪蕒鷶劢迈佅売麦卖脉脈麥",
+    "衇勱賣邁霡霢嫚颟姏悗蛮僈谩慲馒樠瞒瞞鞔謾饅鳗顢鬗鬘鰻蠻屘満睌满滿",
+    "螨襔蟎鏋矕曼鄤墁幔慢摱漫獌缦蔄蔓槾熳澷镘縵鏝蘰牤邙吂忙汒芒尨杗杧",
+    "氓盲恾笀茫哤娏庬浝狵牻硭釯铓痝蛖鋩駹莽莾硥茻壾漭蟒蠎猫貓毛矛枆牦",
+    "茅茆旄罞兞渵軞酕堥锚嫹髦氂犛蝥髳錨蟊鶜冇卯夘乮戼峁泖昴铆笷蓩冃皃",
+    "芼冐茂冒柕眊贸耄袤覒媢帽萺貿鄚愗暓楙毷瑁瞀貌鄮蝐懋么麼嚒濹嚜癦呅",
+    "坆沒没枚玫苺栂眉娒脄莓梅珻脢郿堳媒嵋湄湈猸睂葿楣楳煤瑂禖塺槑酶镅",
+    "鹛鋂霉穈徾鎇矀攗蘪鶥黴毎每凂美挴浼媄嵄渼媺腜镁嬍燘鎂黣妹抺沬旀昧",
+    "祙袂眛媚寐痗跊鬽煝睸韎魅篃蝞躾门扪玧钔門閅捫菛璊鍆亹虋闷焖悶暪燜",
+    "懑懣们們椚甿虻冡莔萌萠盟蒙甍儚橗瞢蕄蝱鄳鄸幪懞濛曚朦檬氋矇礞鯍鹲",
+    "艨蘉矒霿靀饛顭鼆鸏勐猛瓾锰艋蜢懜獴錳懵蠓鯭孟梦夢溕夣霥掹擝咪眯瞇",
+    "冞弥罙祢迷猕谜蒾詸謎醚彌擟糜縻麊麋禰靡瀰獼麛镾戂攠瓕蘼爢醾醿鸍釄",
+    "米芈侎沵羋弭洣敉眫脒渳葞蔝銤濔孊灖冖糸汨沕宓泌觅峚祕宻秘密淧淿覓",
+    "覔幂谧塓幎覛嘧榓滵漞熐蔤蜜鼏冪樒幦濗藌謐櫁簚羃宀芇眠婂绵媔棉綿緜",
+    "臱蝒嬵檰櫋矈矊矏丏汅免沔黾勉眄娩偭冕勔渑喕愐湎缅葂絻腼黽緬麫澠鮸",
+    "靣面糆麪麺麵喵苗媌描瞄鹋緢鶓鱙杪眇秒淼渺缈篎緲藐邈妙庙玅竗庿廟乜",
+    "吀咩哶孭灭烕覕搣滅蔑薎鴓幭懱篾櫗蠛衊鑖鱴民姄岷忞怋旻旼苠珉盿砇罠",
+    "崏捪琘缗敯瑉痻碈鈱緍緡錉鴖鍲皿冺刡闵抿泯勄敃闽悯敏笢惽湣閔愍暋閩",
+    "僶慜憫潣簢鳘蠠鰵垊笽名明鸣洺眀茗冥朙眳铭鄍嫇溟猽蓂暝榠銘鳴瞑螟覭",
+    "佲姳凕慏酩命椧詺掵谬謬摸谟嫫馍摹模膜麽摩橅磨糢謨嚤擵饃嚩嚰蘑髍魔",
+    "劘饝抹懡末劰圽妺帓歾歿殁沫茉陌帞昩枺唜皌眜眿砞秣莈莫眽粖絈湐蛨貃",
+    "嗼塻寞漠獏蓦貊暯銆靺嫼黙瘼瞐瞙镆魩墨默瀎謩貘藦蟔鏌爅驀礳纆耱庅怽",
+    "尛魹麿哞牟侔劺恈洠眸谋蛑缪踎鉾謀瞴繆鍪鴾麰某毪氁墲母亩牡坶姆峔牳",
+    "畆畒胟畝畞砪畮鉧踇木仫朰目沐狇炑牧苜毣莯蚞钼募雮墓幕幙慔楘睦鉬慕",
+    "暮艒霂穆縸鞪凩拇",
+    // N
+    "嗯拏拿挐嗱镎鎿乸哪雫那妠纳肭娜衲钠納袦捺笝豽軜貀鈉蒳靹魶腉熋摨孻",
+    "乃奶艿氖疓妳廼迺倷釢嬭奈柰耏耐萘渿鼐褦螚錼囡男枏枬侽南柟娚畘莮难",
+    "喃暔楠諵難赧揇湳萳腩蝻戁婻遖囔乪嚢譨囊蠰鬞馕欜饢擃曩攮灢儾齉孬呶",
+    "怓挠峱硇铙猱蛲詉碙撓嶩憹蟯夒譊鐃巎垴恼悩脑匘堖惱嫐瑙腦碯獶獿闹婥",
+    "淖閙鬧臑脳疒讷抐眲訥吶呐呢娞馁脮腇餒鮾鯘內内氝錗恁嫩嫰能妮尼坭怩",
+    "泥籾倪屔秜郳铌埿婗淣猊蚭棿跜腝聣蜺觬貎輗霓鲵鯓鯢麑齯臡伱你拟抳狔",
+    "苨柅旎晲孴鈮馜儗儞隬擬薿檷聻屰氼伲迡昵胒逆匿眤堄惄嫟愵溺睨腻暱縌",
+    "誽膩嬺袮拈蔫年秊秥鲇鮎鲶黏鯰涊捻淰焾跈辇辗撚撵碾輦簐蹍攆蹨躎卄廿",
+    "念姩唸埝艌鼰哖鵇嬢孃酿醸釀娘鸟茑袅鳥嫋裊蔦樢嬝褭嬲尿脲捏揑苶帇圼",
+    "枿陧涅痆聂臬啮惗菍隉喦敜湼嗫嵲踂噛摰槷踗镊镍嶭篞臲錜颞蹑嚙聶鎳闑",
+    "孼孽櫱籋蘖囁齧糱糵蠥鑈囓讘躡鑷顳钀巕囜您拰脌宁咛拧狞苧柠聍寍寕甯",
+    "寗寜寧儜凝嚀嬣擰獰薴檸聹鑏鬡鸋橣矃佞侫泞濘澝妞牛汼忸扭狃纽炄钮紐",
+    "莥鈕靵衂牜农侬哝浓脓秾農儂辳噥濃蕽檂燶禯膿穠襛醲欁繷弄挊癑齈羺啂",
+    "槈耨獳檽鎒鐞譳奴孥驽笯駑伮努弩砮胬怒傉搙女钕籹釹沑恧朒衄奻渜暖煖",
+    "煗餪疟虐硸瘧黁郍挪梛傩儺橠诺喏掿逽愞搦锘搻榒稬諾蹃糑懦懧糥穤糯",
+    // O
+    "喔噢哦筽讴沤欧殴瓯鸥塸漚歐毆熰甌鴎櫙謳鏂鷗膒齵吘呕偶腢嘔耦蕅藕怄",
+    "慪藲",
+    // P
+    "妑皅趴舥啪葩杷爬掱琶筢潖帊帕怕袙拍俳徘排猅棑牌輫簰簲犤廹哌派湃蒎",
+    "鎃眅砙畨潘攀爿洀盘跘媻幋蒰搫槃盤磐縏磻蹒瀊蟠蹣鎜鞶冸判沜拚泮炍叛",
+    "牉盼畔聁袢詊溿頖鋬襻鑻鵥乓沗胮雱滂膖霶厐庞厖逄旁舽嫎徬螃鳑龎龐嗙",
+    "耪覫炐肨胖抛拋脬刨咆垉庖狍炰爮袍匏軳鞄麃麅跑奅泡炮疱皰砲麭礟礮萢",
+    "褜呸怌肧柸胚衃醅阫陪培毰赔锫裴裵賠駍俖伂沛佩帔姵斾旆浿珮配笩辔馷",
+    "嶏霈轡蓜喷噴歕瓫盆湓葐呠翸喯匉怦抨恲砰梈烹硑軯閛漰嘭澎磞芃朋挷竼",
+    "倗莑堋弸彭棚椖塳硼稝蓬鹏槰樥熢憉輣篣膨錋韸髼蟚蟛鬅纄韼鵬騯鬔鑝捧",
+    "淎皏剻掽椪碰踫篷丕伓伾批纰邳坯披抷炋狉砒悂秛秠紕铍旇翍耚豾鈈鈚鈹",
+    "鉟銔劈磇駓髬噼錍魾鮍憵礔礕霹皮阰芘岯枇毞狓肶毗毘疲蚍郫陴啤埤崥蚽",
+    "蚾豼焷琵脾腗鲏罴膍蜱魮壀篺螷貔鵧羆朇鼙匹庀疋仳圮苉脴痞銢諀鴄擗噽",
+    "癖嚭屁淠渒揊釽媲嫓睥辟潎稫僻澼嚊甓疈譬闢鷿鸊榌囨偏媥犏篇翩鍂鶣骈",
+    "胼腁楄楩賆跰諚骿蹁駢騈覑谝貵諞片骗騗騙魸剽慓缥飘旚翲螵犥飃飄魒嫖",
+    "瓢竂薸闝殍彯瞟篻縹醥皫顠票僄勡嘌徱漂氕撇撆暼瞥丿苤鐅嫳姘拼礗穦馪",
+    "驞玭贫娦貧琕嫔频頻嬪獱薲嚬矉蠙颦顰品榀牝汖聘乒甹俜娉涄砯聠艵竮頩",
+    "平评凭呯坪泙苹郱屏帡枰洴玶胓荓瓶屛帲淜萍蚲幈焩甁缾蓱蛢評軿鲆凴慿",
+    "箳輧憑鮃檘簈蘋岼塀钋坡岥泊颇溌鉕頗鏺婆嘙蔢鄱皤謈櫇叵尀钷笸駊岶炇",
+    "迫敀昢洦珀烞破砶釙粕蒪魄醗泼桲潑剖娝抔抙捊掊裒箁錇咅哣婄犃廍仆攴",
+    "扑陠噗撲潽擈鯆匍莆脯菩菐葡蒱蒲僕酺墣獛璞濮瞨穙镤襥纀鏷圤朴圃浦烳",
+    "普溥谱諩樸氆檏镨譜蹼鐠铺舖舗鋪瀑曝巬巭駇贌",
+    // Q
+    "七迉沏妻柒倛凄栖桤郪娸悽桼淒萋攲期棲欺蛣僛嘁慽榿漆緀慼槭諆諿霋蹊",
+    "魌鏚鶈亓祁齐圻岐岓忯芪亝其奇斉歧畁祇祈肵俟疧竒剘斊旂耆脐蚑蚔蚚颀",
+    "埼崎帺掑淇猉畦萁萕跂軝釮骐骑棊棋琦琪祺蛴愭碁碕锜頎鬿旗粸綥綦綨蜝",
+    "蜞齊璂禥蕲踑錡鲯懠濝藄檱櫀臍騎騏鳍蘄鯕鵸鶀麒纃艩蠐鬐鰭玂麡乞邔企",
+    "屺岂芑启呇杞玘盀唘豈起啓啔婍啟绮晵棨綮綺諬闙气讫忔気汔迄弃汽矵芞",
+    "呮泣炁盵咠契砌栔氣訖唭欫夡棄湆湇葺碛摖暣甈碶噐憇器憩磜磧磩罊蟿鼜",
+    "缼戚渏褄緕螧簯簱籏掐葜拤跒酠圶冾帢恰洽殎硈愘髂鞐千仟阡圱圲奷扦汘",
+    "芊迁佥岍杄汧瓩茾欦臤钎拪牵粁兛悭蚈谸铅婜孯牽釺掔谦鈆雃僉愆签鉛骞",
+    "鹐慳搴撁箞諐遷褰謙顅檶攐攑櫏簽鵮孅攓騫鬝鬜籤韆仱岒忴扲拑前钤歬虔",
+    "钱钳掮揵軡媊鈐靬鉗墘榩箝銭潛潜羬蕁橬錢黔黚騝濳騚灊鰬凵浅肷淺脥嗛",
+    "嵰遣槏膁蜸谴缱繾譴欠刋芡俔茜倩悓堑傔嵌棈椠慊皘蒨塹歉綪蔳儙槧篏輤",
+    "篟壍縴鰜竏鎆鏲籖鑓呛羌戕戗斨枪玱羗猐跄椌溬腔嗆蜣锖嶈戧槍牄瑲羫锵",
+    "篬錆謒蹌镪蹡鎗鏘丬強强墙嫱蔷樯漒蔃墻嬙廧薔檣牆艢蘠抢羟搶羥墏繈襁",
+    "繦鏹炝唴熗羻嗴獇悄硗郻嵪跷鄡鄥劁敲毃踍锹墝頝骹墽幧橇燆缲磽鍫鍬繑",
+    "趬蹺鐰乔侨荍荞桥硚菬喬僑谯嘺嫶憔蕎鞒樵橋癄瞧礄藮趫鐈鞽顦巧釥愀髜",
+    "俏诮陗峭帩窍殻翘誚髚僺撬撽鞘韒竅翹譙躈槗犞癿聺且切妾怯郄匧窃悏挈",
+    "洯惬淁笡愜蛪朅箧緁锲篋踥穕藒鍥鯜鐑竊苆倿媫籡亲侵钦衾骎媇嵚欽綅誛",
+    "嶔親顉駸鮼寴庈芩芹埁珡秦耹菦蚙捦菳琴琹禽鈙雂勤嗪嫀溱靲慬噙擒斳鳹",
+    "懄檎澿瘽螓懃蠄鬵鵭坅昑笉梫赾寑锓寝寢鋟螼吢吣抋沁唚菣揿搇撳瀙藽狅",
+    "靑青氢轻倾卿郬圊埥寈氫淸清傾蜻輕鲭鑋夝甠剠勍情殑晴棾氰葝暒擏樈擎",
+    "檠黥苘顷请庼頃廎漀請檾庆凊掅殸碃箐靘慶磘磬罄謦硘櫦芎匔卭邛宆穷穹",
+    "茕桏笻筇赹惸焪焭琼舼蛩蛬煢睘跫銎瞏窮儝憌橩璚藑瓊竆藭瓗熍丘丠邱坵",
+    "恘秋秌蚯媝萩楸蓲鹙篍緧蝵穐趥鳅蟗鞦鞧鰌鰍鶖蠤龝叴囚扏犰玌汓肍求虬",
+    "泅虯俅觓訄訅酋釓唒浗紌莍逎逑釚梂殏毬球赇崷巯渞湭皳盚遒煪絿蛷裘巰",
+    "觩賕璆蝤銶醔鮂鼽鯄鰽搝糗釻蘒区曲伹佉匤岖诎阹驱坥屈岨岴抾浀祛胠袪",
+    "區紶蛆躯筁粬蛐詘趋嶇憈駆敺誳镼駈麹髷魼趨麯覰軀麴黢覻驅鰸鱋佢劬斪",
+    "朐胊菃鸲淭渠絇翑葋軥蕖璖磲螶鴝璩蟝瞿鼩蘧忂灈戵欋氍籧臞癯蠷衢躣蠼",
+    "鑺鸜取竘娶詓竬蝺龋齲厺去刞呿唟耝阒觑趣閴麮闃覷鼁迲衐峑弮恮悛圈圏",
+    "棬駩鐉全权佺诠姾泉洤荃拳牷辁啳埢婘惓痊硂铨湶犈筌絟葲搼瑔觠詮跧輇",
+    "蜷銓権踡縓醛鳈鬈騡孉巏鰁權齤蠸颧顴犬汱畎烇绻綣虇劝券牶勧韏勸犭椦",
+    "楾闎缺蒛阙瘸却卻埆崅寉悫琷雀硞确阕塙搉皵碏愨榷墧慤確碻趞燩闋礐闕",
+    "灍礭鹊鵲夋囷峮逡宭帬裙羣群裠",
+    // R
+    "呥肰衻袇蚦袡蚺然髥嘫髯燃繎冄冉姌苒染珃媣橪蒅穣儴勷瀼獽蘘禳瓤穰躟",
+    "鬤壌嚷壤攘爙纕让懹譲讓娆荛饶桡嬈蕘橈襓饒扰隢擾绕遶繞惹热熱人亻仁",
+    "壬忈朲忎秂芢鈓魜銋鵀忍荏栠栣荵秹棯稔刃刄认仞仭讱任屻岃扨纫妊杒牣",
+    "纴肕轫韧饪姙祍紉衽紝訒軔梕袵軠絍腍葚靭靱韌飪認餁綛躵扔仍辸礽陾芿",
+    "日驲囸釰鈤馹茸戎肜栄狨绒茙荣容毧烿媶嵘搑絨羢嫆嵤搈榵溶蓉榕榮熔瑢",
+    "穁縙蝾褣镕融螎駥髶嬫嶸爃鎔巆瀜曧蠑冗宂坈傇軵氄鴧穃厹禸柔媃揉渘葇",
+    "煣瑈糅蝚蹂輮鍒鞣瓇騥鰇鶔粈楺韖肉宍腬邚如侞帤茹桇袽铷渪筎蒘銣蕠蝡",
+    "儒鴑嚅嬬孺濡薷鴽曘燸襦蠕颥醹顬鱬汝肗乳辱鄏擩入洳嗕媷溽缛蓐褥縟扖",
+    "込杁鳰嶿挼堧撋壖阮朊软耎偄軟媆瑌碝緛輭瓀礝婑桵甤緌蕤蕊蕋橤繠蘂蘃",
+    "汭芮枘蚋锐瑞蜹睿銳鋭叡壡瞤闰润閏閠潤橍膶捼叒若偌弱鄀渃焫楉蒻箬篛",
+    "爇鰙鰯鶸嵶",
+    // S
+    "仨挱挲撒洒訯靸潵灑躠卅泧飒脎萨鈒摋馺颯薩櫒虄隡毢愢揌塞毸腮噻鳃顋",
+    "鰓嗮赛僿賽簺嘥三弎叁毵毿犙鬖仐伞傘糁糂馓糝糣糤繖鏒鏾霰饊俕帴悷散",
+    "閐壭毶厁橵桒桑嗓搡磉褬颡鎟顙丧喪槡掻慅搔溞骚缫繅臊鳋騒騷鰠鱢扫掃",
+    "嫂埽瘙氉矂髞螦閪色洓栜涩啬铯雭歮琗嗇瑟歰銫澁懎擌濇瘷穑澀璱瀒穡繬",
+    "轖鏼譅飋渋濏穯森椮槮襂僧鬙杀沙纱乷刹剎砂唦殺猀粆紗莎桬毮铩痧硰煞",
+    "蔱裟榝樧魦鲨鎩鯊鯋傻儍倽唼啑啥帹萐厦喢廈歃翜箑翣閯霎繌筛酾篩簁簛",
+    "釃繺晒閷曬山彡邖删刪杉芟姍姗苫衫钐埏挻柵狦珊舢痁脠軕笘跚剼搧嘇幓",
+    "煽潸澘檆縿膻鯅羴羶闪陕陝閃晱煔睒熌覢讪汕疝剡扇訕赸掞釤傓善銏骟僐",
+    "鄯墠墡潬缮嬗擅樿歚膳磰謆赡繕蟮蟺譱贍鐥饍騸鳝灗鱓鱔圸杣閊敾伤殇商",
+    "觞傷墒慯滳漡蔏殤熵螪觴謪鬺垧扄晌赏賞贘鑜丄上尙尚恦绱緔鞝仩裳弰捎",
+    "烧莦梢焼稍旓筲艄蛸輎燒颵髾鮹勺芍苕柖玿竰韶少劭卲邵绍哨娋袑紹睄綤",
+    "潲蕱奢猞赊畬畲輋賒賖檨舌佘虵蛇蛥舍捨厍设社厙射涉涻渉設赦弽慑摂摄",
+    "滠慴摵蔎歙蠂韘騇懾攝灄麝欇舎申屾扟伸身侁呻妽籶绅诜姺柛氠珅穼籸娠",
+    "峷甡眒砷莘敒深紳兟棽葠裑訷蓡詵甧蔘燊薓駪鲹曑鵢鯵鰺什甚神邥弞审矤",
+    "哂矧宷谂谉婶渖訠審諗頣魫曋頥瞫嬸瀋覾讅肾侺昚胂涁眘渗祳脤腎愼慎椹",
+    "瘆罧蜃蜄滲鋠瘮堔榊鰰升生阩呏声斘昇泩狌苼栍殅牲珄陞陹笙湦焺甥鉎聲",
+    "鼪鵿绳憴繩譝省眚偗渻圣胜晠剰盛剩勝貹嵊琞聖墭榺蕂賸竔曻橳尸失师呞",
+    "虱诗邿鸤屍施浉狮師絁釶湤湿葹鈟溮溼獅蒒蓍詩鉇鉈瑡鳲蝨鳾褷鲺濕鍦鯴",
+    "鰤鶳襹十饣石辻乭时实実旹飠姼峕炻祏蚀食埘時莳寔湜遈塒溡蒔鉐實榯蝕",
+    "鲥鼫鼭鰣史矢乨豕使始驶兘宩屎笶鉂駛士氏礻丗世仕市示似卋式忕亊叓戺",
+    "事侍势呩柹视试饰冟室恀恃拭是昰枾柿眂贳适栻烒眎眡舐轼逝铈視豉釈媞",
+    "崼弑徥揓谥貰释勢嗜弒睗筮觢試軾鈰鉃飾舓誓適鉽奭銴餙餝噬嬕澨諟諡遾",
+    "螫謚簭襫釋佦竍识拾匙嵵榁煶篒鮖籂識鰘収收手守垨首艏寿受狩兽售授涭",
+    "绶痩壽夀瘦綬獸鏉扌獣书殳尗抒纾叔杸枢陎姝倏倐書殊紓掓梳淑焂菽軗鄃",
+    "疎疏舒摅毹綀输瑹跾踈樞蔬輸橾鮛儵攄鵨秫婌孰赎塾熟璹贖鼡属暑暏黍署",
+    "蜀鼠潻薥薯曙癙藷襡襩屬钃朮术戍束沭述侸凁咰怷树竖荗恕捒庶庻絉蒁術",
+    "隃尌裋数竪腧鉥墅漱潄數澍豎樹濖錰鏣鶐虪瀭糬蠴鱪鱰刷唰耍誜衰摔甩帅",
+    "帥蟀卛闩拴閂栓涮腨双霜雙孀骦孇騻欆礵鷞鹴艭驦鸘爽塽慡漺樉縔灀鏯谁",
+    "脽誰水帨涗涚祱稅税裞睡瞓氵氺閖吮顺舜順蕣橓瞚瞬鬊说哾說説妁烁朔铄",
+    "欶硕矟搠蒴槊獡碩箾鎙爍鑠厶纟丝司糹私咝泀思虒鸶媤斯絲缌蛳楒禗鉰飔",
+    "凘厮榹禠罳蜤锶嘶噝廝撕澌磃緦蕬鋖燍螄蟖蟴颸騦鐁鷥鼶籭死巳亖四寺汜",
+    "佀兕姒泤祀価孠杫泗饲驷娰柶牭洍涘肂飤笥耜釲竢覗嗣肆貄鈶鈻飼禩駟蕼",
+    "儩瀃俬恖銯忪松枀娀柗倯凇崧庺梥淞菘嵩硹蜙憽濍檧鍶鬆怂悚耸竦傱愯楤",
+    "嵷慫聳駷讼宋诵送颂訟頌誦餸枩鎹捜鄋嗖廀廋搜溲獀蒐蓃馊摉飕摗锼艘螋",
+    "醙鎪餿颼颾騪叜叟傁嗾瞍擞薮擻藪櫢籔膄瘶嗽苏甦酥稣窣穌蘇蘓櫯囌俗玊",
+    "夙泝肃洬涑珟素莤速宿梀殐粛骕傃粟谡嗉塐塑嫊愫溯溸肅遡鹔僳愬榡膆蔌",
+    "觫趚遬憟樎樕潥碿鋉餗潚縤橚璛簌藗謖蹜驌鱐鷫诉訴鯂狻痠酸匴祘笇筭蒜",
+    "算夊攵芕虽倠哸浽荽荾眭葰滖睢綏熣濉鞖雖绥隋随遀隨瓍瀡膸髄髓亗岁砕",
+    "祟谇埣嵗遂歲歳煫睟碎隧嬘澻穂誶賥檖燧璲禭檅穗穟繀襚邃旞繐繸譢鐆鐩",
+    "韢孙狲荪孫飧搎猻蓀飱槂蕵薞损笋隼筍損榫箰簨鎨鶽唆娑莏傞桫梭睃嗍羧",
+    "蓑摍缩趖簑簔縮髿鮻所乺唢索琐惢锁嗩暛溑瑣褨璅鎈鎍鎖鎻鏁逤溹蜶琑嗦",
+    // T
+    "他它她牠祂趿铊塌榙溻褟嚃闧蹹塔溚墖獭鳎獺鰨亣拓挞狧闼崉涾搨跶遝遢",
+    "榻毾禢撻澾誻踏橽錔濌蹋鞜鮙闒鞳嚺闥譶躢侤咜囼孡胎冭台旲邰坮抬苔枱",
+    "炱炲菭跆鲐箈臺颱駘儓鮐嬯擡薹檯籉太夳忲汰态肽钛泰舦酞鈦溙態燤粏坍",
+    "抩贪怹痑舑貪摊滩瘫擹攤灘癱坛昙倓谈郯婒惔覃榃痰锬谭墰墵憛潭談醈壇",
+    "曇燂錟餤檀磹顃罈藫壜譚貚醰譠罎忐坦袒钽菼毯鉭嗿憳憻醓璮襢叹炭埮探",
+    "傝湠僋嘆碳舕歎賧汤坣铴湯嘡耥劏羰蝪薚镗蹚鏜鐋鞺鼞饧唐堂傏啺棠鄌塘",
+    "搪溏蓎隚榶漟煻瑭禟膅樘磄糃膛橖篖糖螗踼糛螳赯醣餳鎕餹闛饄鶶伖帑倘",
+    "偒淌傥躺镋鎲儻戃曭爣矘钂烫摥趟燙夲弢涛绦掏絛詜嫍幍慆搯滔槄瑫韬飸",
+    "縚縧濤謟轁鞱韜饕匋迯咷洮逃桃陶啕梼淘绹萄祹裪綯蜪鞀醄鞉鋾錭駣檮饀",
+    "騊鼗讨討套忑忒特貣蚮铽慝鋱螣蟘熥膯鼟疼痋幐腾誊漛滕邆縢駦謄儯藤騰",
+    "籐鰧籘驣霯虅剔梯锑踢擿鷈鷉苐厗荑绨偍啼崹惿提稊缇罤遆鹈嗁瑅綈碮褆",
+    "徲漽緹蕛蝭銻题趧蹄醍謕蹏鍗鳀鴺題鮷鵜騠鯷鶗鶙禵鷤体挮躰骵鮧軆體戻",
+    "迏剃朑洟倜悌涕逖悐惕掦逷惖揥替楴裼褅歒殢髰薙嚏鬀嚔瓋籊趯屉屜笹嵜",
+    "天兲婖添酟靔黇靝田屇沺恬畋畑盷胋畠甛甜菾湉塡填搷鈿阗緂磌窴璳闐鷆",
+    "鷏忝殄倎唺悿淟晪琠腆觍痶睓舔餂覥賟錪鍩靦掭睼舚碵鴫旫佻庣恌挑祧聎",
+    "芀条岧岹迢祒條笤萔蓚蓨趒龆樤蜩鋚鞗髫鲦鯈鎥齠鰷宨晀朓脁窕誂斢窱嬥",
+    "眺粜絩覜跳糶螩帖怗贴萜聑貼铁蛈僣銕鋨鴩鐡鐵驖呫飻餮厅庁汀艼听町耓",
+    "厛烃桯烴綎鞓聴聼廰聽廳邒廷亭庭莛停婷嵉渟筳葶蜓楟榳閮霆聤蝏諪鼮圢",
+    "甼侹娗挺涏梃烶珽脡艇颋誔頲囲炵通痌嗵蓪仝同佟彤峂庝哃峝狪茼晍桐浵",
+    "烔砼蚒眮秱铜童粡筩詷赨酮鉖僮勭鉵銅餇鲖潼獞曈朣橦氃燑犝膧瞳鮦统捅",
+    "桶筒統綂樋恸痛衕慟憅偷偸婾媮鋀鍮亠头投骰緰頭妵钭紏敨飳黈蘣透綉凸",
+    "宊禿秃怢突唋涋捸堗湥痜葖嶀鋵鵚鼵図图凃峹庩徒悇捈荼途屠梌菟揬稌圕",
+    "塗嵞瘏筡腯蒤鈯圖圗廜潳跿酴馟鍎駼鵌鶟鷋鷵土圡吐钍釷兎迌兔堍鵵汢涂",
+    "莵湍猯煓貒团団抟剸團慱摶漙槫篿檲鏄糰鷒鷻疃彖湪褖推蓷藬弚颓隤尵頹",
+    "頺頽魋穨蘈蹪俀腿僓蹆骽侻退娧煺蛻蜕褪駾吞呑涒啍朜焞噋暾黗屯坉忳芚",
+    "饨豘豚軘飩鲀魨霕臀臋氽畽旽乇仛讬托扡汑饦杔侂咃拕拖沰挩捝莌袥託涶",
+    "脫脱飥魠驝驮佗陀陁坨岮沱沲狏迱砣砤袉鸵紽堶跎酡碢馱槖駄駞橐鮀鴕鼧",
+    "騨鼍驒鼉彵妥庹媠椭楕嫷橢鵎鬌鰖柝毤唾萚跅毻箨蘀籜驼駝",
+    // W
+    "穵劸挖洼娲畖窊媧嗗蛙搲溛漥窪鼃攨娃瓦佤邷咓袜聉嗢腽膃襪韈韤屲瓲哇",
+    "歪喎竵崴外夞顡弯剜婠帵塆湾蜿潫豌彎壪灣丸刓汍纨芄完岏抏玩紈捖顽烷",
+    "琓頑翫宛倇唍挽盌埦婉惋晚梚绾脘菀萖晩晼椀琬皖畹睕碗綩綰輓踠鋄鋔万",
+    "卍卐妧忨捥脕貦萬腕輐澫薍錽蟃贃鎫贎邜杤笂尣尪尫汪尩亡亾兦王仼彺莣",
+    "蚟罒网往徃罔徍惘菵暀棢蛧辋網蝄誷輞瀇魍妄忘迋旺盳望朢枉焹危威烓偎",
+    "萎逶隇隈喴媙愄揋揻渨葨葳微椳楲溦煨詴蜲蝛覣薇燰鳂巍鰃鰄囗韦圩围帏",
+    "沩违闱峗峞洈韋桅涠唯帷惟硙维喡圍媁嵬幃湋溈琟違潍維蓶鄬潙潿磑醀濰",
+    "鍏闈鮠癓覹犩霺欈厃伟伪尾纬芛苇委炜玮洧娓屗浘荱诿偉偽崣梶痏硊骩嵔",
+    "徫愇猥葦蒍骪骫暐椲煒瑋痿腲艉韪僞撱磈鲔寪緯蔿諉踓韑頠薳儰濻鍡鮪壝",
+    "瀢韙颹韡蘤斖卫为未位味苿為畏胃叞軎尉菋谓喂媦渭爲煟碨蔚蜼慰熭犚緭",
+    "衛懀璏罻衞謂餧鮇螱褽餵魏藯轊鏏霨鳚蘶饖讆躗讏躛捤煀猬墛縅蝟嶶昷塭",
+    "温榅殟溫瑥辒瘟蕰豱輼轀鳁鞰鰛鰮匁文彣纹芠炆玟闻紋蚉蚊珳阌琝雯瘒聞",
+    "馼魰鳼鴍螡閺閿蟁闅鼤闦刎吻忟抆呡肳紊桽脗稳穏穩问妏汶莬問渂揾搵顐",
+    "璺呚鈫鎾翁嗡滃鹟螉鎓鶲勜奣塕嵡蓊暡瞈聬瓮蕹甕罋齆挝倭涡莴唩涹渦猧",
+    "萵窝窩蜗撾蝸踒我婐捰仴沃肟卧枂臥偓捾涴媉幄握渥焥硪楃腛斡瞃擭濣瓁",
+    "臒雘龌齷乌圬弙汙汚污邬呜巫杇屋洿诬钨烏剭窏鄔嗚歍誣箼螐鴮鎢鰞无毋",
+    "吳吴吾呉芜郚唔娪洖浯茣莁梧珸祦無铻鹀禑蜈誈蕪璑蟱鯃鵐譕鼯鷡五午仵",
+    "妩庑忤怃旿武玝侮俉倵捂啎娬牾珷摀碔鹉熓瑦舞嫵廡憮潕儛橆甒鵡躌兀勿",
+    "戊阢伆屼扤坞岉杌芴迕忢物矹卼敄误悞悟悮粅逜晤焐婺嵍痦隖靰骛塢奦嵨",
+    "溩雺雾寤熃誤鹜遻鋈窹霚鼿霧齀蘁騖鶩乄务伍務錻",
+    // X
+    "夕兮吸忚扱汐覀希扸卥昔析穸肸肹俙徆怸恓郗饻唏奚屖悕氥浠牺狶莃唽悉",
+    "惜捿晞桸欷淅烯焁焈琋硒菥赥釸傒惁晰晳焟焬犀睎稀粞翕舾鄎厀嵠徯溪皙",
+    "蒠锡僖榽煕熄熈熙緆蜥豨餏嘻噏嬆嬉嶲潝瘜磎膝凞憙樨橀熹熺熻窸縘羲螅",
+    "螇錫燨瞦蟋谿豀豯貕糦繥雟鵗觹譆醯鏭隵巇曦爔犧酅觽鼷蠵鸂觿鑴习郋席",
+    "習袭觋媳椺蒵蓆嶍漝覡趘槢薂隰檄謵鎴霫鳛飁騱騽襲鰼驨枲洗玺徙铣喜葈",
+    "葸鈢鉨鉩屣漇蓰憘暿歖禧諰壐縰謑蟢蹝璽囍鱚矖躧匸卌戏屃系饩呬忥怬矽",
+    "细係咥恄盻郤欯绤細釳阋喺椞翖舃舄趇隙慀滊禊綌赩隟墍熂犔稧潟澙蕮覤",
+    "戱黖戲磶虩餼鬩繫嚱闟霼屭衋西息渓橲犠礂鯑虲疨虾谺傄閕煆煵颬瞎蝦鰕",
+    "匣侠狎俠峡柙炠狭陜峽烚狹珨祫硖翈舺陿硤遐敮暇瑕筪舝碬辖磍縀蕸縖赮",
+    "魻轄鍜霞鎋黠騢鶷閜丅下乤吓疜夏睱嚇懗罅鎼夓鏬圷梺溊仚屳先奾纤佡忺",
+    "氙杴祆秈苮枮籼珗莶掀訮铦跹酰锨僊嘕銛鲜暹韯嬐憸薟鍁褼韱鮮蹮馦廯攕",
+    "纎鶱襳躚纖鱻伭闲妶弦贤咸唌挦涎胘娴娹婱絃舷蚿衔啣痫蛝閑閒鹇嫌衘甉",
+    "銜嫺嫻憪撏澖稴誸賢燅諴輱醎癇癎瞯藖礥鹹麙贒鷳鷴鷼冼狝显险崄毨烍猃",
+    "蚬険赻筅尟尠搟禒跣銑箲險嶮獫獮藓鍌燹顕幰攇櫶蘚譣玁韅顯灦伣县咞岘",
+    "苋现线臽限姭宪県陥哯垷娊娨峴涀莧陷晛現硍馅睍絤缐羡献粯羨腺蜆僩僴",
+    "綫誢撊線鋧憲橌縣錎餡壏豏麲瀗臔獻糮鼸仙僲繊鑦乡芗相香郷厢啌鄉鄊廂",
+    "湘缃葙鄕稥薌箱緗膷襄忀骧麘欀瓖镶鑲驤瓨佭详庠栙祥絴翔詳跭享亯响饷",
+    "晑飨想銄餉鲞曏蠁鮝鯗響饗饟鱶向姠巷蚃项珦象塂缿萫衖項像勨嶑銗橡襐",
+    "嚮蟓闀鐌鱌楿鱜灱灲呺枭侾哓枵骁哮宯宵庨消绡虓逍鸮婋梟焇猇萧痚痟硝",
+    "硣窙翛萷销揱綃嘋嘐歊潇箫踃嘵憢獢銷霄彇膮蕭魈鴞穘簘藃蟂蟏鴵嚣瀟簫",
+    "蟰髇櫹嚻囂髐蠨驍毊虈洨笅郩崤淆訤殽筊誵小晓暁筱筿皛曉篠謏皢孝肖効",
+    "咲俲效校涍笑啸傚敩詨嘨誟嘯歗熽鞩斅斆恷滧些揳猲楔歇蝎蠍劦协旪邪協",
+    "胁垥奊峫恊拹挟挾脅脇衺偕斜谐翓嗋愶携瑎綊熁膎勰撷擕緳缬蝢鞋頡諧燲",
+    "擷鞵襭攜纈讗龤写冩寫藛伳灺泄泻祄绁缷卸洩炧卨娎屑屓偞偰徢械烲焎禼",
+    "紲亵媟屟渫絏絬谢僁塮榍榭褉噧屧暬緤嶰廨懈澥獬糏薢薤邂韰燮褻謝駴瀉",
+    "鞢瀣爕繲蟹蠏齘齛齥齂躞脋夑心邤妡忻芯辛昕杺欣炘盺俽惞訢鈊锌新歆廞",
+    "鋅嬜薪馨鑫馫枔襑鐔伈阠伩囟孞信軐脪衅訫焮煡馸顖舋釁忄噺星垶骍惺猩",
+    "煋瑆腥蛵觪箵篂鮏曐觲鍟騂皨鯹刑行邢形陉侀郉型洐荥钘陘娙硎铏鈃滎鉶",
+    "銒鋞睲醒擤兴杏姓幸性荇倖莕婞悻涬緈興嬹臖哘裄謃凶兄兇匈讻忷汹哅恟",
+    "洶胷胸訩詾賯雄熊焽诇焸詗夐敻休俢修咻庥烋烌羞脩脙鸺臹貅馐樇銝髤髹",
+    "鎀鵂鏅饈鱃飍苬朽滫綇糔秀岫峀珛绣袖琇锈嗅溴璓褎褏銹螑繍繡鏥鏽齅鮴",
+    "吁戌旴疞盱欨胥须晇訏顼虗虚谞媭幁揟湑虛裇須楈窢頊嘘墟需魆噓嬃歔縃",
+    "蕦蝑諝譃繻魖驉鑐鬚俆徐蒣许呴姁诩冔栩珝偦許暊詡稰鄦糈醑盨旭伵序汿",
+    "芧侐卹怴沀叙恤昫洫垿欰殈烅珬勖敍敘勗烼绪续酗喣壻婿朂溆絮訹慉煦蓄",
+    "賉槒漵潊盢瞁緒聟銊獝稸緖魣藇瞲藚續鱮聓続蓿吅轩昍宣弲軒梋谖喧塇媗",
+    "愃愋揎萱萲暄煊瑄蓒睻儇禤箮縇翧蝖鋗懁蕿諠諼鍹駽矎翾藼蘐蠉譞玄玹痃",
+    "悬旋琁蜁嫙漩暶璇檈璿懸咺选晅烜選顈癣癬怰泫昡炫绚眩袨铉琄眴衒渲絢",
+    "楥楦鉉碹蔙镟鞙颴縼繏鏇讂贙鰚削疶蒆靴薛辥辪鞾穴斈乴学岤峃茓泶袕鸴",
+    "踅壆學嶨澩燢觷雤鷽雪鳕鱈血吷坹狘桖谑趐謔瀥膤樰艝轌坃勋埙焄勛塤熏",
+    "窨蔒勲勳薫駨壎獯薰曛燻臐矄蘍壦纁醺廵寻旬巡驯杊畃询峋恂洵浔紃荀荨",
+    "栒桪毥珣偱尋循揗槆潃詢馴鄩鲟噚潯攳樳燖璕蟳鱏鱘灥卂讯伨汛迅侚巺徇",
+    "狥迿逊殉訊訙奞巽殾稄遜愻賐噀潠蕈鵕爋顨鑂训訓嚑",
+    // Y
+    "丫圧压吖庘押枒垭鸦桠鸭埡孲椏鴉錏鴨壓鵶鐚牙伢厑岈芽厓玡琊笌蚜堐崕",
+    "崖涯猚瑘睚衙漄齖厊庌哑唖啞痖雅瘂蕥劜圠轧亚襾讶亜犽迓亞軋娅挜砑俹",
+    "氩婭掗訝铔揠氬猰聐圔稏窫齾乛呀恹剦烟珚胭偣啱崦淊淹焉焑菸阉湮猒腌",
+    "煙硽鄢嫣漹醃閹嬮懨篶懕臙黫讠延严妍芫言岩昖沿炎郔姸娫狿研莚娮盐琂",
+    "硏閆阎嵒嵓湺筵綖蜒塩揅楌詽碞蔅颜厳虤閻檐顏顔嚴壛巌簷櫩黬壧孍巗巖",
+    "礹鹽麣夵抁沇乵兖奄俨兗匽弇衍偃厣掩眼萒郾酓嵃愝扊揜棪渰渷琰遃隒椼",
+    "罨裺演褗嶖戭蝘魇噞躽縯檿験黡厴甗鰋鶠黤齞龑儼黭顩鼴巘巚曮魘鼹齴黶",
+    "厌闫妟觃牪咽姲彥彦砚唁宴晏烻艳覎验偐焔谚隁喭堰敥焰焱硯葕雁傿椻溎",
+    "滟鳫厭墕暥酽嬊谳餍鴈燄燕諺赝鬳曕鴳酀騐嚥嬿艶贋曣爓醶騴鷃灔贗觾讌",
+    "醼饜驗鷰艷灎釅驠灧讞豓豔灩訁熖樮軅欕央咉姎抰泱殃胦眏秧鸯鉠雵鞅鴦",
+    "扬羊阦阳旸杨炀飏佯劷氜疡钖垟徉昜洋羏烊珜眻陽崵崸揚蛘敭暘楊煬禓瘍",
+    "諹輰鍚鴹颺鐊鰑霷鸉仰佒坱岟养柍炴氧痒紻傟楧軮慃氱蝆養駚懩攁癢怏恙",
+    "样羕詇様漾樣瀁奍羪礢幺夭吆妖枖殀祅訞喓葽楆腰鴁邀爻尧尭肴垚姚峣轺",
+    "倄烑珧窑傜堯揺谣軺嗂媱徭愮搖摇猺遙遥暚榣瑤瑶銚飖餆嶢嶤窯窰餚繇謠",
+    "謡鎐鳐颻蘨邎顤鰩仸宎岆抭杳狕苭咬柼眑窅窈舀偠婹崾溔蓔榚鴢鼼闄騕齩",
+    "鷕穾药要钥袎窔筄葯詏熎覞靿獟鹞薬曜燿艞藥矅耀纅鷂讑鑰倻掖椰暍噎潱",
+    "蠮耶捓揶铘釾鋣鎁擨也吔冶埜野嘢漜壄业叶曳页曵邺夜抴亱枼頁晔枽烨啘",
+    "液谒堨殗腋葉鄓墷楪業馌僷曄曅歋燁擛皣瞱鄴靥嶪嶫澲謁餣嚈擫曗瞸鍱擪",
+    "爗礏鎑饁鵺鐷靨驜鸈爷亪爺一乊弌伊衣医吚壱依祎咿洢悘猗郼铱壹揖欹蛜",
+    "禕嫛漪稦銥嬄噫夁瑿鹥繄檹毉醫黟譩鷖黳乁仪匜圯夷迆冝宐沂诒侇怡沶狋",
+    "衪迤饴咦姨峓恞拸柂珆瓵贻迻宧巸弬扅栘桋眙胰袘訑貤痍移耛萓凒羠蛦詑",
+    "詒貽遗媐暆椸誃跠頉颐飴疑儀熪箷遺嶬彛彜螔頤寲嶷簃顊彝彞謻鏔觺讉鸃",
+    "乙已以钇佁攺矣肔苡苢庡舣蚁釔倚扆笖逘酏偯崺旑椅鉯鳦裿旖踦輢敼螘檥",
+    "礒艤蟻顗轙齮乂义亿弋刈忆艺肊议亦伇屹异芅伿佚劮呓坄役抑杙耴苅译邑",
+    "佾呭呹峄怈怿易枍欥泆炈秇绎诣驿俋奕帟帠弈枻洂浂玴疫羿衵轶唈垼悒挹",
+    "捙栧栺欭浥浳益袣谊陭勚埶埸悥掜殹異硛羛翊翌訲訳豙豛逸釴隿幆敡晹棭",
+    "殔湙焲蛡詍跇軼鈠骮亄兿意溢獈痬睪竩缢義肄裔裛詣勩嫕廙榏潩瘗膉蓺蜴",
+    "靾駅億撎槸毅熠熤熼瘞誼镒鹝鹢黓劓圛墿嬑嬟嶧憶懌曀殪澺燚瘱瞖穓縊艗",
+    "薏螠褹寱斁曎檍歝燡燱翳翼臆賹鮨癔藙藝贀鎰镱繶繹豷霬鯣鶂鶃瀷蘙譯議",
+    "醳醷饐囈鐿鷁鷊懿襼驛鷧虉鷾讛齸辷匇衤宜畩萟椬鶍籎囙因阥阴侌垔姻洇",
+    "茵荫音骃栶殷氤陰凐秵裀铟陻隂喑堙婣愔筃絪歅溵禋蔭慇摿瘖銦緸鞇諲霒",
+    "駰噾闉霠韾冘乑吟犾苂斦烎垠泿圁峾狺珢荶訔訚婬寅崟崯淫訡银鈝龂滛碒",
+    "鄞夤蔩銀噖殥璌誾嚚檭蟫霪齗鷣乚廴尹引吲饮蚓赺隐淾鈏飲隠靷飮朄輑磤",
+    "趛檃瘾隱嶾濥濦螾蘟櫽癮讔印茚洕胤垽堷湚猌廕蒑酳慭癊憖憗鮣懚檼粌应",
+    "応英偀桜莺啨婴媖渶绬朠煐瑛嫈碤锳嘤撄甇緓缨罂蝧賏樱璎罃褮鍈霙鴬鹦",
+    "嬰應膺韺甖鹰鶑鶧嚶孆孾攖罌蘡譍櫻瓔礯譻鶯鑍纓蠳鷪鷹鸎鸚盁迎茔盈荧",
+    "莹営萤营萦蛍溁溋萾僌塋楹滢蓥潆熒瑩蝿嬴營縈螢濙濚濴藀覮謍赢瀅鎣攍",
+    "瀛瀠瀯櫿瀴贏籝籯矨郢浧梬颍颕颖摬影潁璄瘿穎頴巊廮癭映暎硬媵膡噟鞕",
+    "鐛鱦珱愥蝇縄攚蠅灐灜軈哟唷喲佣拥痈邕庸傭嗈鄘雍墉嫞慵滽槦噰壅擁澭",
+    "郺镛臃癕雝鏞鳙廱灉饔鱅鷛癰喁揘牅颙顒鰫永甬咏泳俑勇勈栐埇悀柡涌恿",
+    "傛惥愑湧硧詠塎嵱彮愹蛹慂踊禜鲬踴鯒用苚醟怺砽优忧攸呦怮泑幽逌悠麀",
+    "滺憂優鄾嚘瀀櫌纋耰尢尤由沋犹邮油肬怣斿疣峳浟秞莜莸郵铀偤蚰訧逰游",
+    "猶遊鱿楢猷鈾鲉輏駀蕕蝣魷輶鮋櫾有丣卣苃酉羑庮栯羐莠梄聈脜铕湵禉蜏",
+    "銪槱牖黝懮又右幼佑侑狖糿哊囿姷宥峟柚牰祐诱迶唀蚴亴貁釉酭誘鼬友孧",
+    "蒏牗扜纡迂迃穻陓紆虶唹淤盓毺瘀箊亐于邘伃余妤扵杅欤玗玙於盂臾衧鱼",
+    "乻俞兪禺竽舁茰娛娯娱桙狳谀酑馀渔萸隅雩魚堣堬崳嵎嵛愉揄楰渝湡畭硢",
+    "腴萮逾骬愚旕楡榆歈牏瑜艅虞觎漁睮窬舆褕歶羭蕍蝓諛雓餘嬩澞覦踰歟璵",
+    "螸輿鍝謣髃鮽旟籅騟蘛鰅鷠鸆与予伛宇屿羽雨俁俣禹语圄峿祤偊匬圉庾敔",
+    "鄅斞萭傴寙楀瑀瘐與語窳鋙頨龉噳嶼懙貐斔麌蘌齬肀玉驭圫聿芋芌妪忬饫",
+    "育郁昱狱秗茟俼峪彧浴砡钰预喐域堉悆惐欲淢淯谕逳阈喅喩喻媀寓庽御棛",
+    "棜棫焴琙矞硲裕遇飫馭鹆愈滪煜稢罭艈蒮蓣誉鈺預嫗嶎戫毓獄瘉緎蜟蜮輍",
+    "銉噊慾潏稶蓹薁豫遹鋊鳿澦燏燠蕷諭錥閾鴥鴪儥礇禦魊鹬癒礖礜穥篽繘醧",
+    "鵒櫲饇譽轝鐭霱欎驈鬻籞鱊鷸鸒欝龥軉鬰鬱灪籲爩挧荢澚鯲囦鸢剈冤悁眢",
+    "鸳寃渁渆渊渕惌淵葾棩蒬蜎裷鹓箢鳶蜵駌鴛嬽鵷灁鼘鼝元円贠邧员园沅杬",
+    "垣爰貟原員圆笎蚖袁厡圎援湲猨缘茒鼋園圓塬媴嫄源溒猿獂蒝榞榬辕緣縁",
+    "蝝蝯魭橼羱薗螈謜轅黿鎱櫞邍騵鶢鶰厵远盶逺遠鋺夗肙妴苑怨院垸衏傆媛",
+    "掾瑗禐愿裫褑褤噮願酛鈨曰曱约約箹矱彟彠月戉刖妜岄抈礿岳玥恱悅悦蚎",
+    "蚏軏钺阅捳跀跃粤越鈅粵鉞閱閲嬳樾篗嶽龠籆瀹蘥黦爚禴躍籥鸑籰鸙晕缊",
+    "蒀暈氲煴蒕氳奫蝹縕赟頵馧贇云勻匀囩妘沄纭芸昀畇眃秐郧涢紜耘耺鄖雲",
+    "愪溳筠筼蒷榲熉澐蕓鋆橒篔縜饂允阭夽抎狁陨荺殒喗鈗隕殞褞馻磒賱霣齳",
+    "孕运枟郓恽鄆酝傊惲愠運慍腪韫韵熅熨緷緼蕴薀醖醞餫藴韗韞蘊韻抣繧",
+    // Z
+    "帀匝沞迊咂拶紥紮鉔魳臜臢杂砸偺喒韴雑嶻磼襍雜囋囐雥咋災灾甾哉栽烖",
+    "菑渽睵賳宰崽再在扗侢洅载傤載酨儎縡兂糌簪簮鐕鐟咱昝沯桚寁揝噆撍儧",
+    "攅攒儹攢趱礸趲暂暫賛赞錾鄼濽蹔瓉贊鏨瓒酇灒讃瓚禶襸讚饡匨牂羘赃賍",
+    "臧蔵賘贓髒贜驵駔奘弉脏塟葬銺臓臟傮遭糟蹧醩凿鑿早枣蚤棗澡璪薻繰藻",
+    "灶皁皂唕唣造梍喿慥艁噪簉燥竃譟趮躁竈栆则択沢择泎泽责迮則荝唶啧帻",
+    "笮舴責溭矠嘖嫧幘箦樍諎赜擇澤皟瞔簀礋襗謮賾蠌齚齰鸅夨仄庂汄昃昗捑",
+    "崱伬蔶贼戝賊鲗鯽蠈鰂鱡怎谮譖譛囎増鄫增憎缯橧熷璔矰磳罾繒譄锃鋥甑",
+    "赠贈鱛扎吒抯奓挓柤査哳偧喳揸渣楂劄摣皶樝觰皻譇齄齇札甴闸蚻铡煠牐",
+    "閘箚耫鍘譗厏拃苲眨砟搩鲊鲝踷鮓鮺乍灹诈咤柞栅炸宱痄蚱溠詐搾榨霅醡",
+    "捚斋斎摘榸齋宅檡窄鉙债砦債寨瘵夈粂沾毡旃栴粘蛅飦惉詀趈詹閚谵噡嶦",
+    "薝邅霑氈氊瞻鹯旜譫饘鳣驙魙鱣鸇讝斩飐展盏崭斬椫琖搌盞嶃嶄榐颭嫸醆",
+    "橏輾黵占佔战栈桟站偡绽菚棧湛戦綻嶘輚戰虥虦覱轏譧蘸驏张張章傽鄣墇",
+    "嫜彰慞漳獐粻蔁遧暲樟璋餦蟑騿鱆麞仉长長涨掌漲礃丈仗扙帐杖胀账帳涱",
+    "脹痮障嶂幛賬瘬瘴瞕粀幥鏱鐣佋钊妱巶招昭盄釗啁鉊駋窼鍣皽爪找沼瑵召",
+    "兆诏枛垗炤狣赵笊肁旐棹詔照罩肇肈趙曌燳鮡櫂瞾羄爫罀蜇嗻嫬遮厇折歽",
+    "矺砓籷虴哲埑粍袩啠悊晢晣辄喆蛰詟谪馲摺輒磔輙銸辙蟄嚞謫謺鮿轍讁讋",
+    "者乽啫禇锗赭褶襵这柘浙這淛樜潪鹧蟅鷓着著蔗贞针侦浈珍珎胗貞帪栕桢",
+    "眞真砧祯針偵桭酙寊葴遉嫃搸斟楨獉甄禎蒖蓁鉁靕榛殝瑧碪禛潧箴樼澵臻",
+    "薽錱轃鍼籈鱵诊抮枕弫昣轸屒畛疹眕袗紾聄裖診軫絼缜稹駗縥鬒黰圳阵纼",
+    "甽侲挋陣鸩振朕栚紖眹赈酖塦揕敶瑱誫賑镇震鴆鎭鎮萙鋴争佂姃征怔爭诤",
+    "埩峥挣炡狰烝眐钲崝崢掙猙睁聇铮媜揁筝徰蒸睜踭鉦徴箏錚徵篜鬇鯖癥氶",
+    "抍糽拯掟晸愸撜整正证郑帧政症幀証塣諍鄭鴊證凧之支卮汁芝吱巵汥坧枝",
+    "泜知织肢栀祗秓秖胑胝衼倁疷祬秪脂隻梔戠椥臸搘禔稙綕榰蜘馶鳷鴲鵄織",
+    "蘵鼅执侄妷直姪値值聀釞埴執淔职貭植殖犆禃絷褁跖嗭瓡鉄墌摭馽嬂慹漐",
+    "踯樴膱儨縶職蟙蹠軄躑夂止只劧旨阯址坁帋扺汦沚纸芷怾抧祉咫恉指枳洔",
+    "砋衹轵淽疻紙訨趾軹黹酯藢襧阤至芖志忮扻豸制厔垁帙帜治炙质迣郅峙庢",
+    "庤挃柣栉洷祑陟娡徏挚晊桎狾秩致袟贽轾乿偫徝掷梽楖猘畤痔秲秷窒紩翐",
+    "袠觗铚鸷傂崻彘智滞痣蛭軽骘寘廌搱滍稚筫置跱輊锧雉墆滯潌疐製覟誌銍",
+    "幟憄摯熫稺膣觯質踬鋕擳旘瀄緻駤鴙劕懥擲櫛穉螲懫贄櫍瓆觶騭鯯礩豑騺",
+    "驇躓鷙鑕豒凪俧徔謢中伀汷刣妐彸忠泈炂终柊盅衳钟舯衷終鈡幒蔠锺銿螤",
+    "螽鍾鼨蹱鐘籦肿种冢喠尰塚塜歱煄腫瘇種踵穜仲众妕狆祌茽衶重蚛偅眾堹",
+    "媑筗衆諥迚州舟诌侜周洲诪烐珘辀郮徟掫淍矪週鸼喌粥赒輈銂賙輖霌盩謅",
+    "鵃騆譸妯轴軸肘疛菷晭睭箒鯞纣伷呪咒宙绉冑咮昼紂胄荮皱酎晝粙葤詋甃",
+    "詶僽皺駎噣縐骤籀籕籒驟帚炿駲朱劯侏诛邾洙茱株珠诸猪硃秼袾铢絑蛛誅",
+    "跦槠潴蝫銖橥諸豬駯鮢鴸瀦櫫櫧鯺鼄蠩竹泏竺炢笁茿烛窋逐笜舳瘃築燭蠋",
+    "躅鱁孎灟曯欘爥蠾丶主宔拄罜陼渚煮煑詝嘱濐麈瞩劚囑斸矚伫佇住助纻苎",
+    "坾杼注贮迬驻壴柱殶炷祝疰眝砫祩竚莇紵紸羜蛀嵀筑註貯跓軴铸筯鉒馵箸",
+    "翥樦鋳駐篫霔麆鑄墸抓檛膼簻髽拽跩专叀専砖專鄟塼嫥瑼甎磗膞颛磚諯蟤",
+    "顓鱄转孨転竱轉灷啭堟蒃瑑腞僎赚撰篆馔篹襈賺譔饌囀籑妆庄妝荘娤桩莊",
+    "梉湷粧装裝樁糚壮壯状狀壵焋漴撞戇庒隹追骓锥錐騅鵻沝坠桘笍娷惴甀缒",
+    "畷硾膇墜赘縋諈醊錣餟礈贅譵轛鑆缀綴宒迍肫窀谆諄衠准埻準綧訰稕凖卓",
+    "拙炪倬捉桌棁涿棳穛穱蠿圴彴汋犳灼叕妰茁斫浊丵浞烵诼酌啄啅娺梲斱晫",
+    "椓琸硺窡罬撯擆斲槕禚諁諑鋜濁篧擢斀斵濯櫡謶镯鐯鵫灂蠗鐲籗鷟籱劅窧",
+    "乲孜茊兹咨姕姿茲栥玆紎赀资淄秶缁谘嗞孳嵫椔湽滋粢葘辎鄑孶禌觜訾貲",
+    "資趑锱稵緇鈭镃龇輜鼒澬諮趦輺錙髭鲻鍿鎡璾頿頾鯔鶅齍鰦蓻仔吇姉姊杍",
+    "矷秄胏呰秭籽耔虸笫梓釨啙紫滓訿榟字自芓茡倳剚恣牸渍眥眦胔胾漬子崰",
+    "橴宗倧综骔堫嵏嵕惾棕猣腙葼朡椶嵸稯綜緃熧緵翪蝬踨踪磫鍐豵蹤騌鬃騣",
+    "鬉鬷鯮鯼鑁总偬捴惣愡揔搃傯蓗摠総縂總鏓纵昮疭倊猔碂粽糉瘲縦錝縱糭",
+    "潈邹驺诹郰陬菆棷棸鄒箃緅諏鄹鲰鯫黀騶齱齺赱走奏揍楱鯐租葅蒩卆足卒",
+    "哫崒崪族傶箤踤踿镞鏃诅阻组俎爼珇祖組詛靻鎺钻躜鑽繤缵纂纉籫纘攥鑚",
+    "厜朘嗺樶蟕纗嶊嘴嶵噿璻栬絊酔最晬祽稡罪辠槜酻蕞醉檇鋷錊檌枠穝尊墫",
+    "壿嶟遵樽繜罇鐏鳟鱒鷷僔噂撙譐捘銌鶎昨秨莋捽椊琢稓筰鈼左佐唨繓作坐",
+    "阼岝岞怍侳祚胙唑座袏做葃葄飵糳咗蓙",
+};
+
+/**
+ * @brief 基本多文种平面码位到排序键的对照表（0表示没有）
+ * @details 拼音表内的汉字为 COLLATION_PINYIN_KEY + 拼音位次（两字节）；其余字符逐字调用一次iconv，
+ *          GBK中有的为 COLLATION_GBK_KEY | GBK编码（三字节）。此后生成排序键只需查表
+ */
+static uint32_t* collationTable(void) {
+    uint32_t* table = calloc(0x10000, sizeof(uint32_t));
+    if (table == NULL) {
+        perror("名称排序：无法建立对照表");
+        return NULL;
+    }
+
+    uint32_t rank = 0;
+    for (size_t row = 0; row < sizeof(PINYIN_ORDER) / sizeof(PINYIN_ORDER[0]); row++) {
+        for (const unsigned char* p = (const unsigned char*)PINYIN_ORDER[row]; *p != '\0'; p += 3) {
+            uint32_t cp = (uint32_t)(p[0] & 0x0F) << 12 | (uint32_t)(p[1] & 0x3F) << 6 | (p[2] & 0x3F);
+            table[cp] = COLLATION_PINYIN_KEY + rank++;
+        }
+    }
+
+#ifndef _WIN32
+    // 拼音表外的字符（标点、全角字母等）退回GBK编码序
+    iconv_t converter = iconv_open("GBK", "UTF-8");
+    if (converter == (iconv_t)-1) {
+        perror("名称排序：无法建立GBK对照表，拼音表外的字符按码位排序");
+        return table;
+    }
+    for (uint32_t cp = 0x80; cp < 0x10000; cp++) {
+        char utf8[3], gbk[4];
+        char* in = utf8;
+        char* out = gbk;
+        size_t in_left, out_left = sizeof(gbk);
+        if ((cp >= 0xD800 && cp < 0xE000) || table[cp] != 0) continue;
+        if (cp < 0x800) {
+            utf8[0] = (char)(0xC0 | cp >> 6);
+            utf8[1] = (char)(0x80 | (cp & 0x3F));
+            in_left = 2;
+        } else {
+            utf8[0] = (char)(0xE0 | cp >> 12);
+            utf8[1] = (char)(0x80 | (cp >> 6 & 0x3F));
+            utf8[2] = (char)(0x80 | (cp & 0x3F));
+            in_left = 3;
+        }
+        iconv(converter, NULL, NULL, NULL, NULL);
+        if (iconv(converter, &in, &in_left, &out, &out_left) != (size_t)-1 && out - gbk == 2) {
+            table[cp] = COLLATION_GBK_KEY | (uint32_t)((unsigned char)gbk[0] << 8 | (unsigned char)gbk[1]);
+        }
+    }
+    iconv_close(converter);
+#endif
+    return table;
+}
+
+/**
+ * @brief 生成名称的排序键
+ * @details 每个字符按对照表写为两字节拼音键（首字节0x80-0xDF）或三字节GBK键（首字节0xE0），
+ *          两者都没有的写为0xFF加原UTF-8字节；ASCII原样保留。各类键的首字节区间不重叠，
+ *          逐字节比较即：ASCII、拼音序的汉字、GBK序的其他字符、码位序的其余字符
+ */
+static size_t collationKey(const uint32_t* table, const char* name, unsigned char* out, size_t cap) {
+    const unsigned char* p = (const unsigned char*)name;
+    size_t length = 0;
+
+    while (*p != '\0') {
+        size_t bytes = *p >= 0xF0 ? 4 : *p >= 0xE0 ? 3 : *p >= 0xC0 ? 2 : 1;
+        uint32_t cp = bytes == 3 ? (uint32_t)(p[0] & 0x0F) << 12 | (uint32_t)(p[1] & 0x3F) << 6 | (p[2] & 0x3F) :
+                      bytes == 2 ? (uint32_t)(p[0] & 0x1F) << 6 | (p[1] & 0x3F) : p[0];
+        for (size_t i = 1; i < bytes; i++) {
+            if (p[i] == '\0') bytes = i;
+        }
+        uint32_t key = table != NULL && bytes <= 3 && cp >= 0x80 ? table[cp] : 0;
+        if (bytes == 1 && cp < 0x80) {
+            if (length + 1 > cap) break;
+            out[length++] = (unsigned char)cp;
+        } else if (key > 0xFFFF) {
+            if (length + 3 > cap) break;
+            out[length++] = (unsigned char)(key >> 16);
+            out[length++] = (unsigned char)(key >> 8);
+            out[length++] = (unsigned char)key;
+        } else if (key != 0) {
+            if (length + 2 > cap) break;
+            out[length++] = (unsigned char)(key >> 8);
+            out[length++] = (unsigned char)key;
+        } else {
+            if (length + bytes + 1 > cap) break;
+            out[length++] = 0xFF;
+            memcpy(out + length, p, bytes);
+            length += bytes;
+        }
+        p += bytes;
+    }
+    return length;
+}
+
+/**
+ * @brief 按排序键前缀做LSD基数排序（每趟16位，稳定），再对前缀相同的段按完整键排序
+ */
+static int sortCollationKeys(struct CollationKey* keys, int count) {
+    struct CollationKey* buffer = malloc(sizeof(struct CollationKey) * (count > 0 ? count : 1));
+    int* buckets = malloc(sizeof(int) * 0x10000);
+    if (buffer == NULL || buckets == NULL) {
+        free(buffer);
+        free(buckets);
+        return -1;
+    }
+
+    struct CollationKey* from = keys;
+    struct CollationKey* to = buffer;
+    for (int shift = 0; shift < 64; shift += 16) {
+        memset(buckets, 0, sizeof(int) * 0x10000);
+        for (int i = 0; i < count; i++) buckets[from[i].prefix >> shift & 0xFFFF]++;
+        for (int b = 0, sum = 0; b < 0x10000; b++) {
+            int n = buckets[b];
+            buckets[b] = sum;
+            sum += n;
+        }
+        for (int i = 0; i < count; i++) to[buckets[from[i].prefix >> shift & 0xFFFF]++] = from[i];
+        struct CollationKey* swap = from;
+        from = to;
+        to = swap;
+    }
+    // 四趟后结果回到keys
+    free(buffer);
+    free(buckets);
+
+    for (int begin = 0, end; begin < count; begin = end) {
+        for (end = begin + 1; end < count && keys[end].prefix == keys[begin].prefix; end++) {}
+        if (end - begin > 1) qsort(keys + begin, end - begin, sizeof(struct CollationKey), compareCollationKeys);
+    }
+    return 0;
+}
+
+/**
+ * @brief 构建名称排序：各节点的排序位次，以及全部节点、各级节点和每个节点的下级按名称排好的序列
+ * @details 排序只在加载时做一次；之后任何下级列表、级别列表直接按序遍历，
+ *          其他结果集按整数位次排序，不再比较字符串
+ */
+int buildCollation(void) {
+    const struct RegionIndex* index = &g_index;
+    int count = index->count;
+    size_t cap = (size_t)count * (MAX_NAME_LENGTH + 1);
+    unsigned char* pool = malloc(cap);
+    struct CollationKey* keys = malloc(sizeof(struct CollationKey) * (count > 0 ? count : 1));
+    int* cursors = malloc(sizeof(int) * (count + 1));
+    uint32_t* table = collationTable();
+
+    freeCollation();
+    g_collation.ranks = malloc(sizeof(uint32_t) * (count > 0 ? count : 1));
+    g_collation.order = malloc(sizeof(int) * (count > 0 ? count : 1));
+    g_collation.levels = malloc(sizeof(int) * (count > 0 ? count : 1));
+    g_collation.child_offsets = malloc(sizeof(int) * (count + 1));
+    g_collation.children = malloc(sizeof(int) * (count > 0 ? count : 1));
+    if (pool == NULL || keys == NULL || cursors == NULL || g_collation.ranks == NULL || g_collation.order == NULL ||
+        g_collation.levels == NULL || g_collation.child_offsets == NULL || g_collation.children == NULL) {
+        perror("名称排序分配失败");
+        free(pool);
+        free(keys);
+        free(cursors);
+        free(table);
+        freeCollation();
+        return -1;
+    }
+
+    size_t used = 0;
+    for (int i = 0; i < count; i++) {
+        size_t length = collationKey(table, index->dfs_nodes[i]->data.name, pool + used, MAX_NAME_LENGTH + 1);
+        uint64_t prefix = 0;
+        for (size_t b = 0; b < 8; b++) prefix = prefix << 8 | (b < length ? pool[used + b] : 0);
+        keys[i] = (struct CollationKey){ prefix, (uint32_t)used, (uint32_t)length, i };
+        used += length;
+    }
+    free(table);
+
+    g_collation_pool = pool;
+    if (sortCollationKeys(keys, count) != 0) {
+        qsort(keys, count, sizeof(struct CollationKey), compareCollationKeys);
+    }
+    uint32_t rank = 0;
+    for (int i = 0; i < count; i++) {
+        if (i > 0 && !collationSameName(&keys[i - 1], &keys[i])) rank++;
+        g_collation.ranks[keys[i].node] = rank;
+        g_collation.order[i] = keys[i].node;
+    }
+    g_collation_pool = NULL;
+    free(pool);
+
+    // 按名称顺序把节点分发到所在级别和上级的段内，各段因此已有序；
+    // 先按DFS序顺序记下各节点的上级与级别（借用keys的空间），分发时不再随机访问节点
+    int* parents = (int*)keys;
+    uint8_t* levels = (uint8_t*)(parents + count);
+    memset(g_collation.level_offsets, 0, sizeof(g_collation.level_offsets));
+    g_collation.child_offsets[0] = 0;
+    for (int i = 0; i < count; i++) {
+        const struct TreeNode* node = index->dfs_nodes[i];
+        int level = node->data.level >= 0 && node->data.level < COLLATION_LEVELS ? node->data.level : 0;
+        parents[i] = node->parent != NULL ? node->parent->dfs_index : -1;
+        levels[i] = (uint8_t)level;
+        g_collation.level_offsets[level + 1]++;
+        g_collation.child_offsets[i + 1] = g_collation.child_offsets[i] + node->child_count;
+    }
+    for (int level = 0; level < COLLATION_LEVELS; level++) {
+        g_collation.level_offsets[level + 1] += g_collation.level_offsets[level];
+    }
+    int level_cursors[COLLATION_LEVELS];
+    memcpy(level_cursors, g_collation.level_offsets, sizeof(level_cursors));
+    memcpy(cursors, g_collation.child_offsets, sizeof(int) * (count + 1));
+    for (int i = 0; i < count; i++) {
+        int node = g_collation.order[i];
+        g_collation.levels[level_cursors[levels[node]]++] = node;
+        if (parents[node] >= 0) g_collation.children[cursors[parents[node]]++] = node;
+    }
+    free(cursors);
+    free(keys);
+
+    g_collation.count = count;
+    __atomic_store_n(&g_collation.ready, 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+/**
+ * @brief 等待后台构建的名称排序完成
+ * @return 0为可用；未构建或构建失败时返回-1
+ */
+static int waitCollation(void) {
+#ifndef _WIN32
+    if (__atomic_load_n(&g_collation.ready, __ATOMIC_ACQUIRE)) return 0;
+    pthread_mutex_lock(&g_collation_lock);
+    while (g_collation_building) pthread_cond_wait(&g_collation_built, &g_collation_lock);
+    pthread_mutex_unlock(&g_collation_lock);
+#endif
+    return __atomic_load_n(&g_collation.ready, __ATOMIC_ACQUIRE) ? 0 : -1;
+}
+
+int sortedChildren(const struct TreeNode* node, const int** children) {
+    if (waitCollation() != 0 || node->dfs_index < 0 || node->dfs_index >= g_collation.count) return -1;
+    *children = g_collation.children + g_collation.child_offsets[node->dfs_index];
+    return node->child_count;
+}
+
+int sortedLevel(int level, const int** nodes) {
+    if (waitCollation() != 0 || level < 0 || level >= COLLATION_LEVELS) return -1;
+    *nodes = g_collation.levels + g_collation.level_offsets[level];
+    return g_collation.level_offsets[level + 1] - g_collation.level_offsets[level];
+}
+
+static int compareRankedNodes(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+int orderNodesByName(int* nodes, int count, int k) {
+    if (k > count) k = count;
+    if (k <= 0) return 0;
+    // 名称排序未就绪时等待构建完成，不返回按其他顺序排列的结果
+    if (waitCollation() != 0) return -1;
+
+    // 位次在高32位、DFS序号在低32位，整数比较即按名称排序，同名时按DFS序；
+    // 结果集大到临时区放不下时改用堆，仍分配失败则报错，不返回未排序的结果
+    size_t mark = scratchMark();
+    uint64_t* heap = NULL;
+    uint64_t* ranked = scratchAlloc(sizeof(uint64_t) * count);
+    if (ranked == NULL) ranked = heap = malloc(sizeof(uint64_t) * count);
+    if (ranked == NULL) {
+        scratchReset(mark);
+        return -1;
+    }
+    for (int i = 0; i < count; i++) {
+        ranked[i] = (uint64_t)g_collation.ranks[nodes[i]] << 32 | (uint32_t)nodes[i];
+    }
+
+    // 只要前k个时先快速选择，再排序这k个
+    int lo = 0, hi = count;
+    while (k < count && hi - lo > 1) {
+        uint64_t pivot = ranked[lo + (hi - lo) / 2];
+        int i = lo, j = hi - 1;
+        while (i <= j) {
+            while (ranked[i] < pivot) i++;
+            while (ranked[j] > pivot) j--;
+            if (i <= j) {
+                uint64_t swap = ranked[i];
+                ranked[i++] = ranked[j];
+                ranked[j--] = swap;
+            }
+        }
+        if (k <= j) {
+            hi = j + 1;
+        } else if (k >= i) {
+            lo = i;
+        } else {
+            break;
+        }
+    }
+    qsort(ranked, k, sizeof(uint64_t), compareRankedNodes);
+    for (int i = 0; i < k; i++) nodes[i] = (int)(uint32_t)ranked[i];
+    free(heap);
+    scratchReset(mark);
+    return k;
+}
+
+void freeCollation(void) {
+    free(g_collation.ranks);
+    free(g_collation.order);
+    free(g_collation.levels);
+    free(g_collation.child_offsets);
+    free(g_collation.children);
+    memset(&g_collation, 0, sizeof(g_collation));
+}
+
+// 7. 区划导航函数组
+/**
+ * @brief 取切片中第i个节点
+ */
+struct TreeNode* sliceNode(const struct NodeSlice* slice, int i) {
+    return slice->dfs != NULL ? currentIndex()->dfs_nodes[slice->dfs[i]] : slice->nodes[i];
+}
+
+/**
+ * @brief 把完整序列截为[offset, offset+limit)一页，limit不大于0时取到末尾
+ */
+static void slicePage(struct NodeSlice* slice, int offset, int limit) {
+    if (offset < 0) offset = 0;
+    if (offset > slice->total) offset = slice->total;
+    slice->count = slice->total - offset;
+    if (limit > 0 && slice->count > limit) slice->count = limit;
+    if (slice->dfs != NULL) {
+        slice->dfs += offset;
+    } else {
+        slice->nodes += offset;
+    }
+}
+
+int navigateChildren(const struct TreeNode* node, int order, int offset, int limit, struct NodeSlice* slice) {
+    const int* sorted;
+    memset(slice, 0, sizeof(*slice));
+
+    // 代码序直接指向子节点区中的指针数组；名称序指向名称排序中该节点的段（未就绪时等待构建完成），
+    // 不可用时报错而不退回代码序，否则跨页请求会混用两种顺序而重复或漏掉
+    if (order == NAV_ORDER_NAME) {
+        if (sortedChildren(node, &sorted) < 0) return -1;
+        slice->dfs = sorted;
+    } else {
+        slice->nodes = (struct TreeNode* const*)node->children;
+    }
+    slice->total = node->child_count;
+    slicePage(slice, offset, limit);
+    return slice->count;
+}
+
+int navigateSiblings(const struct TreeNode* node, int order, int offset, int limit, struct NodeSlice* slice) {
+    if (node->parent == NULL) {
+        memset(slice, 0, sizeof(*slice));
+        return 0;
+    }
+    return navigateChildren(node->parent, order, offset, limit, slice);
+}
+
+int navigateAncestors(const struct TreeNode* node, struct TreeNode** chain, int max_results) {
+    int depth = 0;
+    for (const struct TreeNode* p = node->parent; p != NULL && p->parent != NULL; p = p->parent) depth++;
+    if (depth > max_results) depth = max_results;
+
+    // 自上而下：省级在前，直接上级在最后
+    int i = depth;
+    for (struct TreeNode* p = node->parent; p != NULL && p->parent != NULL && i > 0; p = p->parent) {
+        chain[--i] = p;
+    }
+    return depth;
+}
+
+int parseNavigationQuery(const char* text, struct NavigationQuery* query) {
+    // 代码[,偏移[,code|name]]
+    size_t length = strcspn(text, ",");
+    char* end;
+    if (length == 0 || length >= sizeof(query->code)) return -1;
+    memcpy(query->code, text, length);
+    query->code[length] = '\0';
+    query->offset = 0;
+    query->order = NAV_ORDER_CODE;
+    text += length;
+    if (*text == ',') {
+        long offset = strtol(text + 1, &end, 10);
+        if (end == text + 1 || offset < 0 || offset > MAX_REGIONS) return -1;
+        query->offset = (int)offset;
+        text = end;
+    }
+    if (*text == ',') {
+        if (strcmp(text + 1, "name") == 0) {
+            query->order = NAV_ORDER_NAME;
+        } else if (strcmp(text + 1, "code") != 0) {
+            return -1;
+        }
+        text += strlen(text);
+    }
+    if (*text != '\0') return -1;
+    return validateCode(query->code);
+}
+
+// 8. NUMA副本函数组
+#ifdef __linux__
+/**
+ * @brief 解析CPU列表（如"0-3,8-11"）
+ */
+static void parseCpuList(const char* list, cpu_set_t* set) {
+    CPU_ZERO(set);
+    while (*list) {
+        char* end;
+        long first = strtol(list, &end, 10);
+        if (end == list) break;
+        long last = first;
+        if (*end == '-') {
+            list = end + 1;
+            last = strtol(list, &end, 10);
+        }
+        for (long cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++) {
+            CPU_SET(cpu, set);
+        }
+        list = (*end == ',') ? end + 1 : end;
+        if (*list == '\n') break;
+    }
+}
+
+static int readNodeCpus(int node, cpu_set_t* set) {
+    char path[64], line[1024];
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+    FILE* file = fopen(path, "r");
+    if (file == NULL) return -1;
+    int ok = fgets(line, sizeof(line), file) != NULL;
+    fclose(file);
+    if (!ok) return -1;
+    parseCpuList(line, set);
+    return CPU_COUNT(set) > 0 ? 0 : -1;
+}
+
+/**
+ * @brief 将内存区绑定到指定NUMA节点（直接调用mbind，不依赖libnuma）
+ */
+static int bindArenaToNode(const struct Arena* arena, int node) {
+    unsigned long mask[MAX_NUMA_NODES / (8 * sizeof(unsigned long))] = { 0 };
+    mask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+    return (int)syscall(SYS_mbind, arena->base, arena->size, MPOL_PREFERRED,
+                        mask, (unsigned long)MAX_NUMA_NODES + 1, 0UL);
+}
+#endif
+
+static void* rebasePointer(const void* ptr, const struct Arena* from, const struct Arena* to) {
+    return ptr ? to->base + ((const char*)ptr - from->base) : NULL;
+}
+
+/**
+ * @brief 复制节点区、子节点区与索引区，并将其中指针重定位到副本
+ */
+static int copyReplica(struct IndexReplica* replica) {
+    struct Arena* sources[] = { &g_node_arena, &g_child_arena, &g_index_arena };
+    struct Arena* targets[] = { &replica->nodes, &replica->children, &replica->index };
+
+    for (int i = 0; i < 3; i++) {
+        targets[i]->label = sources[i]->label;
+        if (arenaInit(targets[i], sources[i]->used) != 0) return -1;
+#ifdef __linux__
+        // mbind失败（如容器内无权限）时依赖调用线程已绑定到该节点CPU的首次访问策略
+        bindArenaToNode(targets[i], replica->numa_node);
+#endif
+        memcpy(arenaAlloc(targets[i], sources[i]->used, 1), sources[i]->base, sources[i]->used);
+    }
+
+    struct TreeNode* nodes = (struct TreeNode*)replica->nodes.base;
+    size_t node_count = replica->nodes.used / sizeof(struct TreeNode);
+    for (size_t i = 0; i < node_count; i++) {
+        nodes[i].parent = rebasePointer(nodes[i].parent, &g_node_arena, &replica->nodes);
+        nodes[i].children = rebasePointer(nodes[i].children, &g_child_arena, &replica->children);
+    }
+
+    struct TreeNode** child_slots = (struct TreeNode**)replica->children.base;
+    size_t slot_count = replica->children.used / sizeof(struct TreeNode*);
+    for (size_t i = 0; i < slot_count; i++) {
+        child_slots[i] = rebasePointer(child_slots[i], &g_node_arena, &replica->nodes);
+    }
+
+    struct RegionIndex* view = &replica->view;
+    *view = g_index;
+    view->root = rebasePointer(g_index.root, &g_node_arena, &replica->nodes);
+    view->dfs_nodes = rebasePointer(g_index.dfs_nodes, &g_index_arena, &replica->index);
+    for (int i = 0; i < view->count; i++) {
+        view->dfs_nodes[i] = rebasePointer(view->dfs_nodes[i], &g_node_arena, &replica->nodes);
+    }
+    view->codes.block_base = rebasePointer(g_index.codes.block_base, &g_index_arena, &replica->index);
+    view->codes.block_offset = rebasePointer(g_index.codes.block_offset, &g_index_arena, &replica->index);
+    view->codes.block_bits = rebasePointer(g_index.codes.block_bits, &g_index_arena, &replica->index);
+    view->codes.packed = rebasePointer(g_index.codes.packed, &g_index_arena, &replica->index);
+    view->mph.pilots = rebasePointer(g_index.mph.pilots, &g_index_arena, &replica->index);
+    view->mph.remap = rebasePointer(g_index.mph.remap, &g_index_arena, &replica->index);
+    view->mph.slots = rebasePointer(g_index.mph.slots, &g_index_arena, &replica->index);
+    return 0;
+}
+
+int replicateIndexPerNode(void) {
+#ifdef __linux__
+    if (g_index.root == NULL || !arenaOwns(&g_node_arena, g_index.root)) return 0;
+
+    cpu_set_t original;
+    if (sched_getaffinity(0, sizeof(original), &original) != 0) return 0;
+
+    int replicas = 0, nodes_seen = 0;
+    for (int node = 0; node < MAX_NUMA_NODES; node++) {
+        cpu_set_t cpus;
+        if (readNodeCpus(node, &cpus) == 0) nodes_seen++;
+    }
+    if (nodes_seen < 2) {
+        printf("NUMA副本：仅检测到 %d 个节点，无需复制\n", nodes_seen);
+        return 0;
+    }
+
+    for (int node = 0; node < MAX_NUMA_NODES; node++) {
+        cpu_set_t cpus;
+        if (readNodeCpus(node, &cpus) != 0) continue;
+
+        struct IndexReplica* replica = calloc(1, sizeof(*replica));
+        if (replica == NULL) break;
+        replica->numa_node = node;
+
+        // 在目标节点的CPU上完成复制，使首次访问分配的页也落在本地
+        sched_setaffinity(0, sizeof(cpus), &cpus);
+        if (copyReplica(replica) != 0) {
+            arenaRelease(&replica->nodes);
+            arenaRelease(&replica->children);
+            arenaRelease(&replica->index);
+            free(replica);
+            continue;
+        }
+        g_replicas[node] = replica;
+        replicas++;
+    }
+    sched_setaffinity(0, sizeof(original), &original);
+
+    printf("NUMA副本：已为 %d 个节点建立只读副本\n", replicas);
+    return replicas;
+#else
+    printf("NUMA副本：当前平台不支持\n");
+    return 0;
+#endif
+}
+
+void freeIndexReplicas(void) {
+    for (int node = 0; node < MAX_NUMA_NODES; node++) {
+        struct IndexReplica* replica = g_replicas[node];
+        if (replica == NULL) continue;
+        arenaRelease(&replica->nodes);
+        arenaRelease(&replica->children);
+        arenaRelease(&replica->index);
+        free(replica);
+        g_replicas[node] = NULL;
+    }
+    t_local_index = NULL;
+}
+
+int bindLocalReplica(void) {
+#ifdef __linux__
+    int nodes[MAX_NUMA_NODES], count = 0;
+    for (int node = 0; node < MAX_NUMA_NODES; node++) {
+        if (g_replicas[node] != NULL) nodes[count++] = node;
+    }
+    if (count == 0) return -1;
+
+    // 查询线程在各自入口调用，按调用顺序轮流分到各节点；主线程不绑定，新线程不会继承单一节点的亲和性
+    int node = nodes[__atomic_fetch_add(&g_replica_next, 1, __ATOMIC_RELAXED) % count];
+    struct IndexReplica* replica = g_replicas[node];
+
+    // 固定在该节点CPU上运行，避免迁移到远端后仍访问原副本
+    cpu_set_t cpus;
+    if (readNodeCpus(node, &cpus) == 0) {
+        sched_setaffinity(0, sizeof(cpus), &cpus);
+    }
+    t_local_index = &replica->view;
+    return node;
+#else
+    return -1;
+#endif
+}
+
+static const struct RegionIndex* currentIndex(void) {
+    return t_local_index ? t_local_index : &g_index;
+}
+
+struct TreeNode* localRoot(struct TreeNode* root) {
+    const struct RegionIndex* index = currentIndex();
+    if (root == NULL || root->dfs_index < 0 || index->root == NULL) return root;
+    return index->dfs_nodes[root->dfs_index];
+}
+
+// 9. 并行调度函数组
+#ifndef _WIN32
+static int parallelPop(struct ParallelDeque* deque, int* task) {
+    int found = 0;
+    pthread_mutex_lock(&deque->lock);
+    if (deque->bottom > deque->top) {
+        __atomic_store_n(&deque->bottom, deque->bottom - 1, __ATOMIC_RELAXED);
+        *task = deque->tasks[deque->bottom % PAR_DEQUE_SIZE];
+        found = 1;
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+static int parallelSteal(struct ParallelDeque* deque, int* task) {
+    int found = 0;
+    // 不加锁粗略判空，避免空闲线程在空队列上争锁
+    if (__atomic_load_n(&deque->bottom, __ATOMIC_RELAXED) == __atomic_load_n(&deque->top, __ATOMIC_RELAXED)) {
+        return 0;
+    }
+    pthread_mutex_lock(&deque->lock);
+    if (deque->bottom > deque->top) {
+        *task = deque->tasks[deque->top % PAR_DEQUE_SIZE];
+        __atomic_store_n(&deque->top, deque->top + 1, __ATOMIC_RELAXED);
+        found = 1;
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+static int parallelPush(struct ParallelDeque* deque, int task) {
+    int pushed = 0;
+    pthread_mutex_lock(&deque->lock);
+    if (deque->bottom - deque->top < PAR_DEQUE_SIZE) {
+        deque->tasks[deque->bottom % PAR_DEQUE_SIZE] = task;
+        __atomic_store_n(&deque->bottom, deque->bottom + 1, __ATOMIC_RELAXED);
+        pushed = 1;
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return pushed;
+}
+
+/**
+ * @brief 执行一个子树任务：小子树整段处理，大子树先处理自身再按下级拆分
+ * @details 拆出的任务压入本线程队列底部，本线程后进先出保持局部性，
+ *          空闲线程从顶部窃取较早压入的大块任务
+ */
+static void parallelRunTask(struct ParallelJob* job, int worker, int task) {
+    const struct RegionIndex* index = currentIndex();
+    const struct TreeNode* node = index->dfs_nodes[task];
+
+    if (node->subtree_end - task <= PAR_GRAIN) {
+        job->run(job, worker, task, node->subtree_end);
+        return;
+    }
+
+    job->run(job, worker, task, task + 1);
+    for (int i = 0; i < node->child_count; i++) {
+        int child = node->children[i]->dfs_index;
+        __atomic_add_fetch(&job->pending, 1, __ATOMIC_RELAXED);
+        if (!parallelPush(&g_pool.deques[worker], child)) {
+            parallelRunTask(job, worker, child);
+            __atomic_sub_fetch(&job->pending, 1, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+static void parallelWork(struct ParallelJob* job, int worker) {
+    int task;
+    for (;;) {
+        int found = parallelPop(&g_pool.deques[worker], &task);
+        for (int i = 1; !found && i < g_pool.workers; i++) {
+            found = parallelSteal(&g_pool.deques[(worker + i) % g_pool.workers], &task);
+        }
+
+        if (found) {
+            parallelRunTask(job, worker, task);
+            __atomic_sub_fetch(&job->pending, 1, __ATOMIC_RELEASE);
+        } else if (__atomic_load_n(&job->pending, __ATOMIC_ACQUIRE) == 0) {
+            return;
+        } else {
+            sched_yield();
+        }
+    }
+}
+
+static void* parallelHelperMain(void* arg) {
+    int worker = (int)(intptr_t)arg;
+    unsigned seen = 0;
+
+    bindLocalReplica();
+    pthread_mutex_lock(&g_pool.lock);
+    for (;;) {
+        while (g_pool.generation == seen && !g_pool.stopping) {
+            pthread_cond_wait(&g_pool.wake, &g_pool.lock);
+        }
+        if (g_pool.stopping) break;
+        seen = g_pool.generation;
+
+        // 调用方已收尾的任务不再加入
+        struct ParallelJob* job = g_pool.job;
+        if (job == NULL) continue;
+        g_pool.active++;
+        pthread_mutex_unlock(&g_pool.lock);
+
+        parallelWork(job, worker);
+
+        pthread_mutex_lock(&g_pool.lock);
+        if (--g_pool.active == 0) pthread_cond_broadcast(&g_pool.done);
+    }
+    pthread_mutex_unlock(&g_pool.lock);
+    return NULL;
+}
+
+static void parallelPoolStart(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int workers = cpus < 1 ? 1 : cpus > PAR_MAX_WORKERS ? PAR_MAX_WORKERS : (int)cpus;
+
+    pthread_mutex_init(&g_pool.lock, NULL);
+    pthread_mutex_init(&g_pool.busy, NULL);
+    pthread_cond_init(&g_pool.wake, NULL);
+    pthread_cond_init(&g_pool.done, NULL);
+    for (int i = 0; i < PAR_MAX_WORKERS; i++) {
+        pthread_mutex_init(&g_pool.deques[i].lock, NULL);
+    }
+
+    // 调用线程作为0号工作线程参与执行，只需额外创建workers-1个
+    g_pool.workers = 1;
+    while (g_pool.workers < workers &&
+           pthread_create(&g_pool.threads[g_pool.workers], NULL, parallelHelperMain,
+                          (void*)(intptr_t)g_pool.workers) == 0) {
+        g_pool.workers++;
+    }
+}
+
+int parallelWorkerCount(void) {
+    static pthread_once_t once = PTHREAD_ONCE_INIT;
+    pthread_once(&once, parallelPoolStart);
+    return g_pool.workers;
+}
+
+int parallelForSubtree(struct ParallelJob* job, const struct TreeNode* node) {
+    int workers = parallelWorkerCount();
+    int begin = node->dfs_index;
+    int end = node->subtree_end;
+
+    // 小子树、单核或调度器正被其他查询占用时，在调用线程上整段执行
+    if (begin < 0 || workers < 2 || end - begin <= PAR_GRAIN || pthread_mutex_trylock(&g_pool.busy) != 0) {
+        if (begin < 0) return 0;
+        job->run(job, 0, begin, end);
+        return 1;
+    }
+
+    job->pending = 1;
+    parallelPush(&g_pool.deques[0], begin);
+
+    pthread_mutex_lock(&g_pool.lock);
+    g_pool.job = job;
+    g_pool.generation++;
+    pthread_cond_broadcast(&g_pool.wake);
+    pthread_mutex_unlock(&g_pool.lock);
+
+    parallelWork(job, 0);
+
+    pthread_mutex_lock(&g_pool.lock);
+    while (g_pool.active > 0) {
+        pthread_cond_wait(&g_pool.done, &g_pool.lock);
+    }
+    g_pool.job = NULL;
+    pthread_mutex_unlock(&g_pool.lock);
+
+    pthread_mutex_unlock(&g_pool.busy);
+    return workers;
+}
+
+void parallelShutdown(void) {
+    if (g_pool.workers == 0) return;
+
+    pthread_mutex_lock(&g_pool.lock);
+    g_pool.stopping = 1;
+    pthread_cond_broadcast(&g_pool.wake);
+    pthread_mutex_unlock(&g_pool.lock);
+    for (int i = 1; i < g_pool.workers; i++) {
+        pthread_join(g_pool.threads[i], NULL);
+    }
+    g_pool.workers = 0;
+}
+#else
+int parallelWorkerCount(void) {
+    return 1;
+}
+
+int parallelForSubtree(struct ParallelJob* job, const struct TreeNode* node) {
+    if (node->dfs_index < 0) return 0;
+    job->run(job, 0, node->dfs_index, node->subtree_end);
+    return 1;
+}
+
+void parallelShutdown(void) {
+}
+#endif
+
+// 10. 数据查询函数组
+struct TreeNode* findNodeByCode(struct TreeNode* root, const char* code) {
+    if (root == NULL) return NULL;
+
+    // 已建立代码列时直接定位，并按DFS区间判断是否位于root子树内
+    const struct RegionIndex* index = currentIndex();
+    if (index->codes.count > 0 && root->dfs_index >= 0) {
+        uint64_t value;
+        if (parseCode(code, &value) != 0) return NULL;
+
+        int idx;
+        if (index->mph.table_size > 0) {
+            // 完美哈希对非成员也会给出某个槽位，需核对代码
+            idx = codeMphLookup(&index->mph, value);
+            if (strcmp(index->dfs_nodes[idx]->data.code, code) != 0) return NULL;
+        } else {
+            idx = codeColumnFind(&index->codes, value);
+        }
+        if (idx < root->dfs_index || idx >= root->subtree_end) return NULL;
+        return index->dfs_nodes[idx];
+    }
+
+    if (strcmp(root->data.code, code) == 0) return root;
+
+    for (int i = 0; i < root->child_count; i++) {
+        struct TreeNode* found = findNodeByCode(root->children[i], code);
+        if (found != NULL) return found;
+    }
+    return NULL;
+}
+
+void findByNameRecursive(struct TreeNode* root, const char* name, int* found) {
+    if (root == NULL || *found >= 5) return;
+    
+    if (strstr(root->data.name, name) != NULL) {
+        displayNodeInfo(root, *found > 0);
+        (*found)++;
+        if (*found >= 5) {
+            printf("\n结果过多，仅显示前5条...\n");
+            return;
+        }
+    }
+    
+    for (int i = 0; i < root->child_count; i++) {
+        findByNameRecursive(root->children[i], name, found);
+    }
+}
+
+void findByCode(struct TreeNode* node, const char* code) {
+    if (validateCode(code) != 0) {
+        printf("错误：无效的区划代码格式\n");
+        return;
+    }
+    
+    struct TreeNode* found = findNodeByCode(node, code);
+    if (found) {
+        displayNodeInfo(found, 0);
+    } else {
+        printf("未找到代码为 %s 的地区\n", code);
+    }
+}
+
+void findByName(struct TreeNode* root, const char* name) {
+    if (!root || !name || validateName(name) != 0) {
+        printf("错误：无效的查询名称\n");
+        return;
+    }
+    
+    // 由查询计划选择索引或扫描，结果顺序与递归遍历一致
+    struct TreeNode* results[5];
+    int count = collectByName(root, name, results, 5);
+    for (int i = 0; i < count; i++) {
+        displayNodeInfo(results[i], i > 0);
+    }
+    if (count >= 5) {
+        printf("\n结果过多，仅显示前5条...\n");
+    }
+    
+    if (count == 0) {
+        printf("未找到包含 '%s' 的地区\n", name);
+    } else {
+        printf("\n共找到 %d 个匹配项\n", count);
+    }
+}
+
+static void collectByNameRecursive(struct TreeNode* root, const char* name,
+                                   struct TreeNode** results, int max_results, int* found) {
+    if (root == NULL || *found >= max_results) return;
+
+    if (strstr(root->data.name, name) != NULL) {
+        results[(*found)++] = root;
+    }
+    for (int i = 0; i < root->child_count; i++) {
+        collectByNameRecursive(root->children[i], name, results, max_results, found);
+    }
+}
+
+/**
+ * @brief 并行任务的局部结果区段：记录某个DFS区间的输出在局部缓冲区中的位置
+ */
+struct ParallelSegment {
+    int begin;       ///< 区间起始DFS序号，合并时按此排序
+    int worker;      ///< 所属工作线程（汇总时填写）
+    size_t offset;   ///< 在局部结果中的起始位置
+    size_t length;   ///< 长度
+};
+
+/**
+ * @brief 每个工作线程的局部结果
+ */
+struct ParallelPart {
+    struct QueryOutput out;             ///< 导出行（子树导出）
+    int* matches;                       ///< 匹配节点的DFS序号（名称扫描）
+    size_t match_count;
+    size_t match_capacity;
+    struct ParallelSegment* segments;
+    int segment_count;
+    int segment_capacity;
+};
+
+/**
+ * @brief 子树统计（各工作线程分别累加后合并）
+ */
+struct SubtreeStats {
+    long total;                                           ///< 节点总数
+    long level_count[sizeof(LEVEL_NAMES) / sizeof(LEVEL_NAMES[0])]; ///< 各级节点数
+    long priced;                                          ///< 有平均房价的节点数
+    double price_sum;                                     ///< 平均房价之和
+    long employment;                                      ///< 有就业率的节点数
+};
+
+/**
+ * @brief 名称扫描、子树导出与统计共用的并行上下文
+ */
+struct ParallelContext {
+    struct ParallelPart* parts;     ///< 按工作线程划分
+    const char* name;               ///< 名称扫描的关键字
+    int max_results;                ///< 名称扫描每个区段最多保留的结果数
+    int cutoff;                     ///< 名称扫描：此DFS位置之前已有足够结果，其后不必再扫描（各线程共享）
+    struct SubtreeStats* stats;     ///< 按工作线程划分的统计
+};
+
+static void parallelAddSegment(struct ParallelPart* part, int begin, size_t offset, size_t length) {
+    if (length == 0) return;
+    if (part->segment_count == part->segment_capacity) {
+        int capacity = part->segment_capacity ? part->segment_capacity * 2 : 64;
+        struct ParallelSegment* grown = realloc(part->segments, sizeof(*grown) * capacity);
+        if (grown == NULL) return;
+        part->segments = grown;
+        part->segment_capacity = capacity;
+    }
+    part->segments[part->segment_count++] = (struct ParallelSegment){ begin, 0, offset, length };
+}
+
+static int compareSegments(const void* a, const void* b) {
+    const struct ParallelSegment* x = a;
+    const struct ParallelSegment* y = b;
+    return (x->begin > y->begin) - (x->begin < y->begin);
+}
+
+/**
+ * @brief 汇总各工作线程的区段并按DFS序排序，返回区段数组（在调用线程的临时区）
+ */
+static struct ParallelSegment* parallelGatherSegments(struct ParallelPart* parts, int workers, int* count) {
+    int total = 0;
+    for (int w = 0; w < workers; w++) total += parts[w].segment_count;
+
+    struct ParallelSegment* all = scratchAlloc(sizeof(*all) * (total + 1));
+    *count = 0;
+    if (all == NULL) return NULL;
+    for (int w = 0; w < workers; w++) {
+        for (int i = 0; i < parts[w].segment_count; i++) {
+            all[*count] = parts[w].segments[i];
+            all[*count].worker = w;
+            (*count)++;
+        }
+    }
+    qsort(all, *count, sizeof(*all), compareSegments);
+    return all;
+}
+
+/**
+ * @brief 在调用线程的临时区分配清零的数组（并行任务的分线程结果表等）
+ */
+static void* parallelAllocZeroed(size_t count, size_t size) {
+    void* data = scratchAlloc(count * size);
+    if (data != NULL) memset(data, 0, count * size);
+    return data;
+}
+
+/**
+ * @brief 释放工作线程在执行中扩容的缓冲区；分线程结果表本身在临时区，随调用方重置
+ */
+static void parallelFreeParts(struct ParallelPart* parts, int workers) {
+    for (int w = 0; w < workers; w++) {
+        free(parts[w].out.data);
+        free(parts[w].matches);
+        free(parts[w].segments);
+    }
+}
+
+static void scanNamesRange(struct ParallelJob* job, int worker, int begin, int end) {
+    struct ParallelContext* context = job->context;
+    struct ParallelPart* part = &context->parts[worker];
+    struct TreeNode* const* nodes = currentIndex()->dfs_nodes;
+    size_t start = part->match_count;
+
+    // 结果按DFS序取前max_results个，已知凑满的位置之后的区段不会进入结果
+    int cutoff = __atomic_load_n(&context->cutoff, __ATOMIC_RELAXED);
+    if (end > cutoff) end = cutoff;
+    for (int i = begin; i < end && (int)(part->match_count - start) < context->max_results; i++) {
+        if (strstr(nodes[i]->data.name, context->name) == NULL) continue;
+        if (part->match_count == part->match_capacity) {
+            size_t capacity = part->match_capacity ? part->match_capacity * 2 : 256;
+            int* grown = realloc(part->matches, sizeof(int) * capacity);
+            if (grown == NULL) break;
+            part->matches = grown;
+            part->match_capacity = capacity;
+        }
+        part->matches[part->match_count++] = i;
+    }
+    parallelAddSegment(part, begin, start, part->match_count - start);
+
+    // 本段已凑满时把共享的截止位置前移到最后一个结果之后
+    if ((int)(part->match_count - start) == context->max_results && context->max_results > 0) {
+        int stop = part->matches[part->match_count - 1] + 1;
+        while (stop < cutoff &&
+               !__atomic_compare_exchange_n(&context->cutoff, &cutoff, stop, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        }
+    }
+}
+
+int matchFilter(const struct TreeNode* node, const struct RegionFilter* filter) {
+    if (node->dfs_index < filter->begin || node->dfs_index >= filter->end) return 0;
+    if (filter->level_mask != 0 &&
+        (node->data.level < 0 || node->data.level > 31 || !(filter->level_mask & (1u << node->data.level)))) {
+        return 0;
+    }
+    if (filter->type_count > 0) {
+        int allowed = 0;
+        for (int i = 0; i < filter->type_count && !allowed; i++) allowed = node->data.type == filter->types[i];
+        if (!allowed) return 0;
+    }
+    if (filter->name_equals != NULL && strcmp(node->data.name, filter->name_equals) != 0) return 0;
+    if (filter->name_contains != NULL && strstr(node->data.name, filter->name_contains) == NULL) return 0;
+    return 1;
+}
+
+/**
+ * @brief 把有序倒排链截取到DFS区间[begin, end)
+ */
+static const int* postingRange(const int* postings, int length, int begin, int end, int* count) {
+    int lo = 0, hi = length;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (postings[mid] < begin) lo = mid + 1; else hi = mid;
+    }
+    int first = lo;
+    hi = length;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (postings[mid] < end) lo = mid + 1; else hi = mid;
+    }
+    *count = lo - first;
+    return postings + first;
+}
+
+/**
+ * @brief 候选倒排链更短时改用该访问路径
+ */
+static void considerPath(struct QueryPlan* plan, int path, const struct PostingTable* table, uint64_t key,
+                         const struct RegionFilter* filter) {
+    int length;
+    const int* postings = postingLookup(table, key, &length);
+    int count = 0;
+    const int* candidates = postings ? postingRange(postings, length, filter->begin, filter->end, &count) : NULL;
+
+    long cost = (long)count * PLAN_POSTING_COST;
+    if (cost < plan->cost) {
+        plan->path = path;
+        plan->candidates = candidates;
+        plan->candidate_count = count;
+        plan->cost = cost;
+    }
+}
+
+/**
+ * @brief 按索引统计选择代价最低的访问路径
+ * @details 各索引的倒排链按DFS序排列，截取到子树区间后的长度就是精确的候选数：
+ * - 精确名称：名称哈希的倒排链
+ * - 名称包含：关键字中每个相邻两字（单字关键字用单字）的倒排链取最短者，
+ *   任一片段不存在即可断定无结果
+ * - 级别：单一级别时用该级别的节点数组
+ * 都不优于顺序扫描子树区间时退回扫描
+ */
+void planQuery(const struct RegionFilter* filter, struct QueryPlan* plan) {
+    plan->path = ACCESS_SCAN;
+    plan->candidates = NULL;
+    plan->candidate_count = filter->end - filter->begin;
+    plan->cost = filter->end - filter->begin;
+
+    // 名称索引未构建完成时只能扫描
+    if (!__atomic_load_n(&g_name_index.ready, __ATOMIC_ACQUIRE)) return;
+
+    if (filter->name_equals != NULL) {
+        considerPath(plan, ACCESS_EXACT_NAME, &g_name_index.exact, hashName(filter->name_equals), filter);
+    }
+    if (filter->name_contains != NULL) {
+        uint64_t keys[2 * MAX_NAME_LENGTH];
+        int count = nameGramKeys(filter->name_contains, keys, (int)(sizeof(keys) / sizeof(keys[0])));
+        int has_pairs = 0;
+        for (int k = 0; k < count; k++) has_pairs |= (uint32_t)keys[k] != 0;
+        for (int k = 0; k < count; k++) {
+            // 有两字片段时单字片段不会更短，跳过
+            if (has_pairs && (uint32_t)keys[k] == 0) continue;
+            considerPath(plan, ACCESS_NAME_GRAM, &g_name_index.grams, keys[k], filter);
+        }
+    }
+    // 单一级别时可用该级别的节点数组（多个级别需合并多条链，不如扫描）
+    if (filter->level_mask != 0 && (filter->level_mask & (filter->level_mask - 1)) == 0) {
+        int level = 0;
+        while (!(filter->level_mask & (1u << level))) level++;
+        considerPath(plan, ACCESS_LEVEL, &g_name_index.levels, (uint64_t)level + 1, filter);
+    }
+}
+
+int runQueryPlan(const struct RegionFilter* filter, const struct QueryPlan* plan,
+                 struct TreeNode** results, int max_results) {
+    struct TreeNode* const* nodes = currentIndex()->dfs_nodes;
+    int found = 0;
+
+    if (plan->path == ACCESS_SCAN) {
+        for (int i = filter->begin; i < filter->end && found < max_results; i++) {
+            if (matchFilter(nodes[i], filter)) results[found++] = nodes[i];
+        }
+        return found;
+    }
+
+    for (int i = 0; i < plan->candidate_count && found < max_results; i++) {
+        struct TreeNode* node = nodes[plan->candidates[i]];
+        if (matchFilter(node, filter)) results[found++] = node;
+    }
+    return found;
+}
+
+int collectByName(struct TreeNode* root, const char* name, struct TreeNode** results, int max_results) {
+    int found = 0;
+    const struct RegionIndex* index = currentIndex();
+
+    // 子树在DFS序中连续，顺序扫描节点表即可，结果顺序与递归遍历一致
+    if (root->dfs_index >= 0 && index->root != NULL) {
+        struct RegionFilter filter = { .name_contains = name, .begin = root->dfs_index, .end = root->subtree_end };
+        struct QueryPlan plan;
+
+        // 索引候选比扫描少时按倒排链逐个核对，结果同样按DFS序
+        planQuery(&filter, &plan);
+        if (plan.path != ACCESS_SCAN) {
+            return runQueryPlan(&filter, &plan, results, max_results);
+        }
+
+        int workers = parallelWorkerCount();
+        struct ParallelContext context = { .name = name, .max_results = max_results, .cutoff = root->subtree_end };
+        struct ParallelJob job = { .run = scanNamesRange, .context = &context };
+        size_t mark = scratchMark();
+
+        // 大子树按下级拆分并行扫描，每段最多保留max_results个，合并后按DFS序取前max_results个；
+        // 某段凑满后，位于其后的区段直接跳过
+        context.parts = parallelAllocZeroed(workers, sizeof(struct ParallelPart));
+        if (context.parts != NULL && parallelForSubtree(&job, root) > 0) {
+            int count;
+            struct ParallelSegment* segments = parallelGatherSegments(context.parts, workers, &count);
+            for (int s = 0; segments != NULL && s < count && found < max_results; s++) {
+                const struct ParallelPart* part = &context.parts[segments[s].worker];
+                for (size_t i = 0; i < segments[s].length && found < max_results; i++) {
+                    results[found++] = index->dfs_nodes[part->matches[segments[s].offset + i]];
+                }
+            }
+            parallelFreeParts(context.parts, workers);
+            scratchReset(mark);
+            return found;
+        }
+        scratchReset(mark);
+
+        for (int i = root->dfs_index; i < root->subtree_end && found < max_results; i++) {
+            if (strstr(index->dfs_nodes[i]->data.name, name) != NULL) {
+                results[found++] = index->dfs_nodes[i];
+            }
+        }
+        return found;
+    }
+
+    collectByNameRecursive(root, name, results, max_results, &found);
+    return found;
+}
+
+/**
+ * @brief 格式化节点的层级路径（不含虚拟根节点），如 天津市/市辖区/和平区
+ */
+int formatNodePath(const struct TreeNode* node, char* out, size_t cap) {
+    const struct TreeNode* chain[8];
+    int depth = 0;
+    int length = 0;
+
+    for (const struct TreeNode* current = node; current && current->parent && depth < 8; current = current->parent) {
+        chain[depth++] = current;
+    }
+    out[0] = '\0';
+    for (int i = depth - 1; i >= 0 && length >= 0 && (size_t)length < cap; i--) {
+        length += snprintf(out + length, cap - length, "%s%s", chain[i]->data.name, i > 0 ? "/" : "");
+    }
+    return (length >= 0 && (size_t)length < cap) ? length : -1;
+}
+
+int formatNodeLine(const struct TreeNode* node, char* out, size_t cap) {
+    int length = snprintf(out, cap, "%s\t%s\t%d\t", node->data.code, node->data.name, node->data.level);
+    if (length < 0 || (size_t)length >= cap) return -1;
+
+    int path = formatNodePath(node, out + length, cap - length);
+    return path < 0 ? -1 : length + path;
+}
+
+/**
+ * @brief 为查询输出预留空间
+ * @return 空间足够返回0；定长缓冲区不足时置截断标记并返回-1
+ */
+static int queryOutputReserve(struct QueryOutput* out, size_t extra) {
+    if (out->length + extra + 1 <= out->capacity) return 0;
+    if (!out->growable || out->truncated) {
+        out->truncated = 1;
+        return -1;
+    }
+
+    size_t capacity = out->capacity ? out->capacity : 4096;
+    while (out->length + extra + 1 > capacity) capacity *= 2;
+    char* grown = realloc(out->data, capacity);
+    if (grown == NULL) {
+        out->truncated = 1;
+        return -1;
+    }
+    out->data = grown;
+    out->capacity = capacity;
+    return 0;
+}
+
+/**
+ * @brief 追加一段数据，空间不足时整段放弃
+ */
+static int queryOutputAppend(struct QueryOutput* out, const char* data, size_t length) {
+    if (queryOutputReserve(out, length) != 0) return -1;
+    memcpy(out->data + out->length, data, length);
+    out->length += length;
+    out->data[out->length] = '\0';
+    return 0;
+}
+
+/**
+ * @brief 追加一个节点的结果行；空间不足时截断到完整行
+ */
+static int queryOutputAppendNode(struct QueryOutput* out, const struct TreeNode* node) {
+    char line[MAX_LINE_LENGTH];
+    int length = formatNodeLine(node, line, sizeof(line) - 1);
+    if (length < 0) return -1;
+    line[length++] = '\n';
+    return queryOutputAppend(out, line, (size_t)length);
+}
+
+void queryOutputReset(struct QueryOutput* out) {
+    out->length = 0;
+    out->truncated = 0;
+    if (out->capacity > 0) out->data[0] = '\0';
+}
+
+static void exportRange(struct ParallelJob* job, int worker, int begin, int end) {
+    struct ParallelContext* context = job->context;
+    struct ParallelPart* part = &context->parts[worker];
+    struct TreeNode* const* nodes = currentIndex()->dfs_nodes;
+    size_t start = part->out.length;
+
+    for (int i = begin; i < end; i++) {
+        if (queryOutputAppendNode(&part->out, nodes[i]) != 0) break;
+    }
+    parallelAddSegment(part, begin, start, part->out.length - start);
+}
+
+/**
+ * @brief 并行导出整棵子树，各线程的局部输出按DFS序拼接
+ */
+static void exportSubtree(const struct TreeNode* node, struct QueryOutput* out) {
+    int workers = parallelWorkerCount();
+    size_t mark = scratchMark();
+    struct ParallelContext context = { .parts = parallelAllocZeroed(workers, sizeof(struct ParallelPart)) };
+    struct ParallelJob job = { .run = exportRange, .context = &context };
+    if (context.parts == NULL) return;
+
+    for (int w = 0; w < workers; w++) context.parts[w].out.growable = 1;
+    parallelForSubtree(&job, node);
+
+    int count;
+    struct ParallelSegment* segments = parallelGatherSegments(context.parts, workers, &count);
+    for (int s = 0; segments != NULL && s < count; s++) {
+        const struct QueryOutput* part = &context.parts[segments[s].worker].out;
+        if (queryOutputAppend(out, part->data + segments[s].offset, segments[s].length) != 0) break;
+    }
+    parallelFreeParts(context.parts, workers);
+    scratchReset(mark);
+}
+
+static void statsRange(struct ParallelJob* job, int worker, int begin, int end) {
+    struct SubtreeStats* stats = &((struct ParallelContext*)job->context)->stats[worker];
+    struct TreeNode* const* nodes = currentIndex()->dfs_nodes;
+    int levels = (int)(sizeof(stats->level_count) / sizeof(stats->level_count[0]));
+
+    for (int i = begin; i < end; i++) {
+        const struct Region* data = &nodes[i]->data;
+        stats->total++;
+        if (data->level >= 0 && data->level < levels) stats->level_count[data->level]++;
+        if (hasHousePrice(data)) {
+            stats->priced++;
+            stats->price_sum += *data->avg_house_price;
+        }
+        if (hasEmploymentRate(data)) stats->employment++;
+    }
+}
+
+/**
+ * @brief 并行统计子树，输出每行一项：节点总数、各级数量、房价与就业率样本
+ */
+static void statsSubtree(const struct TreeNode* node, struct QueryOutput* out) {
+    int workers = parallelWorkerCount();
+    size_t mark = scratchMark();
+    struct ParallelContext context = { .stats = parallelAllocZeroed(workers, sizeof(struct SubtreeStats)) };
+    struct ParallelJob job = { .run = statsRange, .context = &context };
+    struct SubtreeStats total = { 0 };
+    char line[128];
+    if (context.stats == NULL) return;
+
+    parallelForSubtree(&job, node);
+    for (int w = 0; w < workers; w++) {
+        total.total += context.stats[w].total;
+        for (size_t l = 0; l < sizeof(total.level_count) / sizeof(total.level_count[0]); l++) {
+            total.level_count[l] += context.stats[w].level_count[l];
+        }
+        total.priced += context.stats[w].priced;
+        total.price_sum += context.stats[w].price_sum;
+        total.employment += context.stats[w].employment;
+    }
+    scratchReset(mark);
+
+    int length = snprintf(line, sizeof(line), "节点总数\t%ld\n", total.total);
+    queryOutputAppend(out, line, (size_t)length);
+    for (size_t l = 0; l < sizeof(total.level_count) / sizeof(total.level_count[0]); l++) {
+        if (total.level_count[l] == 0) continue;
+        length = snprintf(line, sizeof(line), "%s\t%ld\n", LEVEL_NAMES[l], total.level_count[l]);
+        queryOutputAppend(out, line, (size_t)length);
+    }
+    length = snprintf(line, sizeof(line), "平均房价\t%.2f\t%ld\n",
+                      total.priced > 0 ? total.price_sum / total.priced : 0.0, total.priced);
+    queryOutputAppend(out, line, (size_t)length);
+    length = snprintf(line, sizeof(line), "就业率样本\t%ld\n", total.employment);
+    queryOutputAppend(out, line, (size_t)length);
+}
+
+/**
+ * @brief 编译查询语句，结果（或错误信息）留给executeQuery使用
+ */
+static void prepareQuery(struct TreeNode* root, const char* arg, struct PreparedQuery* prepared) {
+    prepared->status = compileQuery(root, arg, &prepared->query, prepared->error, sizeof(prepared->error)) == 0 ?
+                       QUERY_STATUS_OK : QUERY_STATUS_INVALID;
+}
+
+/**
+ * @brief 执行前估算查询代价（预计访问的节点数），用于服务端分类调度和过载保护
+ * @param prepared 非NULL时查询语句编译到这里，随后传给executeQuery，不再重复编译
+ */
+long estimateQueryCost(struct TreeNode* root, int op, const char* arg, int limit, struct PreparedQuery* prepared) {
+    if (op == QUERY_OP_QL) {
+        // 查询语句先编译，代价取计划估算；编译失败的请求很便宜
+        struct PreparedQuery local;
+        if (prepared == NULL) prepared = &local;
+        prepareQuery(root, arg, prepared);
+        if (prepared->status != QUERY_STATUS_OK || prepared->query.explain) return 1;
+        long cost = 1;
+        for (int i = 0; i < prepared->query.term_count; i++) cost += prepared->query.terms[i].plan.cost;
+        return cost;
+    }
+    if (op == QUERY_OP_NAME) {
+        // 名称查询的代价取查询计划的估算：索引候选数，或整张DFS表
+        const struct RegionIndex* index = currentIndex();
+        if (validateName(arg) != 0) return 1;
+        if (index->root == NULL) return MAX_REGIONS;
+
+        struct RegionFilter filter = { .name_contains = arg, .begin = 0, .end = index->count };
+        struct QueryPlan plan;
+        planQuery(&filter, &plan);
+        return plan.cost + 1;
+    }
+    if (op == QUERY_OP_CONVERT) {
+        // 每个代码一次查找，按逗号数计
+        long codes = 1;
+        for (const char* p = arg; *p != '\0'; p++) codes += *p == ',';
+        return codes;
+    }
+    if (op == QUERY_OP_SAMPLE) {
+        // 取所属子树的大小为上界：索引未就绪时需扫描子树，样本数也不会超过它
+        struct SampleSpec spec;
+        struct TreeNode* node;
+        if (parseSampleSpec(arg, &spec) != 0 || (node = findNodeByCode(root, spec.within)) == NULL) return 1;
+        return node->dfs_index >= 0 ? node->subtree_end - node->dfs_index + 1 : 1;
+    }
+    if (op == QUERY_OP_CHILDREN || op == QUERY_OP_SIBLINGS) {
+        // 一页的条数：偏移之后剩余的下级数，不超过条数上限
+        struct NavigationQuery query;
+        struct TreeNode* node;
+        if (parseNavigationQuery(arg, &query) != 0 || (node = findNodeByCode(root, query.code)) == NULL) return 1;
+        if (op == QUERY_OP_SIBLINGS && (node = node->parent) == NULL) return 1;
+        long cost = node->child_count > query.offset ? node->child_count - query.offset : 0;
+        if (limit > 0 && cost > limit) cost = limit;
+        return cost + 1;
+    }
+    if (op == QUERY_OP_CODE || op == QUERY_OP_LOCATE || op == QUERY_OP_NEAREST ||
+        op == QUERY_OP_NEIGHBORS || op == QUERY_OP_ANCESTORS || validateCode(arg) != 0) {
+        return 1;
+    }
+
+    struct TreeNode* node = findNodeByCode(root, arg);
+    if (node == NULL) return 1;
+
+    long cost = node->dfs_index >= 0 ? node->subtree_end - node->dfs_index : MAX_REGIONS;
+    if (limit > 0 && cost > limit) cost = limit;
+    return cost + 1;
+}
+
+int executeQuery(struct TreeNode* root, int op, const char* arg, int limit, struct PreparedQuery* prepared,
+                 struct QueryOutput* out) {
+    struct TreeNode* results[QUERY_MAX_RESULTS];
+    int count = 0;
+
+    queryOutputReset(out);
+
+    if (op == QUERY_OP_QL) {
+        // 估算时已编译的语句直接执行，否则在此编译
+        struct PreparedQuery local;
+        if (prepared == NULL) {
+            prepared = &local;
+            prepareQuery(root, arg, prepared);
+        }
+        if (prepared->status != QUERY_STATUS_OK) {
+            queryOutputAppend(out, prepared->error, strlen(prepared->error));
+            return prepared->status;
+        }
+        if (limit > 0 && limit < prepared->query.limit) prepared->query.limit = limit;
+        return executeCompiledQuery(&prepared->query, out);
+    }
+
+    if (op == QUERY_OP_LOCATE) {
+        // 输出包含该点的最深区划及其各级上级，自上而下
+        struct TreeNode* chain[8];
+        int depth = 0;
+        double lat, lon;
+        if (parseLatLon(arg, &lat, &lon) != 0) return QUERY_STATUS_INVALID;
+        for (struct TreeNode* node = locatePoint(lat, lon); node != NULL && node->parent != NULL && depth < 8;
+             node = node->parent) {
+            chain[depth++] = node;
+        }
+        while (depth > 0 && queryOutputAppendNode(out, chain[--depth]) == 0) {}
+        return out->length > 0 ? QUERY_STATUS_OK : QUERY_STATUS_NOT_FOUND;
+    }
+
+    if (op == QUERY_OP_NEAREST) {
+        // 每行为区划及其质心与查询点的距离（千米），由近到远
+        struct NearestQuery query;
+        double kilometers[QUERY_MAX_RESULTS];
+        struct TreeNode* within = NULL;
+        char line[MAX_LINE_LENGTH];
+        if (parseNearestQuery(arg, &query) != 0) return QUERY_STATUS_INVALID;
+        if (query.within[0] != '\0' && (within = findNodeByCode(root, query.within)) == NULL) {
+            return QUERY_STATUS_NOT_FOUND;
+        }
+        count = nearestRegions(query.lat, query.lon, query.level, within, limit > 0 ? limit : NEAREST_DEFAULT_K,
+                               results, kilometers);
+        for (int i = 0; i < count; i++) {
+            int length = formatNodeLine(results[i], line, sizeof(line) - 32);
+            if (length < 0) continue;
+            length += snprintf(line + length, sizeof(line) - length, "\t%.3f\n", kilometers[i]);
+            if (queryOutputAppend(out, line, (size_t)length) != 0) break;
+        }
+        return count > 0 ? QUERY_STATUS_OK : QUERY_STATUS_NOT_FOUND;
+    }
+
+    if (op == QUERY_OP_CONVERT) {
+        // 逗号分隔的多个代码一次批量查找，每个代码一行，顺序与输入一致
+        char text[QUERY_ARG_MAX];
+        const char* codes[QUERY_ARG_MAX / 2 + 1];
+        int code_count = 0;
+        if (strlen(arg) >= sizeof(text)) return QUERY_STATUS_INVALID;
+        strcpy(text, arg);
+        for (char* p = text; p != NULL;) {
+            char* comma = strchr(p, ',');
+            if (comma != NULL) *comma = '\0';
+            if (*p != '\0') codes[code_count++] = p;
+            p = comma != NULL ? comma + 1 : NULL;
+        }
+        if (code_count == 0) return QUERY_STATUS_INVALID;
+        count = appendConvertedCodes(codes, code_count, out);
+        return count > 0 ? QUERY_STATUS_OK : QUERY_STATUS_NOT_FOUND;
+    }
+
+    if (op == QUERY_OP_SAMPLE) {
+        // 每行为样本区划，末尾附分组代码与类型；条数上限作用于全部样本
+        struct SampleSpec spec;
+        struct SampleResult sample;
+        if (parseSampleSpec(arg, &spec) != 0) return QUERY_STATUS_INVALID;
+        if (sampleRegions(root, &spec, &sample) < 0) return QUERY_STATUS_NOT_FOUND;
+        count = appendSampleLines(&sample, out, limit);
+        freeSampleResult(&sample);
+        return count > 0 ? QUERY_STATUS_OK : QUERY_STATUS_NOT_FOUND;
+    }
+
+    if (op == QUERY_OP_NEIGHBORS) {
+        // 每行为相邻区划及其跳数，按跳数由近到远
+        struct NeighborQuery query;
+        struct TreeNode* source;
+        int hops[QUERY_MAX_RESULTS];
+        char line[MAX_LINE_LENGTH];
+        if (parseNeighborQuery(arg, &query) != 0) return QUERY_STATUS_INVALID;
+        if ((source = findNodeByCode(root, query.code)) == NULL) return QUERY_STATUS_NOT_FOUND;
+        count = regionNeighbors(source, query.hops, query.same_parent, results, hops,
+                                limit > 0 && limit < QUERY_MAX_RESULTS ? limit : QUERY_MAX_RESULTS);
+        for (int i = 0; i < count; i++) {
+            int length = formatNodeLine(results[i], line, sizeof(line) - 16);
+            if (length < 0) continue;
+            length += snprintf(line + length, sizeof(line) - length, "\t%d\n", hops[i]);
+            if (queryOutputAppend(out, line, (size_t)length) != 0) break;
+        }
+        return count > 0 ? QUERY_STATUS_OK : QUERY_STATUS_NOT_FOUND;
+    }
+
+    if (op == QUERY_OP_NAME) {
+        if (validateName(arg) != 0) return QUERY_STATUS_INVALID;
+        if (limit <= 0 || limit > QUERY_MAX_RESULTS) limit = QUERY_MAX_RESULTS;
+        count = collectByName(root, arg, results, limit);
+        for (int i = 0; i < count && queryOutputAppendNode(out, results[i]) == 0; i++) {}
+        return count > 0 ? QUERY_STATUS_OK : QUERY_STATUS_NOT_FOUND;
+    }
+
+    if (op == QUERY_OP_CHILDREN || op == QUERY_OP_SIBLINGS) {
+        // 按页输出切片中的节点，切片直接指向连续存储，不复制
+        struct NavigationQuery query;
+        struct NodeSlice slice;
+        struct TreeNode* node;
+        if (parseNavigationQuery(arg, &query) != 0) return QUERY_STATUS_INVALID;
+        if ((node = findNodeByCode(root, query.code)) == NULL) return QUERY_STATUS_NOT_FOUND;
+        int found = op == QUERY_OP_CHILDREN ? navigateChildren(node, query.order, query.offset, limit, &slice) :
+                    navigateSiblings(node, query.order, query.offset, limit, &slice);
+        if (found < 0) {
+            static const char ORDER_ERROR[] = "名称排序不可用";
+            queryOutputAppend(out, ORDER_ERROR, sizeof(ORDER_ERROR) - 1);
+            return QUERY_STATUS_INVALID;
+        }
+        for (int i = 0; i < slice.count; i++) {
+            if (queryOutputAppendNode(out, sliceNode(&slice, i)) != 0) break;
+        }
+        return QUERY_STATUS_OK;
+    }
+
+    if (op != QUERY_OP_CODE && op != QUERY_OP_SUBTREE && op != QUERY_OP_STATS && op != QUERY_OP_ANCESTORS) {
+        return QUERY_STATUS_INVALID;
+    }
+    if (validateCode(arg) != 0) return QUERY_STATUS_INVALID;
+
+    struct TreeNode* node = findNodeByCode(root, arg);
+    if (node == NULL) return QUERY_STATUS_NOT_FOUND;
+
+    if (op == QUERY_OP_CODE) {
+        queryOutputAppendNode(out, node);
+    } else if (op == QUERY_OP_ANCESTORS) {
+        struct TreeNode* chain[8];
+        int depth = navigateAncestors(node, chain, 8);
+        for (int i = 0; i < depth; i++) {
+            if (queryOutputAppendNode(out, chain[i]) != 0) break;
+        }
+    } else {
+        // 子树导出与统计：DFS区间内的节点，完整导出和统计交给并行调度器
+        const struct RegionIndex* index = currentIndex();
+        if (node->dfs_index < 0 || index->root == NULL) return QUERY_STATUS_INVALID;
+        if (op == QUERY_OP_STATS) {
+            statsSubtree(node, out);
+            return QUERY_STATUS_OK;
+        }
+        if (limit <= 0 || limit >= node->subtree_end - node->dfs_index) {
+            exportSubtree(node, out);
+            return QUERY_STATUS_OK;
+        }
+        for (int i = node->dfs_index; i < node->subtree_end; i++) {
+            if (limit > 0 && i - node->dfs_index >= limit) break;
+            if (queryOutputAppendNode(out, index->dfs_nodes[i]) != 0) break;
+        }
+    }
+    return QUERY_STATUS_OK;
+}
+
+// 11. 代码转换函数组
+static int compareCodeKeys(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 逐个查找一个代码值，返回DFS序号，找不到返回-1
+ */
+static int findCodeValue(const struct RegionIndex* index, uint64_t value) {
+    char code[MAX_CODE_LENGTH];
+    uint64_t limit = g_code_scheme.units[0];
+    if (value >= limit) return -1;
+    formatSchemeCode(value, code);
+    struct TreeNode* node = findNodeByCode(index->root, code);
+    return node != NULL ? node->dfs_index : -1;
+}
+
+int findCodeValues(const uint64_t* values, int count, int* nodes) {
+    const struct RegionIndex* index = currentIndex();
+    const struct CodeColumn* col = &index->codes;
+    int found = 0;
+
+    // 完美哈希逐个O(1)定位；未建代码列（如代码序与DFS序不一致）时逐个查找
+    if (index->mph.table_size > 0 || col->count == 0) {
+        for (int i = 0; i < count; i++) {
+            nodes[i] = findCodeValue(index, values[i]);
+            found += nodes[i] >= 0;
+        }
+        return found;
+    }
+
+    // 按代码排序后顺着代码列归并：每块只解码一次，相邻的查询落在同一块时不再二分定位块
+    size_t mark = scratchMark();
+    int chunk = count < CODE_BATCH_CHUNK ? count : CODE_BATCH_CHUNK;
+    uint64_t* keys = scratchAlloc(sizeof(uint64_t) * (chunk > 0 ? chunk : 1));
+    if (keys == NULL) {
+        scratchReset(mark);
+        return -1;
+    }
+    for (int first = 0; first < count; first += chunk) {
+        int n = count - first < chunk ? count - first : chunk;
+        int sorted = 1, valid = 0;
+        for (int i = 0; i < n; i++) {
+            nodes[first + i] = -1;
+            if (values[first + i] >= CODE_BATCH_MAX_VALUE) {
+                // 超过48位的代码（18位方案）放不进排序键，单独查找
+                nodes[first + i] = findCodeValue(index, values[first + i]);
+                found += nodes[first + i] >= 0;
+                continue;
+            }
+            // 高位为代码、低16位为批内位置
+            keys[valid] = values[first + i] << 16 | (uint64_t)i;
+            if (valid > 0 && keys[valid] < keys[valid - 1]) sorted = 0;
+            valid++;
+        }
+        // 输入多已按代码排好（如整列导出的数据），此时跳过排序
+        if (!sorted) qsort(keys, valid, sizeof(uint64_t), compareCodeKeys);
+
+        uint64_t decoded[CODE_BLOCK_SIZE];
+        int block = -1, block_n = 0;
+        for (int k = 0; k < valid; k++) {
+            uint64_t value = keys[k] >> 16;
+            int pos = (int)(keys[k] & 0xFFFF);
+
+            if (block + 1 < col->block_count && col->block_base[block + 1] <= value) {
+                // 在后续块上二分，定位最后一个首代码不大于目标的块
+                int left = block + 1, right = col->block_count - 1;
+                while (left < right) {
+                    int mid = (left + right + 1) / 2;
+                    if (col->block_base[mid] <= value) {
+                        left = mid;
+                    } else {
+                        right = mid - 1;
+                    }
+                }
+                block = left;
+                decodeCodeValues(col, block, decoded);
+                block_n = col->count - block * CODE_BLOCK_SIZE < CODE_BLOCK_SIZE ?
+                          col->count - block * CODE_BLOCK_SIZE : CODE_BLOCK_SIZE;
+            }
+            if (block < 0) continue;
+
+            int lo = 0, hi = block_n - 1;
+            while (lo <= hi) {
+                int mid = (lo + hi) / 2;
+                if (decoded[mid] == value) {
+                    nodes[first + pos] = block * CODE_BLOCK_SIZE + mid;
+                    found++;
+                    break;
+                }
+                if (decoded[mid] < value) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid - 1;
+                }
+            }
+        }
+    }
+    scratchReset(mark);
+    return found;
+}
+
+int parseConvertCode(const char* text, uint64_t* value) {
+    // 只在12位代码方案下与6位代码互换
+    if (g_code_scheme.total_digits != 12) return -1;
+    if (parseFixedDigits(text, 12, value) == 0) return 12;
+    if (parseFixedDigits(text, LEGACY_CODE_DIGITS, value) == 0) {
+        // 6位代码即12位代码的前6位，其后补0
+        *value *= LEGACY_CODE_SCALE;
+        return LEGACY_CODE_DIGITS;
+    }
+    return -1;
+}
+
+void formatLegacyCode(uint64_t value, char* out) {
+    // 乡级、村级取所在县级（或不设区县的地级）代码
+    value /= LEGACY_CODE_SCALE;
+    for (int i = LEGACY_CODE_DIGITS - 1; i >= 0; i--) {
+        out[i] = (char)('0' + value % 10);
+        value /= 10;
+    }
+    out[LEGACY_CODE_DIGITS] = '\0';
+}
+
+int appendConvertedCodes(const char* const* codes, int count, struct QueryOutput* out) {
+    size_t mark = scratchMark();
+    uint64_t* values = scratchAlloc(sizeof(uint64_t) * (count > 0 ? count : 1));
+    int* nodes = scratchAlloc(sizeof(int) * (count > 0 ? count : 1));
+    char line[MAX_LINE_LENGTH + MAX_CODE_LENGTH + LEGACY_CODE_DIGITS + 4];
+    int converted = 0;
+    if (values == NULL || nodes == NULL) {
+        scratchReset(mark);
+        return -1;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (parseConvertCode(codes[i], &values[i]) < 0) values[i] = UINT64_MAX;
+    }
+    if (findCodeValues(values, count, nodes) < 0) {
+        scratchReset(mark);
+        return -1;
+    }
+
+    // 每行：原文\t12位代码\t6位代码，找不到时后两项为空；
+    // 两种代码都由代码值直接写出，不访问节点，整批只读代码列
+    for (int i = 0; i < count; i++) {
+        size_t length = strlen(codes[i]);
+        if (length > MAX_LINE_LENGTH) length = MAX_LINE_LENGTH;
+        memcpy(line, codes[i], length);
+        line[length++] = '\t';
+        // 全0的6位代码对应虚拟根节点，不算找到
+        if (nodes[i] > 0) {
+            formatSchemeCode(values[i], line + length);
+            length += 12;
+            line[length++] = '\t';
+            formatLegacyCode(values[i], line + length);
+            length += LEGACY_CODE_DIGITS;
+            converted++;
+        } else {
+            line[length++] = '\t';
+        }
+        line[length++] = '\n';
+        queryOutputAppend(out, line, length);
+    }
+    scratchReset(mark);
+    return converted;
+}
+
+// 12. 区划抽样函数组
+/**
+ * @brief 抽样的候选来源：分组节点与按类型划分的目标级别节点，均为有序DFS序号
+ * @details 名称索引就绪时直接指向级别、级别类型倒排链；未就绪时扫描所属子树一次，按同样的形式整理
+ */
+struct SampleSource {
+    const int* groups;
+    int group_count;
+    int single_group;                      ///< 不分组时唯一的分组（所属区划）
+    int types[SAMPLE_MAX_TYPES];           ///< 类型，不按类型分层时只有一项-1
+    const int* typed[SAMPLE_MAX_TYPES];    ///< 各类型的目标级别节点
+    int typed_count[SAMPLE_MAX_TYPES];
+    int type_count;
+    int* owned;                            ///< 扫描得到的分组与候选
+};
+
+static int compareInts(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static int compareTypedNodes(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static int sampleSourceFromIndex(const struct SampleSpec* spec, const struct TreeNode* within, struct SampleSource* source) {
+    int length;
+    const int* postings;
+
+    if (spec->group_level > within->data.level) {
+        postings = postingLookup(&g_name_index.levels, (uint64_t)spec->group_level + 1, &length);
+        source->groups = postingRange(postings, length, within->dfs_index, within->subtree_end, &source->group_count);
+    }
+    if (!spec->by_type) {
+        source->types[0] = -1;
+        source->typed[0] = postingLookup(&g_name_index.levels, (uint64_t)spec->level + 1, &source->typed_count[0]);
+        source->type_count = 1;
+        return 0;
+    }
+
+    // 该级别出现过的类型取自级别类型表的键
+    const struct PostingTable* table = &g_name_index.strata;
+    for (uint32_t slot = 0; table->slots != NULL && slot <= table->mask; slot++) {
+        uint64_t key = table->slots[slot].key;
+        if (key >> 32 != (uint64_t)spec->level + 1) continue;
+        if (source->type_count >= SAMPLE_MAX_TYPES) return -1;
+        source->types[source->type_count++] = (int)(uint32_t)key;
+    }
+    qsort(source->types, source->type_count, sizeof(int), compareInts);
+    for (int t = 0; t < source->type_count; t++) {
+        uint64_t key = (uint64_t)(spec->level + 1) << 32 | (uint32_t)source->types[t];
+        source->typed[t] = postingLookup(table, key, &source->typed_count[t]);
+    }
+    return 0;
+}
+
+static int sampleSourceFromScan(const struct SampleSpec* spec, const struct TreeNode* within, struct SampleSource* source) {
+    const struct RegionIndex* index = currentIndex();
+    int begin = within->dfs_index, end = within->subtree_end;
+    int groups = 0, targets = 0;
+
+    for (int i = begin; i < end; i++) {
+        int level = index->dfs_nodes[i]->data.level;
+        if (level == spec->group_level && level > within->data.level) groups++;
+        if (level == spec->level) targets++;
+    }
+    uint64_t* typed = malloc(sizeof(uint64_t) * (targets + 1));
+    source->owned = malloc(sizeof(int) * (groups + targets + 1));
+    if (typed == NULL || source->owned == NULL) {
+        free(typed);
+        return -1;
+    }
+
+    // 分组与目标节点按DFS序收集；按类型分层时按(类型, DFS序号)排序，各类型各成一段有序序列
+    int* group_nodes = source->owned;
+    int* nodes = source->owned + groups;
+    int g = 0, n = 0;
+    for (int i = begin; i < end; i++) {
+        const struct TreeNode* node = index->dfs_nodes[i];
+        if (node->data.level == spec->group_level && node->data.level > within->data.level) group_nodes[g++] = i;
+        if (node->data.level == spec->level) typed[n++] = (uint64_t)(uint32_t)node->data.type << 32 | (uint32_t)i;
+    }
+    if (spec->group_level > within->data.level) {
+        source->groups = group_nodes;
+        source->group_count = g;
+    }
+    if (spec->by_type) qsort(typed, n, sizeof(uint64_t), compareTypedNodes);
+
+    for (int i = 0; i < n; i++) {
+        int type = spec->by_type ? (int)(typed[i] >> 32) : -1;
+        if (source->type_count == 0 || source->types[source->type_count - 1] != type) {
+            if (source->type_count >= SAMPLE_MAX_TYPES) {
+                free(typed);
+                return -1;
+            }
+            source->types[source->type_count] = type;
+            source->typed[source->type_count] = nodes + i;
+            source->type_count++;
+        }
+        source->typed_count[source->type_count - 1]++;
+        nodes[i] = (int)(uint32_t)typed[i];
+    }
+    free(typed);
+    return 0;
+}
+
+/**
+ * @brief 分层抽样的随机数（splitmix64），每层由种子、分组与类型单独定序，结果与线程调度无关
+ */
+static uint64_t sampleNext(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief 从一层中不放回抽取count个（Floyd算法，O(count)），样本按DFS序写出
+ * @param set 容量为capacity（2的幂，不小于2*count）的临时哈希表
+ */
+static void sampleStratum(const struct SampleSpec* spec, const struct SampleStratum* stratum, int* out,
+                          int* set, int capacity) {
+    int n = stratum->population, k = stratum->count;
+    if (k >= n) {
+        memcpy(out, stratum->candidates, sizeof(int) * n);
+        return;
+    }
+
+    uint64_t state = spec->seed ^ ((uint64_t)(uint32_t)stratum->group << 32 | (uint32_t)(stratum->type + 1));
+    sampleNext(&state);
+    int mask = capacity - 1, chosen = 0;
+    for (int i = 0; i < capacity; i++) set[i] = -1;
+    for (int j = n - k; j < n; j++) {
+        // 在[0, j]中取t，t已抽中时改取j（j此前不可能被抽中）
+        int pick = (int)(((sampleNext(&state) >> 32) * (uint64_t)(j + 1)) >> 32);
+        int slot = (int)(((uint32_t)pick * 0x9E3779B1u) >> 8) & mask;
+        for (; set[slot] >= 0; slot = (slot + 1) & mask) {
+            if (set[slot] == pick) break;
+        }
+        if (set[slot] == pick) {
+            pick = j;
+            for (slot = (int)(((uint32_t)pick * 0x9E3779B1u) >> 8) & mask; set[slot] >= 0; slot = (slot + 1) & mask) {}
+        }
+        set[slot] = pick;
+        out[chosen++] = pick;
+    }
+    qsort(out, k, sizeof(int), compareInts);
+    for (int i = 0; i < k; i++) out[i] = stratum->candidates[out[i]];
+}
+
+/**
+ * @brief 并行抽样：层按分组节点的DFS序排列，交给并行调度器按子树分给工作线程
+ */
+struct SampleJob {
+    const struct SampleSpec* spec;
+    struct SampleResult* result;
+    int* sets;                 ///< 按工作线程划分的哈希表
+    int capacity;              ///< 每线程哈希表容量
+};
+
+/**
+ * @brief 抽取分组节点落在DFS区间[begin, end)内的各层，写入各层预先分好的位置
+ */
+static void sampleRange(struct ParallelJob* job, int worker, int begin, int end) {
+    struct SampleJob* sample = job->context;
+    const struct SampleResult* result = sample->result;
+    int* set = sample->sets + (size_t)worker * sample->capacity;
+
+    int left = 0, right = result->stratum_count;
+    while (left < right) {
+        int mid = (left + right) / 2;
+        if (result->strata[mid].group < begin) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    for (int i = left; i < result->stratum_count && result->strata[i].group < end; i++) {
+        const struct SampleStratum* stratum = &result->strata[i];
+        sampleStratum(sample->spec, stratum, result->nodes + stratum->offset, set, sample->capacity);
+    }
+}
+
+int sampleRegions(struct TreeNode* root, const struct SampleSpec* spec, struct SampleResult* result) {
+    struct SampleSource source;
+    struct TreeNode* within;
+    const struct RegionIndex* index = currentIndex();
+
+    memset(result, 0, sizeof(*result));
+    memset(&source, 0, sizeof(source));
+    if ((within = findNodeByCode(root, spec->within)) == NULL || within->dfs_index < 0) return -1;
+
+    int status = __atomic_load_n(&g_name_index.ready, __ATOMIC_ACQUIRE) ?
+                 sampleSourceFromIndex(spec, within, &source) : sampleSourceFromScan(spec, within, &source);
+    if (status != 0) {
+        free(source.owned);
+        return -1;
+    }
+    if (source.groups == NULL) {
+        source.single_group = within->dfs_index;
+        source.groups = &source.single_group;
+        source.group_count = 1;
+    }
+
+    // 每层 = 一个分组子树 × 一个类型，在有序序列上二分截取即得层内全部节点
+    result->strata = malloc(sizeof(struct SampleStratum) * ((size_t)source.group_count * source.type_count + 1));
+    if (result->strata == NULL) {
+        free(source.owned);
+        return -1;
+    }
+    for (int g = 0; g < source.group_count; g++) {
+        const struct TreeNode* group = index->dfs_nodes[source.groups[g]];
+        for (int t = 0; t < source.type_count; t++) {
+            struct SampleStratum* stratum = &result->strata[result->stratum_count];
+            stratum->candidates = postingRange(source.typed[t], source.typed_count[t], group->dfs_index,
+                                               group->subtree_end, &stratum->population);
+            if (stratum->population == 0) continue;
+            stratum->group = group->dfs_index;
+            stratum->type = source.types[t];
+            stratum->offset = result->node_count;
+            stratum->count = stratum->population < spec->per_stratum ? stratum->population : spec->per_stratum;
+            result->node_count += stratum->count;
+            result->stratum_count++;
+        }
+    }
+
+    struct SampleJob sample = { spec, result, NULL, 16 };
+    while (sample.capacity < 2 * spec->per_stratum) sample.capacity *= 2;
+    result->nodes = malloc(sizeof(int) * (result->node_count + 1));
+    sample.sets = malloc(sizeof(int) * (size_t)sample.capacity * parallelWorkerCount());
+    if (result->nodes == NULL || sample.sets == NULL) {
+        free(sample.sets);
+        free(source.owned);
+        freeSampleResult(result);
+        return -1;
+    }
+
+    // 每层只属于一个分组子树：调度器按下级拆分所属子树，各层由分到其分组节点的工作线程抽取
+    struct ParallelJob job = { .run = sampleRange, .context = &sample };
+    parallelForSubtree(&job, within);
+    free(sample.sets);
+    if (source.owned != NULL) {
+        // 扫描得到的候选随之释放，只有倒排链上的候选在返回后仍有效
+        for (int i = 0; i < result->stratum_count; i++) result->strata[i].candidates = NULL;
+        free(source.owned);
+    }
+    return result->stratum_count;
+}
+
+int parseSampleSpec(const char* text, struct SampleSpec* spec) {
+    // 所属代码,级别,分组级别,每层条数[,按类型[,种子]]
+    long values[5] = { 0, 0, 0, 0, 0 };
+    size_t length = strcspn(text, ",");
+    char* end;
+    if (length == 0 || length >= sizeof(spec->within)) return -1;
+    memcpy(spec->within, text, length);
+    spec->within[length] = '\0';
+    text += length;
+
+    int fields = 0;
+    while (*text == ',' && fields < 4) {
+        values[fields++] = strtol(text + 1, &end, 10);
+        if (end == text + 1) return -1;
+        text = end;
+    }
+    spec->seed = 0;
+    if (*text == ',') {
+        spec->seed = strtoull(text + 1, &end, 10);
+        if (end == text + 1) return -1;
+        text = end;
+    }
+    if (*text != '\0' || fields < 3) return -1;
+    spec->level = (int)values[0];
+    spec->group_level = (int)values[1];
+    spec->per_stratum = (int)values[2];
+    spec->by_type = values[3] != 0;
+    // 级别以当前代码方案的级数为上限
+    if (spec->level < 1 || spec->level > g_code_scheme.level_count || spec->group_level < 0 ||
+        spec->group_level >= spec->level) {
+        return -1;
+    }
+    if (spec->per_stratum < 1 || spec->per_stratum > SAMPLE_MAX_PER_STRATUM) return -1;
+    return validateCode(spec->within);
+}
+
+/**
+ * @brief 输出样本：每行为区划，末尾附所在分组代码与类型
+ */
+int appendSampleLines(const struct SampleResult* result, struct QueryOutput* out, int limit) {
+    struct TreeNode* const* nodes = currentIndex()->dfs_nodes;
+    char line[MAX_LINE_LENGTH];
+    int written = 0;
+
+    for (int s = 0; s < result->stratum_count; s++) {
+        const struct SampleStratum* stratum = &result->strata[s];
+        for (int i = 0; i < stratum->count; i++) {
+            if (limit > 0 && written >= limit) return written;
+            const struct TreeNode* node = nodes[result->nodes[stratum->offset + i]];
+            int length = formatNodeLine(node, line, sizeof(line) - MAX_CODE_LENGTH - 16);
+            if (length < 0) continue;
+            length += snprintf(line + length, sizeof(line) - length, "\t%s\t%d\n",
+                               nodes[stratum->group]->data.code, node->data.type);
+            if (queryOutputAppend(out, line, (size_t)length) != 0) return written;
+            written++;
+        }
+    }
+    return written;
+}
+
+void freeSampleResult(struct SampleResult* result) {
+    free(result->strata);
+    free(result->nodes);
+    memset(result, 0, sizeof(*result));
+}
+
+/**
+ * @brief 命令行分层抽样：结果写入文件（"-"为标准输出）
+ */
+int runSampleCommand(struct TreeNode* root, const char* spec_text, const char* output) {
+    clock_t start = clock();
+    struct SampleSpec spec;
+    struct SampleResult result;
+    struct QueryOutput out = { .growable = 1 };
+
+    if (parseSampleSpec(spec_text, &spec) != 0) {
+        printf("错误：抽样参数应为 所属代码,级别,分组级别,每层条数[,按类型[,种子]]\n");
+        return 1;
+    }
+    if (sampleRegions(root, &spec, &result) < 0) {
+        printf("错误：抽样失败（所属区划不存在或内存不足）\n");
+        return 1;
+    }
+    appendSampleLines(&result, &out, 0);
+
+    FILE* stream = g_result_output ? g_result_output : stdout;
+    FILE* file = strcmp(output, "-") == 0 ? stream : fopen(output, "w");
+    if (file == NULL) {
+        perror("无法创建输出文件");
+        freeSampleResult(&result);
+        free(out.data);
+        return 1;
+    }
+    fwrite(out.data, 1, out.length, file);
+    if (file != stream) {
+        fclose(file);
+    } else {
+        fflush(file);
+    }
+    fprintf(stderr, "分层抽样完成：%d 层，%d 条，耗时 %.0f 毫秒\n",
+            result.stratum_count, result.node_count, (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC);
+    freeSampleResult(&result);
+    free(out.data);
+    return 0;
+}
+
+// 13. 位图函数组
+/**
+ * @brief 追加一个空容器（键须大于已有容器）
+ */
+static struct BitmapContainer* bitmapPushContainer(struct NodeBitmap* bitmap, uint32_t key) {
+    if (bitmap->count == bitmap->capacity) {
+        int capacity = bitmap->capacity ? bitmap->capacity * 2 : 16;
+        struct BitmapContainer* grown = scratchAlloc(sizeof(struct BitmapContainer) * capacity);
+        if (grown == NULL) return NULL;
+        if (bitmap->count > 0) memcpy(grown, bitmap->containers, sizeof(struct BitmapContainer) * bitmap->count);
+        bitmap->containers = grown;
+        bitmap->capacity = capacity;
+    }
+    struct BitmapContainer* container = &bitmap->containers[bitmap->count++];
+    memset(container, 0, sizeof(*container));
+    container->key = key;
+    return container;
+}
+
+/**
+ * @brief 分配一个清零的位图容器数据区
+ */
+static uint64_t* containerAllocWords(void) {
+    uint64_t* words = scratchAlloc(sizeof(uint64_t) * BITMAP_WORDS);
+    if (words != NULL) memset(words, 0, sizeof(uint64_t) * BITMAP_WORDS);
+    return words;
+}
+
+/**
+ * @brief 数组容器转为位图容器
+ */
+static int containerToBits(struct BitmapContainer* container) {
+    uint64_t* words = containerAllocWords();
+    if (words == NULL) return -1;
+    for (int i = 0; i < container->cardinality; i++) {
+        words[container->values[i] >> 6] |= 1ull << (container->values[i] & 63);
+    }
+    container->values = NULL;
+    container->words = words;
+    container->kind = BITMAP_CONTAINER_BITS;
+    return 0;
+}
+
+/**
+ * @brief 位图容器元素不多时转回数组容器
+ */
+static void containerNormalize(struct BitmapContainer* container) {
+    if (container->kind != BITMAP_CONTAINER_BITS || container->cardinality > BITMAP_ARRAY_MAX) return;
+    uint16_t* values = scratchAlloc(sizeof(uint16_t) * (container->cardinality ? container->cardinality : 1));
+    if (values == NULL) return;
+
+    int n = 0;
+    for (int w = 0; w < BITMAP_WORDS; w++) {
+        for (uint64_t bits = container->words[w]; bits; bits &= bits - 1) {
+            values[n++] = (uint16_t)(w * 64 + CTZ64(bits));
+        }
+    }
+    container->words = NULL;
+    container->values = values;
+    container->capacity = container->cardinality;
+    container->kind = BITMAP_CONTAINER_ARRAY;
+}
+
+int bitmapAdd(struct NodeBitmap* bitmap, uint32_t value) {
+    uint32_t key = value >> 16;
+    uint16_t low = (uint16_t)value;
+    struct BitmapContainer* container = bitmap->count ? &bitmap->containers[bitmap->count - 1] : NULL;
+
+    if (container == NULL || container->key != key) {
+        container = bitmapPushContainer(bitmap, key);
+        if (container == NULL) return -1;
+    }
+
+    if (container->kind == BITMAP_CONTAINER_BITS) {
+        uint64_t bit = 1ull << (low & 63);
+        if (!(container->words[low >> 6] & bit)) {
+            container->words[low >> 6] |= bit;
+            container->cardinality++;
+        }
+        return 0;
+    }
+
+    // 数组容器按升序追加，重复值忽略
+    if (container->cardinality > 0 && container->values[container->cardinality - 1] >= low) return 0;
+    if (container->cardinality == BITMAP_ARRAY_MAX) {
+        if (containerToBits(container) != 0) return -1;
+        container->words[low >> 6] |= 1ull << (low & 63);
+        container->cardinality++;
+        return 0;
+    }
+    if (container->cardinality == container->capacity) {
+        int capacity = container->capacity ? container->capacity * 2 : 64;
+        if (capacity > BITMAP_ARRAY_MAX) capacity = BITMAP_ARRAY_MAX;
+        uint16_t* grown = scratchAlloc(sizeof(uint16_t) * capacity);
+        if (grown == NULL) return -1;
+        if (container->cardinality > 0) memcpy(grown, container->values, sizeof(uint16_t) * container->cardinality);
+        container->values = grown;
+        container->capacity = capacity;
+    }
+    container->values[container->cardinality++] = low;
+    return 0;
+}
+
+int bitmapAddRange(struct NodeBitmap* bitmap, uint32_t begin, uint32_t end) {
+    while (begin < end) {
+        uint32_t key = begin >> 16;
+        uint32_t chunk_end = (key + 1) << 16;
+        if (chunk_end > end) chunk_end = end;
+        int n = (int)(chunk_end - begin);
+
+        // 与末尾容器同键或区间较小时逐个追加，否则直接置位整段
+        if ((bitmap->count > 0 && bitmap->containers[bitmap->count - 1].key == key) || n <= BITMAP_ARRAY_MAX) {
+            for (uint32_t v = begin; v < chunk_end; v++) {
+                if (bitmapAdd(bitmap, v) != 0) return -1;
+            }
+        } else {
+            struct BitmapContainer* container = bitmapPushContainer(bitmap, key);
+            if (container == NULL) return -1;
+            container->words = containerAllocWords();
+            if (container->words == NULL) {
+                bitmap->count--;
+                return -1;
+            }
+            container->kind = BITMAP_CONTAINER_BITS;
+            container->cardinality = n;
+            for (uint32_t low = begin & 0xFFFF; low < (begin & 0xFFFF) + (uint32_t)n; ) {
+                if ((low & 63) == 0 && low + 64 <= (begin & 0xFFFF) + (uint32_t)n) {
+                    container->words[low >> 6] = ~0ull;
+                    low += 64;
+                } else {
+                    container->words[low >> 6] |= 1ull << (low & 63);
+                    low++;
+                }
+            }
+        }
+        begin = chunk_end;
+    }
+    return 0;
+}
+
+/**
+ * @brief 两个同键容器做集合运算，结果为空时返回0
+ * @return 结果元素数，内存不足返回-1
+ */
+static int containerCombine(const struct BitmapContainer* a, const struct BitmapContainer* b, int op,
+                            struct BitmapContainer* out) {
+    memset(out, 0, sizeof(*out));
+    out->key = a->key;
+
+    // 交集可交换：统一为数组在前
+    if (op == BITMAP_AND && a->kind == BITMAP_CONTAINER_BITS && b->kind == BITMAP_CONTAINER_ARRAY) {
+        const struct BitmapContainer* t = a;
+        a = b;
+        b = t;
+    }
+
+    if (a->kind == BITMAP_CONTAINER_ARRAY && b->kind == BITMAP_CONTAINER_ARRAY) {
+        // 两个有序数组归并
+        int capacity = op == BITMAP_OR ? a->cardinality + b->cardinality : a->cardinality;
+        out->values = scratchAlloc(sizeof(uint16_t) * (capacity ? capacity : 1));
+        if (out->values == NULL) return -1;
+        out->capacity = capacity;
+        int i = 0, j = 0, n = 0;
+        while (i < a->cardinality && j < b->cardinality) {
+            uint16_t x = a->values[i], y = b->values[j];
+            if (x == y) {
+                if (op != BITMAP_ANDNOT) out->values[n++] = x;
+                i++;
+                j++;
+            } else if (x < y) {
+                if (op != BITMAP_AND) out->values[n++] = x;
+                i++;
+            } else {
+                if (op == BITMAP_OR) out->values[n++] = y;
+                j++;
+            }
+        }
+        if (op != BITMAP_AND) {
+            while (i < a->cardinality) out->values[n++] = a->values[i++];
+        }
+        if (op == BITMAP_OR) {
+            while (j < b->cardinality) out->values[n++] = b->values[j++];
+        }
+        out->cardinality = n;
+        if (n > BITMAP_ARRAY_MAX && containerToBits(out) != 0) return -1;
+        return n;
+    }
+
+    if (a->kind == BITMAP_CONTAINER_ARRAY && op != BITMAP_OR) {
+        // 数组按位图逐个过滤
+        out->values = scratchAlloc(sizeof(uint16_t) * (a->cardinality ? a->cardinality : 1));
+        if (out->values == NULL) return -1;
+        out->capacity = a->cardinality;
+        int n = 0;
+        for (int i = 0; i < a->cardinality; i++) {
+            uint16_t v = a->values[i];
+            int present = (b->words[v >> 6] >> (v & 63)) & 1;
+            if (present == (op == BITMAP_AND)) out->values[n++] = v;
+        }
+        out->cardinality = n;
+        return n;
+    }
+
+    // 其余情况在位图上逐字运算
+    out->words = containerAllocWords();
+    if (out->words == NULL) return -1;
+    out->kind = BITMAP_CONTAINER_BITS;
+    if (a->kind == BITMAP_CONTAINER_BITS) {
+        memcpy(out->words, a->words, sizeof(uint64_t) * BITMAP_WORDS);
+    } else {
+        for (int i = 0; i < a->cardinality; i++) out->words[a->values[i] >> 6] |= 1ull << (a->values[i] & 63);
+    }
+    if (b->kind == BITMAP_CONTAINER_BITS) {
+        for (int w = 0; w < BITMAP_WORDS; w++) {
+            if (op == BITMAP_AND) out->words[w] &= b->words[w];
+            else if (op == BITMAP_OR) out->words[w] |= b->words[w];
+            else out->words[w] &= ~b->words[w];
+        }
+    } else {
+        for (int i = 0; i < b->cardinality; i++) {
+            uint64_t bit = 1ull << (b->values[i] & 63);
+            if (op == BITMAP_OR) out->words[b->values[i] >> 6] |= bit;
+            else out->words[b->values[i] >> 6] &= ~bit;
+        }
+    }
+    int n = 0;
+    for (int w = 0; w < BITMAP_WORDS; w++) n += POPCOUNT64(out->words[w]);
+    out->cardinality = n;
+    containerNormalize(out);
+    return n;
+}
+
+/**
+ * @brief 复制一个容器（并集、差集中只出现在一侧的容器）
+ */
+static int containerCopy(const struct BitmapContainer* source, struct BitmapContainer* out) {
+    *out = *source;
+    out->values = NULL;
+    out->words = NULL;
+    if (source->kind == BITMAP_CONTAINER_BITS) {
+        out->words = scratchAlloc(sizeof(uint64_t) * BITMAP_WORDS);
+        if (out->words == NULL) return -1;
+        memcpy(out->words, source->words, sizeof(uint64_t) * BITMAP_WORDS);
+    } else {
+        out->capacity = source->cardinality;
+        out->values = scratchAlloc(sizeof(uint16_t) * (source->cardinality ? source->cardinality : 1));
+        if (out->values == NULL) return -1;
+        memcpy(out->values, source->values, sizeof(uint16_t) * source->cardinality);
+    }
+    return 0;
+}
+
+int bitmapCombine(const struct NodeBitmap* a, const struct NodeBitmap* b, int op, struct NodeBitmap* out) {
+    int i = 0, j = 0;
+
+    memset(out, 0, sizeof(*out));
+    // 按容器键归并，只对同键容器做实际运算
+    while (i < a->count || j < b->count) {
+        const struct BitmapContainer* x = i < a->count ? &a->containers[i] : NULL;
+        const struct BitmapContainer* y = j < b->count ? &b->containers[j] : NULL;
+        struct BitmapContainer result = { 0 };
+        int keep;
+
+        if (x && y && x->key == y->key) {
+            keep = containerCombine(x, y, op, &result);
+            i++;
+            j++;
+        } else if (x && (!y || x->key < y->key)) {
+            keep = op == BITMAP_AND ? 0 : (containerCopy(x, &result) == 0 ? 1 : -1);
+            i++;
+        } else {
+            keep = op == BITMAP_OR ? (containerCopy(y, &result) == 0 ? 1 : -1) : 0;
+            j++;
+        }
+
+        if (keep < 0) return -1;
+        if (keep == 0) continue;
+        struct BitmapContainer* slot = bitmapPushContainer(out, result.key);
+        if (slot == NULL) return -1;
+        *slot = result;
+    }
+    return 0;
+}
+
+long bitmapCardinality(const struct NodeBitmap* bitmap) {
+    long total = 0;
+    for (int c = 0; c < bitmap->count; c++) total += bitmap->containers[c].cardinality;
+    return total;
+}
+
+int bitmapToArray(const struct NodeBitmap* bitmap, int* out, int max_values) {
+    int n = 0;
+
+    for (int c = 0; c < bitmap->count && n < max_values; c++) {
+        const struct BitmapContainer* container = &bitmap->containers[c];
+        int high = (int)container->key << 16;
+        if (container->kind == BITMAP_CONTAINER_ARRAY) {
+            for (int i = 0; i < container->cardinality && n < max_values; i++) out[n++] = high | container->values[i];
+            continue;
+        }
+        for (int w = 0; w < BITMAP_WORDS && n < max_values; w++) {
+            for (uint64_t bits = container->words[w]; bits && n < max_values; bits &= bits - 1) {
+                out[n++] = high | (w * 64 + CTZ64(bits));
+            }
+        }
+    }
+    return n;
+}
+
+// 14. 查询语言函数组
+/**
+ * @brief 查询语句词法单元
+ */
+enum QlTokenKind {
+    QL_TOKEN_END,     ///< 语句结束
+    QL_TOKEN_WORD,    ///< 关键字或字段名
+    QL_TOKEN_NUMBER,  ///< 数字（含12位代码）
+    QL_TOKEN_STRING,  ///< 双引号字符串
+    QL_TOKEN_SYMBOL   ///< ( ) , = < > <= >=
+};
+
+struct QlToken {
+    int kind;                     ///< 词法类型（QlTokenKind）
+    char text[MAX_NAME_LENGTH];   ///< 内容（字符串已去引号和转义）
+};
+
+/**
+ * @brief 查询语句解析状态
+ */
+struct QlParser {
+    const char* p;           ///< 当前位置
+    struct QlToken token;    ///< 当前词法单元
+    char* error;             ///< 错误信息缓冲区
+    size_t error_cap;
+};
+
+static int qlFail(struct QlParser* parser, const char* message) {
+    if (parser->token.kind == QL_TOKEN_END) {
+        snprintf(parser->error, parser->error_cap, "%s（语句意外结束）", message);
+    } else {
+        snprintf(parser->error, parser->error_cap, "%s（位于 \"%s\"）", message, parser->token.text);
+    }
+    return -1;
+}
+
+static int qlNext(struct QlParser* parser) {
+    struct QlToken* token = &parser->token;
+    const char* p = parser->p;
+    size_t length = 0;
+
+    while (isspace((unsigned char)*p)) p++;
+    token->text[0] = '\0';
+
+    if (*p == '\0') {
+        token->kind = QL_TOKEN_END;
+    } else if (*p == '"') {
+        token->kind = QL_TOKEN_STRING;
+        for (p++; *p && *p != '"'; p++) {
+            if (*p == '\\' && p[1]) p++;
+            if (length + 1 >= sizeof(token->text)) return qlFail(parser, "字符串过长");
+            token->text[length++] = *p;
+        }
+        if (*p != '"') return qlFail(parser, "字符串缺少结束引号");
+        p++;
+    } else if (isdigit((unsigned char)*p)) {
+        token->kind = QL_TOKEN_NUMBER;
+        while (isdigit((unsigned char)*p) && length + 1 < sizeof(token->text)) token->text[length++] = *p++;
+    } else if (isalpha((unsigned char)*p) || *p == '_') {
+        token->kind = QL_TOKEN_WORD;
+        while ((isalnum((unsigned char)*p) || *p == '_') && length + 1 < sizeof(token->text)) {
+            token->text[length++] = (char)tolower((unsigned char)*p++);
+        }
+    } else if (strchr("(),=<>", *p)) {
+        token->kind = QL_TOKEN_SYMBOL;
+        token->text[length++] = *p++;
+        if ((token->text[0] == '<' || token->text[0] == '>') && *p == '=') token->text[length++] = *p++;
+    } else {
+        // 报错时带上完整的UTF-8字符（名称需要加引号）
+        token->kind = QL_TOKEN_SYMBOL;
+        token->text[length++] = *p++;
+        while (((unsigned char)*p & 0xC0) == 0x80 && length < 4) token->text[length++] = *p++;
+        token->text[length] = '\0';
+        return qlFail(parser, "无法识别的字符，名称请加双引号");
+    }
+
+    token->text[length] = '\0';
+    parser->p = p;
+    return 0;
+}
+
+static int qlIsWord(const struct QlParser* parser, const char* word) {
+    return parser->token.kind == QL_TOKEN_WORD && strcmp(parser->token.text, word) == 0;
+}
+
+static int qlIsSymbol(const struct QlParser* parser, const char* symbol) {
+    return parser->token.kind == QL_TOKEN_SYMBOL && strcmp(parser->token.text, symbol) == 0;
+}
+
+static int qlExpectSymbol(struct QlParser* parser, const char* symbol) {
+    if (!qlIsSymbol(parser, symbol)) {
+        char message[32];
+        snprintf(message, sizeof(message), "此处应为 '%s'", symbol);
+        return qlFail(parser, message);
+    }
+    return qlNext(parser);
+}
+
+static int qlNumber(struct QlParser* parser, long* value) {
+    if (parser->token.kind != QL_TOKEN_NUMBER) return qlFail(parser, "此处应为数字");
+    *value = strtol(parser->token.text, NULL, 10);
+    return qlNext(parser);
+}
+
+/**
+ * @brief 解析数值列表：= n 或 IN (n, ...)
+ */
+static int qlNumberList(struct QlParser* parser, long* values, int max_values, int* count) {
+    *count = 0;
+    if (qlIsSymbol(parser, "=")) {
+        if (qlNext(parser) != 0) return -1;
+        *count = 1;
+        return qlNumber(parser, &values[0]);
+    }
+    if (!qlIsWord(parser, "in")) return qlFail(parser, "此处应为 '=' 或 IN");
+    if (qlNext(parser) != 0 || qlExpectSymbol(parser, "(") != 0) return -1;
+    for (;;) {
+        if (*count >= max_values) return qlFail(parser, "列表过长");
+        if (qlNumber(parser, &values[(*count)++]) != 0) return -1;
+        if (qlIsSymbol(parser, ")")) return qlNext(parser);
+        if (qlExpectSymbol(parser, ",") != 0) return -1;
+    }
+}
+
+/**
+ * @brief 把代码解析为DFS区间，与已有区间求交
+ */
+static int qlRestrictToCode(struct QlParser* parser, struct TreeNode* root, struct RegionFilter* filter, int node_only) {
+    if (parser->token.kind != QL_TOKEN_NUMBER && parser->token.kind != QL_TOKEN_STRING) {
+        return qlFail(parser, "此处应为区划代码");
+    }
+    struct TreeNode* node = validateCode(parser->token.text) == 0 ? findNodeByCode(root, parser->token.text) : NULL;
+    if (node == NULL || node->dfs_index < 0) return qlFail(parser, "区划代码不存在");
+
+    int begin = node->dfs_index;
+    int end = node_only ? begin + 1 : node->subtree_end;
+    if (begin > filter->begin) filter->begin = begin;
+    if (end < filter->end) filter->end = end;
+    // 区间不相交时结果为空
+    if (filter->end < filter->begin) filter->end = filter->begin;
+    return qlNext(parser);
+}
+
+static int qlPredicate(struct QlParser* parser, struct TreeNode* root, struct QueryTerm* term) {
+    struct RegionFilter* filter = &term->filter;
+    long values[FILTER_MAX_TYPES];
+    int count;
+
+    if (qlIsWord(parser, "name")) {
+        if (qlNext(parser) != 0) return -1;
+        int contains = qlIsWord(parser, "contains");
+        if (!contains && !qlIsSymbol(parser, "=")) return qlFail(parser, "此处应为 CONTAINS 或 '='");
+        if (qlNext(parser) != 0) return -1;
+        if (parser->token.kind != QL_TOKEN_STRING) return qlFail(parser, "此处应为带引号的名称");
+        if (validateName(parser->token.text) != 0) return qlFail(parser, "名称无效");
+
+        char* target = contains ? term->contains : term->equals;
+        if (target[0] != '\0') return qlFail(parser, "同类名称条件只能出现一次");
+        memcpy(target, parser->token.text, strlen(parser->token.text) + 1);
+        if (contains) filter->name_contains = target; else filter->name_equals = target;
+        return qlNext(parser);
+    }
+
+    if (qlIsWord(parser, "level")) {
+        uint32_t mask = 0;
+        if (qlNext(parser) != 0) return -1;
+        if (qlIsSymbol(parser, "<") || qlIsSymbol(parser, "<=") || qlIsSymbol(parser, ">") || qlIsSymbol(parser, ">=")) {
+            char op[3];
+            long level;
+            memcpy(op, parser->token.text, sizeof(op));
+            if (qlNext(parser) != 0 || qlNumber(parser, &level) != 0) return -1;
+            for (long l = 0; l < 32; l++) {
+                int match = op[0] == '<' ? (op[1] ? l <= level : l < level) : (op[1] ? l >= level : l > level);
+                if (match) mask |= 1u << l;
+            }
+        } else {
+            if (qlNumberList(parser, values, FILTER_MAX_TYPES, &count) != 0) return -1;
+            for (int i = 0; i < count; i++) {
+                if (values[i] >= 0 && values[i] < 32) mask |= 1u << values[i];
+            }
+        }
+        // 多个级别条件取交集；交集为空时用不存在的高位表示无结果
+        filter->level_mask = filter->level_mask ? filter->level_mask & mask : mask;
+        if (filter->level_mask == 0) filter->level_mask = 1u << 31;
+        return 0;
+    }
+
+    if (qlIsWord(parser, "type")) {
+        if (filter->type_count > 0) return qlFail(parser, "类型条件只能出现一次");
+        if (qlNext(parser) != 0 || qlNumberList(parser, values, FILTER_MAX_TYPES, &count) != 0) return -1;
+        for (int i = 0; i < count; i++) filter->types[i] = (int)values[i];
+        filter->type_count = count;
+        return 0;
+    }
+
+    if (qlIsWord(parser, "code")) {
+        if (qlNext(parser) != 0 || qlExpectSymbol(parser, "=") != 0) return -1;
+        return qlRestrictToCode(parser, root, filter, 1);
+    }
+
+    return qlFail(parser, "未知条件，可用 name / level / type / code");
+}
+
+static int qlReturnList(struct QlParser* parser, struct CompiledQuery* query) {
+    query->field_count = 0;
+    for (;;) {
+        int field = -1;
+        for (int f = 0; f < QUERY_FIELD_COUNT; f++) {
+            if (qlIsWord(parser, QUERY_FIELD_NAMES[f])) field = f;
+        }
+        if (field < 0) return qlFail(parser, "未知字段，可用 code/name/level/type/path/parent/price/employment");
+        if (query->field_count >= QL_MAX_FIELDS) return qlFail(parser, "RETURN字段过多");
+        query->fields[query->field_count++] = field;
+        if (qlNext(parser) != 0) return -1;
+        if (!qlIsSymbol(parser, ",")) return 0;
+        if (qlNext(parser) != 0) return -1;
+    }
+}
+
+/**
+ * @brief 解析一个子查询的条件部分：pred AND pred ...（可省略）
+ */
+static int qlTerm(struct QlParser* parser, struct CompiledQuery* query, int set_op) {
+    if (query->term_count >= QL_MAX_TERMS) return qlFail(parser, "子查询过多");
+    struct QueryTerm* term = &query->terms[query->term_count++];
+    term->set_op = set_op;
+    term->filter.begin = query->root->dfs_index;
+    term->filter.end = query->root->subtree_end;
+
+    static const char* clauses[] = { "under", "limit", "return", "order", "union", "intersect", "except" };
+    if (parser->token.kind != QL_TOKEN_WORD) return 0;
+    for (size_t c = 0; c < sizeof(clauses) / sizeof(clauses[0]); c++) {
+        if (qlIsWord(parser, clauses[c])) return 0;
+    }
+    for (;;) {
+        if (qlPredicate(parser, query->root, term) != 0) return -1;
+        if (!qlIsWord(parser, "and")) return 0;
+        if (qlNext(parser) != 0) return -1;
+    }
+}
+
+int compileQuery(struct TreeNode* root, const char* text, struct CompiledQuery* query, char* error, size_t error_cap) {
+    const struct RegionIndex* index = currentIndex();
+    struct QlParser parser = { .p = text, .error = error, .error_cap = error_cap };
+
+    memset(query, 0, sizeof(*query));
+    query->root = root;
+    query->limit = QL_DEFAULT_LIMIT;
+    query->fields[0] = QUERY_FIELD_CODE;
+    query->fields[1] = QUERY_FIELD_NAME;
+    query->fields[2] = QUERY_FIELD_LEVEL;
+    query->fields[3] = QUERY_FIELD_PATH;
+    query->field_count = 4;
+    if (root == NULL || root->dfs_index < 0 || index->root == NULL) {
+        snprintf(error, error_cap, "索引未建立");
+        return -1;
+    }
+
+    if (qlNext(&parser) != 0) return -1;
+    if (qlIsWord(&parser, "explain")) {
+        query->explain = 1;
+        if (qlNext(&parser) != 0) return -1;
+    } else if (qlIsWord(&parser, "count")) {
+        query->count_only = 1;
+        if (qlNext(&parser) != 0) return -1;
+    }
+    if (qlTerm(&parser, query, BITMAP_OR) != 0) return -1;
+
+    // 子句部分：UNDER作用于当前子查询，集合运算开始新的子查询，LIMIT / RETURN作用于整条语句
+    while (parser.token.kind != QL_TOKEN_END) {
+        struct QueryTerm* term = &query->terms[query->term_count - 1];
+        if (qlIsWord(&parser, "under")) {
+            if (qlNext(&parser) != 0 || qlRestrictToCode(&parser, root, &term->filter, 0) != 0) return -1;
+        } else if (qlIsWord(&parser, "union") || qlIsWord(&parser, "intersect") || qlIsWord(&parser, "except")) {
+            int set_op = qlIsWord(&parser, "union") ? BITMAP_OR : qlIsWord(&parser, "intersect") ? BITMAP_AND : BITMAP_ANDNOT;
+            if (qlNext(&parser) != 0 || qlTerm(&parser, query, set_op) != 0) return -1;
+        } else if (qlIsWord(&parser, "limit")) {
+            long limit;
+            if (qlNext(&parser) != 0 || qlNumber(&parser, &limit) != 0) return -1;
+            if (limit < 1 || limit > QL_MAX_LIMIT) {
+                snprintf(error, error_cap, "LIMIT应在1-%d之间", QL_MAX_LIMIT);
+                return -1;
+            }
+            query->limit = (int)limit;
+        } else if (qlIsWord(&parser, "return")) {
+            if (qlNext(&parser) != 0 || qlReturnList(&parser, query) != 0) return -1;
+        } else if (qlIsWord(&parser, "order")) {
+            if (qlNext(&parser) != 0) return -1;
+            if (!qlIsWord(&parser, "by")) return qlFail(&parser, "ORDER后应为BY");
+            if (qlNext(&parser) != 0) return -1;
+            if (!qlIsWord(&parser, "name") && !qlIsWord(&parser, "code")) return qlFail(&parser, "只能按 name 或 code 排序");
+            query->order_by_name = qlIsWord(&parser, "name");
+            if (qlNext(&parser) != 0) return -1;
+        } else {
+            return qlFail(&parser, "此处应为 AND / UNDER / UNION / INTERSECT / EXCEPT / LIMIT / RETURN / ORDER BY");
+        }
+    }
+
+    // 编译期确定各子查询的访问路径，执行时直接按计划取候选
+    for (int i = 0; i < query->term_count; i++) {
+        planQuery(&query->terms[i].filter, &query->terms[i].plan);
+    }
+    return 0;
+}
+
+/**
+ * @brief 子查询的结果写入位图（DFS序号升序追加）
+ */
+static int queryTermBitmap(const struct QueryTerm* term, struct NodeBitmap* bitmap) {
+    const struct RegionFilter* filter = &term->filter;
+    const struct RegionIndex* index = currentIndex();
+
+    memset(bitmap, 0, sizeof(*bitmap));
+    // 只有子树条件时整段置位，不逐个访问节点
+    if (!filter->name_contains && !filter->name_equals && !filter->level_mask && !filter->type_count) {
+        return bitmapAddRange(bitmap, (uint32_t)filter->begin, (uint32_t)filter->end);
+    }
+
+    int count = term->plan.candidates ? term->plan.candidate_count : filter->end - filter->begin;
+    for (int i = 0; i < count; i++) {
+        int dfs = term->plan.candidates ? term->plan.candidates[i] : filter->begin + i;
+        if (matchFilter(index->dfs_nodes[dfs], filter) && bitmapAdd(bitmap, (uint32_t)dfs) != 0) return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief 按顺序对各子查询的结果位图做集合运算
+ */
+static int evaluateQuerySet(const struct CompiledQuery* query, struct NodeBitmap* result) {
+    if (queryTermBitmap(&query->terms[0], result) != 0) return -1;
+
+    for (int i = 1; i < query->term_count; i++) {
+        const struct QueryTerm* term = &query->terms[i];
+        struct NodeBitmap operand, combined;
+        // 交集或差集的左侧已为空时跳过该项，其后的并集仍要计算
+        if (result->count == 0 && term->set_op != BITMAP_OR) continue;
+        if (queryTermBitmap(term, &operand) != 0 || bitmapCombine(result, &operand, term->set_op, &combined) != 0) {
+            return -1;
+        }
+        *result = combined;
+    }
+    return 0;
+}
+
+/**
+ * @brief 单一级别条件按名称排序：沿该级别已按名称排好的序列逐个核对，凑满即停
+ * @details 位图路径至少要核对计划中的全部候选再排序，级别序列不比候选多时逐个核对不会更慢，
+ *          且结果常在序列前部凑满；不适用时返回-1
+ */
+static int runSortedLevelQuery(const struct CompiledQuery* query, struct TreeNode** results, int max_results) {
+    const struct QueryTerm* term = &query->terms[0];
+    const struct RegionFilter* filter = &term->filter;
+    uint32_t mask = filter->level_mask;
+    if (query->term_count != 1 || mask == 0 || (mask & (mask - 1)) != 0) return -1;
+
+    int level = 0;
+    while (!(mask & (1u << level))) level++;
+    const int* sorted;
+    int length = sortedLevel(level, &sorted);
+    if (length < 0 || length > term->plan.candidate_count) return -1;
+
+    struct TreeNode* const* nodes = currentIndex()->dfs_nodes;
+    int found = 0;
+    for (int i = 0; i < length && found < max_results; i++) {
+        if (matchFilter(nodes[sorted[i]], filter)) results[found++] = nodes[sorted[i]];
+    }
+    return found;
+}
+
+int runCompiledQuery(const struct CompiledQuery* query, struct TreeNode** results, int max_results) {
+    if (max_results > query->limit) max_results = query->limit;
+    if (query->order_by_name) {
+        int found = runSortedLevelQuery(query, results, max_results);
+        if (found >= 0) return found;
+
+        // 按名称排序须先得到全部结果，再按名称位次选出前max_results个；全部结果放不进临时区时改用堆
+        size_t mark = scratchMark();
+        struct NodeBitmap bitmap;
+        int count = -1;
+        if (evaluateQuerySet(query, &bitmap) == 0) {
+            long total = bitmapCardinality(&bitmap);
+            int* heap = NULL;
+            int* ids = scratchAlloc(sizeof(int) * (total > 0 ? total : 1));
+            if (ids == NULL) ids = heap = malloc(sizeof(int) * (total > 0 ? total : 1));
+            count = ids ? orderNodesByName(ids, bitmapToArray(&bitmap, ids, (int)total), max_results) : -1;
+            struct TreeNode* const* nodes = currentIndex()->dfs_nodes;
+            for (int i = 0; i < count; i++) results[i] = nodes[ids[i]];
+            free(heap);
+        }
+        scratchReset(mark);
+        return count;
+    }
+    if (query->term_count == 1) {
+        return runQueryPlan(&query->terms[0].filter, &query->terms[0].plan, results, max_results);
+    }
+
+    // 多个子查询：结果以位图组合，只展开前max_results个；中间位图在临时区，返回前整体释放
+    size_t mark = scratchMark();
+    struct NodeBitmap bitmap;
+    int count = 0;
+    if (evaluateQuerySet(query, &bitmap) == 0) {
+        int* ids = scratchAlloc(sizeof(int) * (max_results > 0 ? max_results : 1));
+        count = ids ? bitmapToArray(&bitmap, ids, max_results) : 0;
+        struct TreeNode* const* nodes = currentIndex()->dfs_nodes;
+        for (int i = 0; i < count; i++) results[i] = nodes[ids[i]];
+    }
+    scratchReset(mark);
+    return count;
+}
+
+long countCompiledQuery(const struct CompiledQuery* query) {
+    size_t mark = scratchMark();
+    struct NodeBitmap bitmap;
+    long count = evaluateQuerySet(query, &bitmap) == 0 ? bitmapCardinality(&bitmap) : -1;
+    scratchReset(mark);
+    return count;
+}
+
+/**
+ * @brief 按RETURN字段格式化一行结果（字段间以制表符分隔）
+ */
+/**
+ * @brief 把写满缓冲区的结果行截断，以"…"结尾，不截断半个UTF-8字符
+ * @param length 已写入的有效字节数
+ */
+static int truncateQueryRow(char* out, size_t cap, size_t length) {
+    static const char MARK[] = "…";
+    if (cap < sizeof(MARK)) return -1;
+    if (length > cap - sizeof(MARK)) length = cap - sizeof(MARK);
+    while (length > 0 && ((unsigned char)out[length] & 0xC0) == 0x80) length--;
+    memcpy(out + length, MARK, sizeof(MARK));
+    return (int)(length + sizeof(MARK) - 1);
+}
+
+static int formatQueryRow(const struct CompiledQuery* query, const struct TreeNode* node, char* out, size_t cap) {
+    size_t length = 0;
+
+    for (int f = 0; f < query->field_count; f++) {
+        const struct Region* data = &node->data;
+        int n;
+        if (f > 0 && length + 1 < cap) out[length++] = '\t';
+
+        switch (query->fields[f]) {
+            case QUERY_FIELD_CODE:
+                n = snprintf(out + length, cap - length, "%s", data->code);
+                break;
+            case QUERY_FIELD_NAME:
+                n = snprintf(out + length, cap - length, "%s", data->name);
+                break;
+            case QUERY_FIELD_LEVEL:
+                n = snprintf(out + length, cap - length, "%d", data->level);
+                break;
+            case QUERY_FIELD_TYPE:
+                n = snprintf(out + length, cap - length, "%d", data->type);
+                break;
+            case QUERY_FIELD_PATH:
+                n = formatNodePath(node, out + length, cap - length);
+                break;
+            case QUERY_FIELD_PARENT:
+                n = snprintf(out + length, cap - length, "%s", data->parent_code);
+                break;
+            case QUERY_FIELD_PRICE:
+                n = hasHousePrice(data) ? snprintf(out + length, cap - length, "%.2f", *data->avg_house_price) : 0;
+                break;
+            default:
+                // 就业率原样保存（可能带换行），输出时去掉
+                n = hasEmploymentRate(data) ?
+                    snprintf(out + length, cap - length, "%.*s", (int)strcspn(data->employment_rate, "\r\n"),
+                             data->employment_rate) : 0;
+                break;
+        }
+        // 超长的行截断而不丢弃（字段已按缓冲区写入能放下的部分），输出行数与COUNT、LIMIT一致
+        if (n < 0 || length + (size_t)n >= cap) {
+            return truncateQueryRow(out, cap, length + strnlen(out + length, cap - length));
+        }
+        length += (size_t)n;
+    }
+    return (int)length;
+}
+
+int executeCompiledQuery(const struct CompiledQuery* query, struct QueryOutput* out) {
+    char line[MAX_LINE_LENGTH];
+    int length;
+
+    if (query->explain) {
+        // 只输出查询计划，不执行；多个子查询时逐个列出
+        static const char* SET_OP_NAMES[] = { "INTERSECT", "UNION", "EXCEPT" };
+        for (int i = 0; i < query->term_count; i++) {
+            const struct QueryTerm* term = &query->terms[i];
+            if (query->term_count > 1) {
+                length = snprintf(line, sizeof(line), "子查询\t%d\t%s\n", i + 1, i > 0 ? SET_OP_NAMES[term->set_op] : "");
+                queryOutputAppend(out, line, (size_t)length);
+            }
+            length = snprintf(line, sizeof(line), "访问路径\t%s\n候选数\t%d\n估算代价\t%ld\n",
+                              ACCESS_PATH_NAMES[term->plan.path], term->plan.candidate_count, term->plan.cost);
+            queryOutputAppend(out, line, (size_t)length);
+        }
+        return QUERY_STATUS_OK;
+    }
+
+    if (query->count_only) {
+        // 计数直接取位图基数，不展开节点
+        long count = countCompiledQuery(query);
+        if (count < 0) return QUERY_STATUS_INVALID;
+        length = snprintf(line, sizeof(line), "%ld\n", count);
+        queryOutputAppend(out, line, (size_t)length);
+        return QUERY_STATUS_OK;
+    }
+
+    size_t mark = scratchMark();
+    struct TreeNode** results = scratchAlloc(sizeof(struct TreeNode*) * query->limit);
+    if (results == NULL) return QUERY_STATUS_INVALID;
+
+    int count = runCompiledQuery(query, results, query->limit);
+    if (count < 0) {
+        static const char ORDER_ERROR[] = "名称排序不可用";
+        if (query->order_by_name) queryOutputAppend(out, ORDER_ERROR, sizeof(ORDER_ERROR) - 1);
+        scratchReset(mark);
+        return QUERY_STATUS_INVALID;
+    }
+    for (int i = 0; i < count; i++) {
+        length = formatQueryRow(query, results[i], line, sizeof(line) - 1);
+        if (length < 0) continue;
+        line[length++] = '\n';
+        if (queryOutputAppend(out, line, (size_t)length) != 0) break;
+    }
+    scratchReset(mark);
+    return count > 0 ? QUERY_STATUS_OK : QUERY_STATUS_NOT_FOUND;
+}
+
+// 15. 数据验证函数组
+static int validateCode(const char* code) {
+    if (strlen(code) != (size_t)g_code_scheme.total_digits) return -1;
+    
+    for (int i = 0; i < g_code_scheme.total_digits; i++) {
+        if (!isdigit(code[i])) return -2;
+    }
+    return 0;
+}
+
+static int validateName(const char* name) {
+    if (name == NULL || *name == '\0') return -1;
+    
+    int len = strlen(name);
+    if (len >= MAX_NAME_LENGTH) return -2;
+    
+    // 检查是否只包含空白字符
+    for (int i = 0; i < len; i++) {
+        if (!isspace(name[i])) return 0;
+    }
+    return -3;
+}
+
+/**
+ * @brief 是否有平均房价：CSV中缺省的房价读作0，不算有数据
+ */
+static int hasHousePrice(const struct Region* data) {
+    return data->avg_house_price && *data->avg_house_price > 0;
+}
+
+/**
+ * @brief 是否有就业率：CSV中缺省的就业率记作"N/A"，不算有数据
+ */
+static int hasEmploymentRate(const struct Region* data) {
+    return data->employment_rate && strcmp(data->employment_rate, "N/A") != 0;
+}
+
+// 16. 数据显示函数组
+static void displayNodeInfo(struct TreeNode* node, int show_separator) {
+    if (node == NULL) return;
+    
+    if (show_separator) {
+        printf("----------------------------------------\n");
+    }
+    
+    // 基本信息显示
+    printf("名称: %s\n", node->data.name);
+    printf("代码: %s\n", node->data.code);
+    printf("级别: %s\n", 
+        (node->data.level >= 0 && node->data.level <= 5) ? 
+        LEVEL_NAMES[node->data.level] : "未知级别");
+    
+    // 修改扩展数据显示部分
+    if (hasHousePrice(&node->data)) {
+        printf("平均房价: %.2f 元/平方米\n", *node->data.avg_house_price);
+    } else {
+        printf("平均房价: 暂无数据\n");
+    }
+    
+    printf("就业率: %s\n", 
+        hasEmploymentRate(&node->data) ? 
+        node->data.employment_rate : "暂无数据");
+    
+    // 显示层级关系
+    printf("行政区划层级关系：\n");
+    struct TreeNode* current = node;
+    int level = 0;
+    
+    while (current && current->parent) {
+        for (int i = 0; i < level; i++) {
+            printf("   ");
+        }
+        printf("└─ %s\n", current->data.name);
+        current = current->parent;
+        level++;
+    }
+}
+
+// 17. 异步读取函数组
+#ifdef __linux__
+static int uringSetup(struct AsyncReader* reader) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    int fd = (int)syscall(__NR_io_uring_setup, ASYNC_READ_DEPTH, &params);
+    if (fd < 0) return -1;
+
+    size_t sq_len = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    size_t cq_len = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    int single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap && cq_len > sq_len) sq_len = cq_len;
+
+    char* sq = mmap(NULL, sq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    char* cq = single_mmap ? sq : mmap(NULL, cq_len, PROT_READ | PROT_WRITE,
+                                       MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    size_t sqes_len = params.sq_entries * sizeof(struct io_uring_sqe);
+    void* sqes = mmap(NULL, sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sq == MAP_FAILED || cq == MAP_FAILED || sqes == MAP_FAILED) {
+        if (sq != MAP_FAILED) munmap(sq, sq_len);
+        if (!single_mmap && cq != MAP_FAILED) munmap(cq, cq_len);
+        if (sqes != MAP_FAILED) munmap(sqes, sqes_len);
+        close(fd);
+        return -1;
+    }
+
+    struct AsyncUring* ring = &reader->ring;
+    ring->fd = fd;
+    ring->sq_ptr = sq;
+    ring->sq_len = sq_len;
+    ring->cq_ptr = single_mmap ? NULL : cq;
+    ring->cq_len = cq_len;
+    ring->sqes = sqes;
+    ring->sqes_len = sqes_len;
+    ring->sq_tail = (unsigned*)(sq + params.sq_off.tail);
+    ring->sq_mask = *(unsigned*)(sq + params.sq_off.ring_mask);
+    ring->sq_array = (unsigned*)(sq + params.sq_off.array);
+    ring->cq_head = (unsigned*)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned*)(cq + params.cq_off.tail);
+    ring->cq_mask = *(unsigned*)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+    ring->inflight = 0;
+    ring->ready = 1;
+    return 0;
+}
+
+static void uringTeardown(struct AsyncUring* ring) {
+    munmap(ring->sqes, ring->sqes_len);
+    if (ring->cq_ptr) munmap(ring->cq_ptr, ring->cq_len);
+    munmap(ring->sq_ptr, ring->sq_len);
+    close(ring->fd);
+}
+#endif
+
+/**
+ * @brief 为第slot个缓冲区发起下一块的读取
+ */
+static void asyncSubmit(struct AsyncReader* reader, int slot) {
+    struct AsyncBuffer* buffer = &reader->buffers[slot];
+    if (reader->next_offset >= reader->file_size) {
+        buffer->state = ASYNC_BUFFER_IDLE;
+        return;
+    }
+
+    buffer->offset = reader->next_offset;
+    buffer->length = 0;
+    size_t want = reader->file_size - reader->next_offset;
+    if (want > ASYNC_CHUNK_SIZE) want = ASYNC_CHUNK_SIZE;
+    reader->next_offset += want;
+    buffer->state = ASYNC_BUFFER_PENDING;
+    buffer->wanted = want;
+    buffer->via_uring = 0;
+
+#ifdef __linux__
+    if (reader->mode == ASYNC_MODE_URING) {
+        struct AsyncUring* ring = &reader->ring;
+        unsigned tail = *ring->sq_tail;
+        unsigned index = tail & ring->sq_mask;
+        struct io_uring_sqe* sqe = &ring->sqes[index];
+
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = reader->fd;
+        sqe->addr = (uint64_t)(uintptr_t)buffer->data;
+        sqe->len = (unsigned)want;
+        sqe->off = buffer->offset;
+        sqe->user_data = (uint64_t)slot;
+        ring->sq_array[index] = index;
+        __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+        if (syscall(__NR_io_uring_enter, ring->fd, 1, 0, 0, NULL, 0) == 1) {
+            buffer->via_uring = 1;
+            ring->inflight++;
+            return;
+        }
+        // 提交失败时撤回该请求，后续改为pread
+        __atomic_store_n(ring->sq_tail, tail, __ATOMIC_RELEASE);
+        reader->mode = ASYNC_MODE_PREAD;
+    }
+    if (reader->mode == ASYNC_MODE_PREAD) {
+        // 请求内核预读该块，真正读取推迟到消费时，解析与磁盘I/O重叠
+        readahead(reader->fd, (off64_t)buffer->offset, want);
+        return;
+    }
+#endif
+}
+
+#ifdef __linux__
+/**
+ * @brief 收取io_uring完成事件，无事件时阻塞等待至少一个
+ */
+static int uringReap(struct AsyncReader* reader) {
+    struct AsyncUring* ring = &reader->ring;
+    unsigned head = *ring->cq_head;
+    unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+
+    if (head == tail) {
+        if (syscall(__NR_io_uring_enter, ring->fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0 && errno != EINTR) {
+            return -1;
+        }
+        return 0;
+    }
+    // 完成顺序可能与提交顺序不同，逐个记录到对应缓冲区；失败或短读留给同步补读
+    for (; head != tail; head++) {
+        struct io_uring_cqe* cqe = &ring->cqes[head & ring->cq_mask];
+        struct AsyncBuffer* done = &reader->buffers[cqe->user_data];
+        done->length = cqe->res > 0 ? (size_t)cqe->res : 0;
+        done->state = ASYNC_BUFFER_READY;
+        ring->inflight--;
+    }
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    return 0;
+}
+#endif
+
+/**
+ * @brief 等待指定缓冲区读取完成
+ */
+static int asyncWait(struct AsyncReader* reader, int slot) {
+    struct AsyncBuffer* buffer = &reader->buffers[slot];
+
+#ifdef __linux__
+    while (buffer->via_uring && buffer->state == ASYNC_BUFFER_PENDING) {
+        if (uringReap(reader) != 0) return -1;
+    }
+#endif
+
+    // 同步读取（或补齐短读）剩余部分
+    while (buffer->length < buffer->wanted) {
+#ifdef _WIN32
+        size_t got = fread(buffer->data + buffer->length, 1, buffer->wanted - buffer->length, reader->file);
+        if (got == 0) return -1;
+#else
+        ssize_t got = pread(reader->fd, buffer->data + buffer->length, buffer->wanted - buffer->length,
+                            (off_t)(buffer->offset + buffer->length));
+        if (got <= 0) return -1;
+#endif
+        buffer->length += (size_t)got;
+    }
+    buffer->state = ASYNC_BUFFER_READY;
+    return 0;
+}
+
+struct AsyncReader* asyncReaderOpen(const char* filename) {
+    struct AsyncReader* reader = calloc(1, sizeof(*reader));
+    if (reader == NULL) {
+        perror("内存分配失败");
+        return NULL;
+    }
+
+#ifdef _WIN32
+    reader->file = fopen(filename, "rb");
+    if (reader->file == NULL) {
+        free(reader);
+        return NULL;
+    }
+    fseek(reader->file, 0, SEEK_END);
+    reader->file_size = (uint64_t)ftell(reader->file);
+    fseek(reader->file, 0, SEEK_SET);
+    reader->mode = ASYNC_MODE_PREAD;
+#else
+    reader->fd = open(filename, O_RDONLY);
+    struct stat st;
+    if (reader->fd < 0 || fstat(reader->fd, &st) != 0) {
+        if (reader->fd >= 0) close(reader->fd);
+        free(reader);
+        return NULL;
+    }
+    reader->file_size = (uint64_t)st.st_size;
+    reader->mode = ASYNC_MODE_PREAD;
+#ifdef __linux__
+    posix_fadvise(reader->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    if (uringSetup(reader) == 0) reader->mode = ASYNC_MODE_URING;
+#endif
+#endif
+
+    // 各缓冲区依次领取文件块，保持ASYNC_READ_DEPTH个读取同时进行
+    for (int i = 0; i < ASYNC_READ_DEPTH; i++) {
+        reader->buffers[i].data = malloc(ASYNC_CHUNK_SIZE);
+        if (reader->buffers[i].data == NULL) {
+            perror("内存分配失败");
+            asyncReaderClose(reader);
+            return NULL;
+        }
+    }
+    for (int i = 0; i < ASYNC_READ_DEPTH; i++) {
+        asyncSubmit(reader, i);
+    }
+    reader->current = -1;
+    return reader;
+}
+
+const char* asyncReaderNext(struct AsyncReader* reader, size_t* length) {
+    // 上一块已被消费，复用其缓冲区发起后续读取
+    if (reader->current >= 0) {
+        asyncSubmit(reader, reader->current);
+    }
+    int slot = (reader->current + 1) % ASYNC_READ_DEPTH;
+    reader->current = slot;
+
+    struct AsyncBuffer* buffer = &reader->buffers[slot];
+    if (buffer->state == ASYNC_BUFFER_IDLE) return NULL;
+    if (asyncWait(reader, slot) != 0) {
+        reader->failed = 1;
+        return NULL;
+    }
+    *length = buffer->length;
+    return buffer->data;
+}
+
+const char* asyncReaderModeName(const struct AsyncReader* reader) {
+    return reader->mode == ASYNC_MODE_URING ? "io_uring" : "pread+预读";
+}
+
+void asyncReaderClose(struct AsyncReader* reader) {
+    if (reader == NULL) return;
+#ifdef __linux__
+    if (reader->ring.ready) {
+        // 等待所有在途读取完成后再释放缓冲区
+        while (reader->ring.inflight > 0 && uringReap(reader) == 0) {}
+        uringTeardown(&reader->ring);
+    }
+#endif
+#ifdef _WIN32
+    if (reader->file) fclose(reader->file);
+#else
+    if (reader->fd >= 0) close(reader->fd);
+#endif
+    for (int i = 0; i < ASYNC_READ_DEPTH; i++) {
+        free(reader->buffers[i].data);
+    }
+    free(reader);
+}
+
+/**
+ * @brief 整个文件读入内存（多个大块读取同时在途），末尾补'\0'便于按文本解析
+ * @return 缓冲区（调用者释放），失败返回NULL
+ */
+char* readWholeFile(const char* filename, size_t* size) {
+    struct AsyncReader* reader = asyncReaderOpen(filename);
+    if (reader == NULL) {
+        perror("无法打开文件");
+        return NULL;
+    }
+
+    size_t total = (size_t)reader->file_size, filled = 0;
+    char* data = malloc(total + 1);
+    const char* chunk;
+    size_t chunk_len;
+    while (data != NULL && (chunk = asyncReaderNext(reader, &chunk_len)) != NULL && filled + chunk_len <= total) {
+        memcpy(data + filled, chunk, chunk_len);
+        filled += chunk_len;
+    }
+    asyncReaderClose(reader);
+
+    if (data == NULL || filled != total) {
+        perror("读取文件失败");
+        free(data);
+        return NULL;
+    }
+    data[total] = '\0';
+    *size = total;
+    return data;
+}
+
+// 18. 数据加载函数组
+/**
+ * @brief 解析一行CSV到区划结构
+ * @return 字段完整返回0，否则返回-1
+ */
+static int parseCSVLine(char* line, struct Region* region) {
+    char* token = strtok(line, ",");
+    if (!token) return -1;
+    
+    // 基本字段解析
+    strncpy(region->code, token, MAX_CODE_LENGTH - 1);
+    
+    if (!(token = strtok(NULL, ","))) return -1;
+    strncpy(region->name, token, MAX_NAME_LENGTH - 1);
+    
+    if (!(token = strtok(NULL, ","))) return -1;
+    region->level = atoi(token);
+    
+    if (!(token = strtok(NULL, ","))) return -1;
+    strncpy(region->parent_code, token, MAX_CODE_LENGTH - 1);
+    
+    if (!(token = strtok(NULL, ","))) return -1;
+    region->type = atoi(token);
+    
+    // 可选字段处理
+    region->avg_house_price = malloc(sizeof(double));
+    *region->avg_house_price = (token = strtok(NULL, ",")) ? atof(token) : 0.0;
+    
+    region->employment_rate = strdup((token = strtok(NULL, ",")) ? token : "N/A");
+    return 0;
+}
+
+int loadRegionsFromCSV(struct Region regions[], const char* filename) {
+    struct AsyncReader* reader = asyncReaderOpen(filename);
+    if (reader == NULL) {
+        perror("无法打开文件");
+        return 0;
+    }
+    printf("读取方式：%s\n", asyncReaderModeName(reader));
+
+    // 读取与解析重叠：解析当前块时后续块的读取仍在进行
+    char line[MAX_LINE_LENGTH];
+    size_t line_len = 0;
+    int count = 0, line_no = 0;
+    const char* chunk;
+    size_t chunk_len;
+    
+    while ((chunk = asyncReaderNext(reader, &chunk_len)) != NULL && count < MAX_REGIONS) {
+        for (size_t i = 0; i < chunk_len && count < MAX_REGIONS; i++) {
+            // 跨块的行在line中拼接，超长部分截断
+            if (line_len < MAX_LINE_LENGTH - 1) line[line_len++] = chunk[i];
+            if (chunk[i] != '\n') continue;
+
+            line[line_len] = '\0';
+            line_len = 0;
+            // 跳过标题行
+            if (line_no++ == 0) continue;
+            if (parseCSVLine(line, &regions[count]) == 0) count++;
+        }
+    }
+    if (line_len > 0 && line_no > 0 && count < MAX_REGIONS) {
+        line[line_len] = '\0';
+        if (parseCSVLine(line, &regions[count]) == 0) count++;
+    }
+    if (reader->failed) {
+        printf("警告：读取文件 %s 时出错，数据可能不完整\n", filename);
+    }
+    
+    asyncReaderClose(reader);
+    return count;
+}
+
+struct TreeNode* loadDataset(const char* filename) {
+    struct TreeNode* root = NULL;
+
+#ifdef EMBED_INDEX
+    // 未指定外部文件时直接使用内嵌索引，启动时不解析CSV也不读文件
+    if (filename == NULL) {
+        root = loadTreeFromBlob(embedded_index_start, (size_t)(embedded_index_end - embedded_index_start));
+        if (root != NULL) {
+            printf("已加载内嵌索引（%d 个节点）\n", g_index.count);
+        }
+        return root;
+    }
+#endif
+    if (filename == NULL) filename = "area_data.csv";
+
+    if (isIndexBlobFile(filename)) {
+        root = loadTreeFromBlobFile(filename);
+        if (root != NULL) {
+            printf("已加载索引文件 %s（%d 个节点）\n", filename, g_index.count);
+        }
+        return root;
+    }
+
+    struct Region *regions = malloc(MAX_REGIONS * sizeof(struct Region));
+    if (regions == NULL) {
+        perror("内存分配失败");
+        return NULL;
+    }
+
+    int size = loadRegionsFromCSV(regions, filename);
+
+    if (size == 0) {
+        printf("错误：数据加载失败\n");
+        free(regions);
+        return NULL;
+    }
+
+    printf("成功加载 %d 条区划数据\n", size);
+
+    root = buildTree(regions, size);
+    // 节点已复制区划数据，原数组不再需要
+    free(regions);
+    if (root == NULL) {
+        printf("错误：树结构构建失败\n");
+        return NULL;
+    }
+    printf("树结构构建完成\n");
+
+    buildRegionIndex(root);
+    return root;
+}
+
+// 19. 地址解析函数组
+/**
+ * @brief 区划名称与地址开头的匹配长度（字节），全称优先，其次为去掉通名后缀的专名
+ */
+static size_t addressMatchLength(const char* name, const char* text) {
+    // 首字（UTF-8三字节）不同即可排除，绝大多数候选在此返回
+    for (int i = 0; i < 3 && name[i] != '\0'; i++) {
+        if (name[i] != text[i]) return 0;
+    }
+
+    size_t length = strlen(name);
+    if (strncmp(text, name, length) == 0) return length;
+
+    size_t stem = nameStemLength(name, length);
+    return stem > 0 && strncmp(text, name, stem) == 0 ? stem : 0;
+}
+
+/**
+ * @brief 规范化地址：去掉空白（含全角空格），全角字母数字转半角，去掉国名前缀
+ * @details 输出不长于输入，可写入同样大小的缓冲区
+ */
+void normalizeAddress(const char* in, char* out) {
+    const unsigned char* p = (const unsigned char*)in;
+    char* o = out;
+
+    while (*p) {
+        if (isspace(*p)) {
+            p++;
+        } else if (p[0] == 0xE3 && p[1] == 0x80 && p[2] == 0x80) {
+            p += 3;
+        } else if (p[0] == 0xEF && (p[1] == 0xBC || p[1] == 0xBD) && p[2] >= 0x80 && p[2] <= 0xBF) {
+            // U+FF01..U+FF5E 与ASCII相差0xFEE0
+            unsigned cp = 0xF000u | ((p[1] & 0x3Fu) << 6) | (p[2] & 0x3Fu);
+            if (cp >= 0xFF01 && cp <= 0xFF5E) {
+                *o++ = (char)(cp - 0xFEE0);
+            } else {
+                memcpy(o, p, 3);
+                o += 3;
+            }
+            p += 3;
+        } else {
+            *o++ = (char)*p++;
+        }
+    }
+    *o = '\0';
+
+    static const char* const prefixes[] = { "中华人民共和国", "中国" };
+    for (size_t i = 0; i < sizeof(prefixes) / sizeof(prefixes[0]); i++) {
+        size_t length = strlen(prefixes[i]);
+        if (strncmp(out, prefixes[i], length) == 0) {
+            memmove(out, out + length, strlen(out + length) + 1);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief 贪心解析：逐级取与剩余地址开头匹配最长的下级（名称索引未就绪时使用）
+ */
+static struct TreeNode* resolveAddressGreedy(struct TreeNode* root, const char* text, size_t* matched) {
+    struct TreeNode* current = root;
+    const char* p = text;
+
+    // 逐级向下取与剩余地址开头匹配最长的下级；下级都不匹配时再看隔一级，
+    // 对应地址中省略的一级（如"市辖区"）
+    while (*p) {
+        struct TreeNode* best = NULL;
+        size_t best_length = 0;
+        for (int i = 0; i < current->child_count; i++) {
+            size_t length = addressMatchLength(current->children[i]->data.name, p);
+            if (length > best_length) {
+                best = current->children[i];
+                best_length = length;
+            }
+        }
+        for (int i = 0; best == NULL && i < current->child_count; i++) {
+            struct TreeNode* child = current->children[i];
+            for (int j = 0; j < child->child_count; j++) {
+                size_t length = addressMatchLength(child->children[j]->data.name, p);
+                if (length > best_length) {
+                    best = child->children[j];
+                    best_length = length;
+                }
+            }
+        }
+        if (best == NULL) break;
+        current = best;
+        p += best_length;
+    }
+
+    if (current == root || (size_t)(p - text) < RESOLVE_MIN_COVERED) current = NULL;
+    if (matched) *matched = current ? (size_t)(p - text) : 0;
+    return current;
+}
+
+/**
+ * @brief 地址解析的候选状态：已识别到某位置、链尾为某节点的最高得分
+ */
+struct ResolveState {
+    struct TreeNode* node;   ///< 候选链末端节点
+    int end;                 ///< 已识别到的字节位置
+    int score;               ///< 最高得分
+    int gap;                 ///< 末端之后连续跳过的字节数
+    int covered;             ///< 链上名称匹配的字节数
+    int next;                ///< 同一位置的下一个状态，-1结束
+};
+
+/**
+ * @brief 候选状态网格（全部分配在暂存区）
+ */
+struct ResolveLattice {
+    struct ResolveState* states;
+    int count;
+    int* heads;              ///< 各位置的状态链表头
+    int* slots;              ///< (位置, 节点) → 状态下标的开放寻址表
+    uint32_t mask;
+    int best_score;          ///< 已记录状态的最高得分
+};
+
+/**
+ * @brief 某位置开始、可作为名称或专名的一段文字及其倒排链
+ */
+struct ResolveSpan {
+    int length;
+    const int* postings;
+    int posting_count;
+};
+
+/**
+ * @brief 记录到达(位置, 节点)的一条候选链，同一状态只保留最高得分
+ */
+static inline uint32_t resolveSlot(const struct TreeNode* node, int end, uint32_t mask) {
+    return (uint32_t)((((uintptr_t)node >> 4) ^ ((uint64_t)end << 32)) * 0x9E3779B97F4A7C15ULL >> 32) & mask;
+}
+
+/**
+ * @brief 状态表过半满时加倍（多数地址只有几十个状态，从小表开始避免每条地址清零大表）
+ */
+static int resolveGrowSlots(struct ResolveLattice* lattice) {
+    uint32_t mask = lattice->mask * 2 + 1;
+    int* slots = scratchAlloc(sizeof(int) * (mask + 1));
+    if (slots == NULL) return -1;
+    memset(slots, -1, sizeof(int) * (mask + 1));
+    for (int i = 0; i < lattice->count; i++) {
+        uint32_t slot = resolveSlot(lattice->states[i].node, lattice->states[i].end, mask);
+        while (slots[slot] >= 0) slot = (slot + 1) & mask;
+        slots[slot] = i;
+    }
+    lattice->slots = slots;
+    lattice->mask = mask;
+    return 0;
+}
+
+static void resolveRelax(struct ResolveLattice* lattice, int end, struct TreeNode* node, int score, int gap,
+                         int covered) {
+    uint32_t slot = resolveSlot(node, end, lattice->mask);
+    int index;
+    while ((index = lattice->slots[slot]) >= 0) {
+        struct ResolveState* state = &lattice->states[index];
+        if (state->node == node && state->end == end) {
+            if (score > state->score) {
+                if (score > lattice->best_score) lattice->best_score = score;
+                state->score = score;
+                state->gap = gap;
+                state->covered = covered;
+            }
+            return;
+        }
+        slot = (slot + 1) & lattice->mask;
+    }
+    // 超出上限的候选舍弃（只在极常见的专名开头时出现）
+    if (lattice->count == RESOLVE_MAX_STATES) return;
+    if ((uint32_t)(lattice->count + 1) * 2 > lattice->mask + 1) {
+        if (resolveGrowSlots(lattice) != 0) return;
+        slot = resolveSlot(node, end, lattice->mask);
+        while (lattice->slots[slot] >= 0) slot = (slot + 1) & lattice->mask;
+    }
+
+    if (score > lattice->best_score) lattice->best_score = score;
+    index = lattice->count++;
+    lattice->states[index] = (struct ResolveState){ node, end, score, gap, covered, lattice->heads[end] };
+    lattice->heads[end] = index;
+    lattice->slots[slot] = index;
+}
+
+/**
+ * @brief 查出从text[pos]开始的各段文字对应的倒排链（不少于两个汉字，不长于最长名称）
+ * @details 对每个位置只查一次，该位置上所有候选状态共用
+ */
+static int resolveSpansAt(const char* text, size_t pos, size_t length, struct ResolveSpan* spans) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    size_t limit = length - pos;
+    int count = 0;
+
+    if (limit > g_name_index.longest_name) limit = g_name_index.longest_name;
+    for (size_t i = 0; i < limit; i++) {
+        hash = (hash ^ (unsigned char)text[pos + i]) * 0x100000001b3ULL;
+        // 只在字符边界上查找，没有名称以这段文字开头时停止
+        if (i + 1 < 6 || ((unsigned char)text[pos + i + 1] & 0xC0) == 0x80) continue;
+        uint64_t bit = (hash | (1ULL << 63)) & g_name_index.prefix_mask;
+        if (!(g_name_index.prefixes[bit / 64] & (1ULL << (bit % 64)))) break;
+
+        int posting_count;
+        const int* postings = postingLookup(&g_name_index.address, hash | (1ULL << 63), &posting_count);
+        if (posting_count > 0) spans[count++] = (struct ResolveSpan){ (int)(i + 1), postings, posting_count };
+    }
+    return count;
+}
+
+static struct TreeNode* commonAncestor(struct TreeNode* a, struct TreeNode* b) {
+    while (!(a->dfs_index <= b->dfs_index && b->dfs_index < a->subtree_end)) a = a->parent;
+    return a;
+}
+
+struct TreeNode* resolveAddress(struct TreeNode* root, const char* text, size_t* matched) {
+    const struct RegionIndex* index = currentIndex();
+    if (!__atomic_load_n(&g_name_index.ready, __ATOMIC_ACQUIRE) ||
+        root->dfs_index >= index->count || index->dfs_nodes[root->dfs_index] != root) {
+        return resolveAddressGreedy(root, text, matched);
+    }
+
+    struct TreeNode* const* nodes = index->dfs_nodes;
+    size_t length = strlen(text);
+    size_t mark = scratchMark();
+    struct ResolveLattice lattice = { 0 };
+    struct ResolveSpan spans[MAX_NAME_LENGTH];
+    lattice.mask = 63;
+    lattice.states = scratchAlloc(sizeof(struct ResolveState) * RESOLVE_MAX_STATES);
+    lattice.heads = scratchAlloc(sizeof(int) * (length + 1));
+    lattice.slots = scratchAlloc(sizeof(int) * (lattice.mask + 1));
+    if (lattice.states == NULL || lattice.heads == NULL || lattice.slots == NULL) {
+        scratchReset(mark);
+        return resolveAddressGreedy(root, text, matched);
+    }
+    memset(lattice.heads, -1, sizeof(int) * (length + 1));
+    memset(lattice.slots, -1, sizeof(int) * (lattice.mask + 1));
+
+    // 按位置从前往后推进（类Viterbi）：每个状态只接受自己子树内、名称与当前位置匹配的节点，
+    // 子树判断即DFS区间包含，在有序倒排链上二分截取；同名候选全部保留，由后续的下级名称区分
+    struct TreeNode* best = NULL;
+    int best_score = 0, best_level = 0, best_covered = 0;
+    size_t best_end = 0;
+    resolveRelax(&lattice, 0, root, 0, 0, 0);
+    for (size_t pos = 0; pos <= length; pos++) {
+        int span_count = -1;
+        for (int i = lattice.heads[pos]; i >= 0; i = lattice.states[i].next) {
+            struct ResolveState state = lattice.states[i];
+            struct TreeNode* node = state.node;
+            if (node != root) {
+                if (best == NULL || state.score > best_score ||
+                    (state.score == best_score && node->data.level > best_level)) {
+                    best = node;
+                    best_score = state.score;
+                    best_level = node->data.level;
+                    best_covered = state.covered;
+                    best_end = pos;
+                } else if (state.score == best_score && node->data.level == best_level && node != best) {
+                    // 得分相同的同级候选无法区分，只取其公共上级
+                    best = commonAncestor(best, node);
+                }
+            }
+            // 远低于已知最高得分的链不再展开
+            if (pos == length || node->child_count == 0 || state.score < lattice.best_score - RESOLVE_BEAM_MARGIN) continue;
+
+            if (span_count < 0) span_count = resolveSpansAt(text, pos, length, spans);
+            int found = 0;
+            for (int s = 0; s < span_count; s++) {
+                int count;
+                const int* candidates = postingRange(spans[s].postings, spans[s].posting_count,
+                                                     node->dfs_index + 1, node->subtree_end, &count);
+                for (int k = 0; k < count; k++) {
+                    struct TreeNode* candidate = nodes[candidates[k]];
+                    if (addressMatchLength(candidate->data.name, text + pos) != (size_t)spans[s].length) continue;
+                    int score = state.score + 2 * spans[s].length -
+                                RESOLVE_SKIP_PENALTY * (candidate->data.level - node->data.level - 1) -
+                                (candidate->data.name[spans[s].length] != '\0' ? RESOLVE_STEM_PENALTY : 0);
+                    resolveRelax(&lattice, (int)pos + spans[s].length, candidate, score, 0,
+                                 state.covered + spans[s].length);
+                    found = 1;
+                }
+            }
+
+            // 当前位置无法识别时跳过一个字符；地址开头的无关文字同样受连续跳过上限约束
+            if (!found) {
+                int step = 1;
+                while (pos + step < length && ((unsigned char)text[pos + step] & 0xC0) == 0x80) step++;
+                if (state.gap + step <= RESOLVE_MAX_GAP) {
+                    resolveRelax(&lattice, (int)pos + step, node, state.score - step, state.gap + step, state.covered);
+                }
+            }
+        }
+    }
+    scratchReset(mark);
+
+    // 得分不为正或识别的文字太少（如只在无关文字中碰上一个两字专名）时不算解析成功
+    if (best == root || best_score <= 0 || best_covered < RESOLVE_MIN_COVERED) best = NULL;
+    if (matched) *matched = best ? best_end : 0;
+    return best;
+}
+
+#ifndef _WIN32
+/**
+ * @brief 有界无锁多生产者多消费者队列（按槽位序号同步）
+ */
+struct PipeCell {
+    size_t sequence;               ///< 槽位序号：等于入队位置时可写，等于位置+1时可读
+    struct ResolveBatch* batch;    ///< 数据
+};
+
+struct PipeQueue {
+    struct PipeCell cells[PIPE_QUEUE_SIZE];
+    char pad0[64];
+    size_t enqueue_pos;            ///< 入队位置（与出队位置分处不同缓存行）
+    char pad1[64];
+    size_t dequeue_pos;            ///< 出队位置
+    char pad2[64];
+};
+
+/**
+ * @brief 流水线中的一批地址
+ * @details 批对象数量固定、循环使用，整条流水线内存占用与输入大小无关
+ */
+struct ResolveBatch {
+    uint64_t seq;                             ///< 批序号，写出阶段据此恢复输入顺序
+    int line_count;                           ///< 行数
+    size_t input_length;                      ///< 已用输入字节
+    int lines[RESOLVE_BATCH_LINES];           ///< 各行在input中的起点（行以'\0'结尾）
+    char input[RESOLVE_BATCH_BYTES];          ///< 原始地址
+    char normalized[RESOLVE_BATCH_BYTES];     ///< 规范化后的地址，与input同偏移
+    struct QueryOutput out;                   ///< 解析结果行（可增长，批对象复用时保留容量）
+    long resolved;                            ///< 解析成功的行数
+};
+
+/**
+ * @brief 地址解析流水线：读取 → 规范化 → 解析 → 按序写出
+ */
+struct ResolvePipeline {
+    struct TreeNode* root;
+    struct PipeQueue free_batches;    ///< 空闲批
+    struct PipeQueue to_normalize;    ///< 待规范化
+    struct PipeQueue to_resolve;      ///< 待解析
+    struct PipeQueue to_write;        ///< 待写出（乱序）
+    int normalizers;                  ///< 规范化线程数
+    int resolvers;                    ///< 解析线程数
+    int normalizers_left;             ///< 尚未结束的规范化线程
+    int resolvers_left;               ///< 尚未结束的解析线程
+    int kind;                         ///< 输入类型（ResolveInput）
+    struct AsyncReader* reader;
+    int read_failed;
+    struct ResolveBatch batches[RESOLVE_BATCHES];
+};
+
+static struct ResolveBatch g_pipe_end;  ///< 结束标记，逐阶段传递
+
+static void pipeQueueInit(struct PipeQueue* queue) {
+    for (size_t i = 0; i < PIPE_QUEUE_SIZE; i++) queue->cells[i].sequence = i;
+    queue->enqueue_pos = 0;
+    queue->dequeue_pos = 0;
+}
+
+static int pipeQueueTryPush(struct PipeQueue* queue, struct ResolveBatch* batch) {
+    size_t pos = __atomic_load_n(&queue->enqueue_pos, __ATOMIC_RELAXED);
+    for (;;) {
+        struct PipeCell* cell = &queue->cells[pos & (PIPE_QUEUE_SIZE - 1)];
+        intptr_t diff = (intptr_t)__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) - (intptr_t)pos;
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&queue->enqueue_pos, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                cell->batch = batch;
+                __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+                return 0;
+            }
+        } else if (diff < 0) {
+            return -1;
+        } else {
+            pos = __atomic_load_n(&queue->enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static struct ResolveBatch* pipeQueueTryPop(struct PipeQueue* queue) {
+    size_t pos = __atomic_load_n(&queue->dequeue_pos, __ATOMIC_RELAXED);
+    for (;;) {
+        struct PipeCell* cell = &queue->cells[pos & (PIPE_QUEUE_SIZE - 1)];
+        intptr_t diff = (intptr_t)__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) - (intptr_t)(pos + 1);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&queue->dequeue_pos, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                struct ResolveBatch* batch = cell->batch;
+                __atomic_store_n(&cell->sequence, pos + PIPE_QUEUE_SIZE, __ATOMIC_RELEASE);
+                return batch;
+            }
+        } else if (diff < 0) {
+            return NULL;
+        } else {
+            pos = __atomic_load_n(&queue->dequeue_pos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/**
+ * @brief 队列暂时不可用时退避：先让出CPU，久等后短暂休眠
+ */
+static void pipeBackoff(int* spins) {
+    if (++*spins < 64) {
+        sched_yield();
+    } else {
+        struct timespec pause = { 0, 50000 };
+        nanosleep(&pause, NULL);
+    }
+}
+
+static void pipeQueuePush(struct PipeQueue* queue, struct ResolveBatch* batch) {
+    int spins = 0;
+    while (pipeQueueTryPush(queue, batch) != 0) pipeBackoff(&spins);
+}
+
+static struct ResolveBatch* pipeQueuePop(struct PipeQueue* queue) {
+    int spins = 0;
+    struct ResolveBatch* batch;
+    while ((batch = pipeQueueTryPop(queue)) == NULL) pipeBackoff(&spins);
+    return batch;
+}
+
+/**
+ * @brief 结束当前行；批内剩余空间放不下一整行时交给下一阶段
+ */
+static void resolveFinishLine(struct ResolvePipeline* pipe, struct ResolveBatch** batch, size_t* line_length) {
+    struct ResolveBatch* current = *batch;
+    char* line = current->input + current->input_length;
+
+    if (*line_length > 0 && line[*line_length - 1] == '\r') (*line_length)--;
+    line[*line_length] = '\0';
+    current->lines[current->line_count++] = (int)current->input_length;
+    current->input_length += *line_length + 1;
+    *line_length = 0;
+
+    if (current->line_count == RESOLVE_BATCH_LINES || current->input_length + MAX_LINE_LENGTH > RESOLVE_BATCH_BYTES) {
+        pipeQueuePush(&pipe->to_normalize, current);
+        *batch = NULL;
+    }
+}
+
+/**
+ * @brief 读取阶段：按块读入文件，切分为行装入批，超长的行截断
+ */
+static void* resolveReaderMain(void* arg) {
+    struct ResolvePipeline* pipe = arg;
+    struct ResolveBatch* batch = NULL;
+    uint64_t seq = 0;
+    size_t line_length = 0;  // 当前行已写入的字节数，行起点为batch->input_length
+    const char* chunk;
+    size_t chunk_length;
+
+    while ((chunk = asyncReaderNext(pipe->reader, &chunk_length)) != NULL) {
+        const char* p = chunk;
+        const char* end = chunk + chunk_length;
+        while (p < end) {
+            if (batch == NULL) {
+                // 空闲批用完时在此等待，背压传到读取
+                batch = pipeQueuePop(&pipe->free_batches);
+                batch->seq = seq++;
+                batch->line_count = 0;
+                batch->input_length = 0;
+            }
+            const char* newline = memchr(p, '\n', (size_t)(end - p));
+            size_t copy = (size_t)((newline ? newline : end) - p);
+            if (line_length + copy > MAX_LINE_LENGTH - 1) copy = MAX_LINE_LENGTH - 1 - line_length;
+            memcpy(batch->input + batch->input_length + line_length, p, copy);
+            line_length += copy;
+            p = newline ? newline + 1 : end;
+            if (newline) resolveFinishLine(pipe, &batch, &line_length);
+        }
+    }
+    // 末行没有换行符
+    if (line_length > 0) resolveFinishLine(pipe, &batch, &line_length);
+
+    if (batch != NULL && batch->line_count > 0) {
+        pipeQueuePush(&pipe->to_normalize, batch);
+    } else if (batch != NULL) {
+        pipeQueuePush(&pipe->free_batches, batch);
+    }
+    pipe->read_failed = pipe->reader->failed;
+    for (int i = 0; i < pipe->normalizers; i++) pipeQueuePush(&pipe->to_normalize, &g_pipe_end);
+    return NULL;
+}
+
+/**
+ * @brief 规范化阶段（多线程）
+ */
+static void* resolveNormalizerMain(void* arg) {
+    struct ResolvePipeline* pipe = arg;
+    struct ResolveBatch* batch;
+
+    while ((batch = pipeQueuePop(&pipe->to_normalize)) != &g_pipe_end) {
+        // 坐标行直接解析，不需要规范化
+        for (int i = 0; i < batch->line_count && pipe->kind == RESOLVE_INPUT_ADDRESS; i++) {
+            normalizeAddress(batch->input + batch->lines[i], batch->normalized + batch->lines[i]);
+        }
+        pipeQueuePush(&pipe->to_resolve, batch);
+    }
+    // 最后一个结束的规范化线程通知解析阶段结束
+    if (__atomic_sub_fetch(&pipe->normalizers_left, 1, __ATOMIC_ACQ_REL) == 0) {
+        for (int i = 0; i < pipe->resolvers; i++) pipeQueuePush(&pipe->to_resolve, &g_pipe_end);
+    }
+    return NULL;
+}
+
+/**
+ * @brief 解析阶段（多线程）：在候选网格中选出得分最高的区划并生成输出行 原文\t代码\t层级路径[\t距离]
+ */
+static void* resolveResolverMain(void* arg) {
+    struct ResolvePipeline* pipe = arg;
+    struct ResolveBatch* batch;
+    char line[MAX_LINE_LENGTH * 2];
+
+    while ((batch = pipeQueuePop(&pipe->to_resolve)) != &g_pipe_end) {
+        queryOutputReset(&batch->out);
+        batch->resolved = 0;
+        if (pipe->kind == RESOLVE_INPUT_CODES) {
+            // 整批代码一次批量查找
+            const char* codes[RESOLVE_BATCH_LINES];
+            for (int i = 0; i < batch->line_count; i++) codes[i] = batch->input + batch->lines[i];
+            int converted = appendConvertedCodes(codes, batch->line_count, &batch->out);
+            if (converted > 0) batch->resolved = converted;
+            pipeQueuePush(&pipe->to_write, batch);
+            continue;
+        }
+        for (int i = 0; i < batch->line_count; i++) {
+            const char* original = batch->input + batch->lines[i];
+            struct TreeNode* node;
+            double lat, lon, kilometers = -1;
+            if (pipe->kind == RESOLVE_INPUT_NEIGHBORS) {
+                // 邻居个数不定，直接写入批的输出缓冲
+                batch->resolved += appendNeighborLine(pipe->root, original, &batch->out);
+                continue;
+            }
+            if (pipe->kind == RESOLVE_INPUT_POINT) {
+                node = parseLatLon(original, &lat, &lon) == 0 ? locatePoint(lat, lon) : NULL;
+            } else if (pipe->kind == RESOLVE_INPUT_NEAREST) {
+                node = resolveNearestLine(pipe->root, original, &kilometers);
+            } else {
+                node = resolveAddress(pipe->root, batch->normalized + batch->lines[i], NULL);
+            }
+            int length = snprintf(line, sizeof(line), "%s\t%s\t", original, node ? node->data.code : "");
+            if (node != NULL) {
+                int path = formatNodePath(node, line + length, sizeof(line) - 1 - length);
+                if (path > 0) length += path;
+                if (kilometers >= 0 && length < (int)sizeof(line) - 32) {
+                    length += snprintf(line + length, sizeof(line) - length, "\t%.3f", kilometers);
+                }
+                batch->resolved++;
+            }
+            line[length++] = '\n';
+            queryOutputAppend(&batch->out, line, (size_t)length);
+        }
+        pipeQueuePush(&pipe->to_write, batch);
+    }
+    if (__atomic_sub_fetch(&pipe->resolvers_left, 1, __ATOMIC_ACQ_REL) == 0) {
+        pipeQueuePush(&pipe->to_write, &g_pipe_end);
+    }
+    scratchRelease();
+    return NULL;
+}
+
+int runResolvePipeline(struct TreeNode* root, const char* input, const char* output, int kind) {
+    const char* title = kind == RESOLVE_INPUT_POINT ? "坐标反查" : kind == RESOLVE_INPUT_NEAREST ? "最近区划" :
+                        kind == RESOLVE_INPUT_NEIGHBORS ? "邻接查询" : kind == RESOLVE_INPUT_CODES ? "代码转换" : "地址解析";
+    struct timespec start, end;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 1) cpus = 1;
+
+    struct ResolvePipeline* pipe = calloc(1, sizeof(struct ResolvePipeline));
+    if (pipe == NULL) {
+        perror("地址解析流水线分配失败");
+        return 1;
+    }
+    pipe->reader = asyncReaderOpen(input);
+    if (pipe->reader == NULL) {
+        free(pipe);
+        return 1;
+    }
+    FILE* stream = g_result_output ? g_result_output : stdout;
+    FILE* out = strcmp(output, "-") == 0 ? stream : fopen(output, "wb");
+    if (out == NULL) {
+        perror("无法创建输出文件");
+        asyncReaderClose(pipe->reader);
+        free(pipe);
+        return 1;
+    }
+
+    // 解析最耗时，多数线程给解析阶段；读取与写出各占一个线程
+    pipe->root = root;
+    pipe->kind = kind;
+    pipe->normalizers = 1 + (int)(cpus / 4);
+    pipe->resolvers = cpus > 2 ? (int)cpus - 1 : 1;
+    if (pipe->normalizers > RESOLVE_MAX_THREADS) pipe->normalizers = RESOLVE_MAX_THREADS;
+    if (pipe->resolvers > RESOLVE_MAX_THREADS) pipe->resolvers = RESOLVE_MAX_THREADS;
+    pipe->normalizers_left = pipe->normalizers;
+    pipe->resolvers_left = pipe->resolvers;
+    pipeQueueInit(&pipe->free_batches);
+    pipeQueueInit(&pipe->to_normalize);
+    pipeQueueInit(&pipe->to_resolve);
+    pipeQueueInit(&pipe->to_write);
+    for (int i = 0; i < RESOLVE_BATCHES; i++) {
+        pipe->batches[i].out.growable = 1;
+        pipeQueuePush(&pipe->free_batches, &pipe->batches[i]);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    // 从下游起启动各阶段，按实际创建成功的线程数运行；某一阶段一个线程也没有时不再启动上游，
+    // 改由此处向已启动的最上游阶段送结束标记，各阶段照常逐级退出，写出阶段随即收到结束
+    pthread_t reader, normalizers[RESOLVE_MAX_THREADS], resolvers[RESOLVE_MAX_THREADS];
+    int started = 0;
+    while (started < pipe->resolvers && pthread_create(&resolvers[started], NULL, resolveResolverMain, pipe) == 0) {
+        started++;
+    }
+    pipe->resolvers = pipe->resolvers_left = started;
+    started = 0;
+    while (pipe->resolvers > 0 && started < pipe->normalizers &&
+           pthread_create(&normalizers[started], NULL, resolveNormalizerMain, pipe) == 0) {
+        started++;
+    }
+    pipe->normalizers = pipe->normalizers_left = started;
+    int reading = pipe->normalizers > 0 && pthread_create(&reader, NULL, resolveReaderMain, pipe) == 0;
+    if (reading) {
+        // 输出到标准输出时结果与提示分开，提示写到标准错误
+        fprintf(stderr, "%s：读取 %s（%s），规范化 %d 线程，解析 %d 线程\n",
+                title, input, asyncReaderModeName(pipe->reader), pipe->normalizers, pipe->resolvers);
+    } else {
+        fprintf(stderr, "%s：无法创建流水线线程\n", title);
+        if (pipe->normalizers > 0) {
+            for (int i = 0; i < pipe->normalizers; i++) pipeQueuePush(&pipe->to_normalize, &g_pipe_end);
+        } else if (pipe->resolvers > 0) {
+            for (int i = 0; i < pipe->resolvers; i++) pipeQueuePush(&pipe->to_resolve, &g_pipe_end);
+        } else {
+            pipeQueuePush(&pipe->to_write, &g_pipe_end);
+        }
+    }
+
+    // 写出阶段在当前线程：乱序到达的批按序号暂存，凑齐下一批即写出并归还
+    struct ResolveBatch* pending[RESOLVE_BATCHES] = { NULL };
+    uint64_t next = 0;
+    long lines = 0, resolved = 0;
+    uint64_t bytes = 0;
+    int write_failed = 0;
+    struct ResolveBatch* batch;
+    while ((batch = pipeQueuePop(&pipe->to_write)) != &g_pipe_end) {
+        pending[batch->seq % RESOLVE_BATCHES] = batch;
+        while ((batch = pending[next % RESOLVE_BATCHES]) != NULL && batch->seq == next) {
+            if (!write_failed && fwrite(batch->out.data, 1, batch->out.length, out) != batch->out.length) {
+                perror("写出解析结果失败");
+                write_failed = 1;
+            }
+            lines += batch->line_count;
+            resolved += batch->resolved;
+            bytes += batch->input_length;
+            pending[next % RESOLVE_BATCHES] = NULL;
+            next++;
+            pipeQueuePush(&pipe->free_batches, batch);
+        }
+    }
+
+    if (reading) pthread_join(reader, NULL);
+    for (int i = 0; i < pipe->normalizers; i++) pthread_join(normalizers[i], NULL);
+    for (int i = 0; i < pipe->resolvers; i++) pthread_join(resolvers[i], NULL);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if ((out != stream ? fclose(out) : fflush(out)) != 0 && !write_failed) {
+        perror("写出解析结果失败");
+        write_failed = 1;
+    }
+    double seconds = (double)(end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    if (reading) fprintf(stderr, "%s完成：%ld 行，解析成功 %ld 行（%.1f%%），耗时 %.2f 秒（%.1f MB/s）\n",
+                         title, lines, resolved, lines ? 100.0 * resolved / lines : 0.0, seconds,
+                         seconds > 0 ? bytes / seconds / (1 << 20) : 0.0);
+
+    int failed = !reading || pipe->read_failed || write_failed;
+    if (pipe->read_failed) fprintf(stderr, "读取输入文件出错，结果不完整\n");
+    for (int i = 0; i < RESOLVE_BATCHES; i++) free(pipe->batches[i].out.data);
+    asyncReaderClose(pipe->reader);
+    free(pipe);
+    return failed ? 1 : 0;
+}
+#else
+int runResolvePipeline(struct TreeNode* root, const char* input, const char* output, int kind) {
+    (void)root;
+    (void)input;
+    (void)output;
+    (void)kind;
+    printf("地址解析流水线暂不支持Windows\n");
+    return 1;
+}
+#endif
+
+// 20. 区划边界函数组
+/**
+ * @brief GeoJSON读取游标（输入整体读入内存并以'\0'结尾）
+ */
+struct JsonCursor {
+    const char* p;
+    int failed;
+};
+
+static void jsonSpace(struct JsonCursor* c) {
+    while (*c->p == ' ' || *c->p == '\t' || *c->p == '\r' || *c->p == '\n') c->p++;
+}
+
+static int jsonExpect(struct JsonCursor* c, char ch) {
+    jsonSpace(c);
+    if (*c->p != ch) {
+        c->failed = 1;
+        return -1;
+    }
+    c->p++;
+    return 0;
+}
+
+/**
+ * @brief 读取字符串，out为NULL时只跳过；转义只保留被转义的字符，\\u按原样保留
+ */
+static int jsonString(struct JsonCursor* c, char* out, size_t capacity) {
+    size_t length = 0;
+    if (jsonExpect(c, '"') != 0) return -1;
+    while (*c->p != '"') {
+        if (*c->p == '\0') {
+            c->failed = 1;
+            return -1;
+        }
+        if (*c->p == '\\' && c->p[1] != '\0') c->p++;
+        if (out != NULL && length + 1 < capacity) out[length++] = *c->p;
+        c->p++;
+    }
+    c->p++;
+    if (out != NULL) out[length] = '\0';
+    return 0;
+}
+
+/**
+ * @brief 跳过任意值（对象与数组按括号深度跳过，其中的字符串单独处理）
+ */
+static int jsonSkip(struct JsonCursor* c) {
+    int depth = 0;
+    jsonSpace(c);
+    if (*c->p == '"') return jsonString(c, NULL, 0);
+    if (*c->p != '{' && *c->p != '[') {
+        // 数字、true、false、null
+        while (*c->p != '\0' && strchr(",}] \t\r\n", *c->p) == NULL) c->p++;
+        return 0;
+    }
+    do {
+        if (*c->p == '\0') {
+            c->failed = 1;
+            return -1;
+        }
+        if (*c->p == '"') {
+            if (jsonString(c, NULL, 0) != 0) return -1;
+            continue;
+        }
+        if (*c->p == '{' || *c->p == '[') depth++;
+        if (*c->p == '}' || *c->p == ']') depth--;
+        c->p++;
+    } while (depth > 0);
+    return 0;
+}
+
+/**
+ * @brief 在对象中逐个遍历成员，返回1表示读到一个键，0表示对象结束
+ */
+static int jsonNextMember(struct JsonCursor* c, int* first, char* key, size_t capacity) {
+    jsonSpace(c);
+    if (*c->p == '}') {
+        c->p++;
+        return 0;
+    }
+    if (!*first && jsonExpect(c, ',') != 0) return -1;
+    *first = 0;
+    if (jsonString(c, key, capacity) != 0 || jsonExpect(c, ':') != 0) return -1;
+    return 1;
+}
+
+/**
+ * @brief 同上，遍历数组元素
+ */
+static int jsonNextElement(struct JsonCursor* c, int* first) {
+    jsonSpace(c);
+    if (*c->p == ']') {
+        c->p++;
+        return 0;
+    }
+    if (!*first && jsonExpect(c, ',') != 0) return -1;
+    *first = 0;
+    jsonSpace(c);
+    return 1;
+}
+
+static void* growArray(void* data, size_t* capacity, size_t needed, size_t item) {
+    if (needed <= *capacity) return data;
+    size_t grown = *capacity ? *capacity * 2 : 1024;
+    while (grown < needed) grown *= 2;
+    void* result = realloc(data, grown * item);
+    if (result != NULL) *capacity = grown;
+    return result;
+}
+
+/**
+ * @brief 读入一个环 [[经度,纬度],...]，首尾重复的闭合点保留（不影响射线法）
+ */
+static int boundaryParseRing(struct JsonCursor* c, struct Boundaries* b) {
+    int first = 1, more;
+    uint32_t begin = (uint32_t)b->point_count;
+
+    if (jsonExpect(c, '[') != 0) return -1;
+    while ((more = jsonNextElement(c, &first)) == 1) {
+        int inner = 1, index = 0;
+        double xy[2] = { 0, 0 };
+        if (jsonExpect(c, '[') != 0) return -1;
+        while ((more = jsonNextElement(c, &inner)) == 1) {
+            char* end;
+            double value = strtod(c->p, &end);
+            if (end == c->p) {
+                c->failed = 1;
+                return -1;
+            }
+            c->p = end;
+            if (index < 2) xy[index] = value;  // 高程等多余分量忽略
+            index++;
+        }
+        if (more < 0 || index < 2) return -1;
+
+        double* points = growArray(b->points, &b->point_capacity, b->point_count + 1, 2 * sizeof(double));
+        if (points == NULL) return -1;
+        b->points = points;
+        b->points[2 * b->point_count] = xy[0];
+        b->points[2 * b->point_count + 1] = xy[1];
+        b->point_count++;
+    }
+    if (more < 0) return -1;
+
+    // 不足三个点的环无面积，丢弃
+    if (b->point_count - begin < 3) {
+        b->point_count = begin;
+        return 0;
+    }
+    uint32_t* rings = growArray(b->rings, &b->ring_capacity, b->ring_count + 2, sizeof(uint32_t));
+    if (rings == NULL) return -1;
+    b->rings = rings;
+    b->rings[b->ring_count++] = begin;
+    b->rings[b->ring_count] = (uint32_t)b->point_count;  // 末尾哨兵，下一个环写入时覆盖
+    return 0;
+}
+
+/**
+ * @brief 读入一个多边形 [外环, 内环...]，内环为洞
+ */
+static int boundaryParsePolygon(struct JsonCursor* c, struct Boundaries* b, const struct TreeNode* node) {
+    int first = 1, more;
+    uint32_t ring_begin = (uint32_t)b->ring_count;
+
+    if (jsonExpect(c, '[') != 0) return -1;
+    while ((more = jsonNextElement(c, &first)) == 1) {
+        if (boundaryParseRing(c, b) != 0) return -1;
+    }
+    if (more < 0) return -1;
+    if (b->ring_count == ring_begin) return 0;
+
+    struct BoundaryPolygon* polygons = growArray(b->polygons, &b->polygon_capacity, b->polygon_count + 1,
+                                                 sizeof(struct BoundaryPolygon));
+    if (polygons == NULL) return -1;
+    b->polygons = polygons;
+
+    struct BoundaryPolygon* polygon = &b->polygons[b->polygon_count++];
+    polygon->node = node->dfs_index;
+    polygon->level = node->data.level;
+    polygon->ring_begin = ring_begin;
+    polygon->ring_count = (uint32_t)b->ring_count - ring_begin;
+    polygon->min_x = polygon->max_x = b->points[2 * b->rings[ring_begin]];
+    polygon->min_y = polygon->max_y = b->points[2 * b->rings[ring_begin] + 1];
+    // 外包框只需外环
+    for (uint32_t i = b->rings[ring_begin]; i < b->rings[ring_begin + 1]; i++) {
+        double x = b->points[2 * i], y = b->points[2 * i + 1];
+        if (x < polygon->min_x) polygon->min_x = x;
+        if (x > polygon->max_x) polygon->max_x = x;
+        if (y < polygon->min_y) polygon->min_y = y;
+        if (y > polygon->max_y) polygon->max_y = y;
+    }
+    return 0;
+}
+
+/**
+ * @brief 读入geometry对象，支持Polygon与MultiPolygon（多块各自成为一个多边形）
+ * @return 0成功，1为不支持的几何类型（跳过），-1格式错误
+ */
+static int boundaryParseGeometry(struct JsonCursor* c, struct Boundaries* b, const struct TreeNode* node) {
+    char key[32], type[32] = "";
+    const char* coordinates = NULL;
+    int first = 1, more;
+
+    jsonSpace(c);
+    if (strncmp(c->p, "null", 4) == 0) return 1;
+    if (jsonExpect(c, '{') != 0) return -1;
+    while ((more = jsonNextMember(c, &first, key, sizeof(key))) == 1) {
+        jsonSpace(c);
+        if (strcmp(key, "type") == 0) {
+            if (jsonString(c, type, sizeof(type)) != 0) return -1;
+        } else {
+            if (strcmp(key, "coordinates") == 0) coordinates = c->p;
+            if (jsonSkip(c) != 0) return -1;
+        }
+    }
+    if (more < 0) return -1;
+    if (coordinates == NULL) return 1;
+
+    struct JsonCursor inner = { coordinates, 0 };
+    if (strcmp(type, "Polygon") == 0) return boundaryParsePolygon(&inner, b, node);
+    if (strcmp(type, "MultiPolygon") != 0) return 1;
+
+    first = 1;
+    if (jsonExpect(&inner, '[') != 0) return -1;
+    while ((more = jsonNextElement(&inner, &first)) == 1) {
+        if (boundaryParsePolygon(&inner, b, node) != 0) return -1;
+    }
+    return more < 0 ? -1 : 0;
+}
+
+/**
+ * @brief 读入一个Feature：properties中的code（或adcode）须为树中已有的12位代码
+ * @details 成员顺序不定，先记下properties与geometry的位置，整个对象读完后再解析
+ * @return 1已加入，0跳过，-1格式错误
+ */
+static int boundaryParseFeature(struct JsonCursor* c, struct Boundaries* b) {
+    char key[32], code[MAX_CODE_LENGTH] = "";
+    const char* properties = NULL;
+    const char* geometry = NULL;
+    int first = 1, more;
+
+    if (jsonExpect(c, '{') != 0) return -1;
+    while ((more = jsonNextMember(c, &first, key, sizeof(key))) == 1) {
+        jsonSpace(c);
+        if (strcmp(key, "properties") == 0) properties = c->p;
+        if (strcmp(key, "geometry") == 0) geometry = c->p;
+        if (jsonSkip(c) != 0) return -1;
+    }
+    if (more < 0 || properties == NULL || geometry == NULL) return more < 0 ? -1 : 0;
+
+    struct JsonCursor inner = { properties, 0 };
+    first = 1;
+    if (jsonExpect(&inner, '{') != 0) return -1;
+    while ((more = jsonNextMember(&inner, &first, key, sizeof(key))) == 1) {
+        jsonSpace(&inner);
+        if ((strcmp(key, "code") == 0 || strcmp(key, "adcode") == 0) && code[0] == '\0') {
+            if (*inner.p == '"') {
+                if (jsonString(&inner, code, sizeof(code)) != 0) return -1;
+                continue;
+            }
+            // 数字形式的代码
+            size_t length = strspn(inner.p, "0123456789");
+            if (length < sizeof(code)) {
+                memcpy(code, inner.p, length);
+                code[length] = '\0';
+            }
+        }
+        if (jsonSkip(&inner) != 0) return -1;
+    }
+    if (more < 0) return -1;
+
+    if (validateCode(code) != 0) return 0;
+    struct TreeNode* node = findNodeByCode(g_index.root, code);
+    if (node == NULL || node->dfs_index < 0) return 0;
+
+    inner = (struct JsonCursor){ geometry, 0 };
+    int result = boundaryParseGeometry(&inner, b, node);
+    return result < 0 ? -1 : result == 0;
+}
+
+/**
+ * @brief 重建均匀网格：每格记录外包框与之相交的多边形（CSR布局）
+ * @details 格数约为多边形数的两倍，绝大多数查询只需检查一格内的几个多边形
+ */
+static int boundaryBuildGrid(struct Boundaries* b) {
+    free(b->cell_offsets);
+    free(b->cell_items);
+    b->cell_offsets = NULL;
+    b->cell_items = NULL;
+    if (b->polygon_count == 0) return 0;
+
+    b->min_x = b->max_x = b->polygons[0].min_x;
+    b->min_y = b->max_y = b->polygons[0].min_y;
+    for (size_t i = 0; i < b->polygon_count; i++) {
+        const struct BoundaryPolygon* polygon = &b->polygons[i];
+        if (polygon->min_x < b->min_x) b->min_x = polygon->min_x;
+        if (polygon->max_x > b->max_x) b->max_x = polygon->max_x;
+        if (polygon->min_y < b->min_y) b->min_y = polygon->min_y;
+        if (polygon->max_y > b->max_y) b->max_y = polygon->max_y;
+    }
+
+    double width = b->max_x - b->min_x, height = b->max_y - b->min_y;
+    double cells = (double)b->polygon_count * 2;
+    if (cells > BOUNDARY_MAX_CELLS) cells = BOUNDARY_MAX_CELLS;
+    if (width <= 0) width = 1e-9;
+    if (height <= 0) height = 1e-9;
+    // 格边长从整个范围开始逐次减半，格数达到目标即停
+    b->cell_size = width > height ? width : height;
+    while ((width / b->cell_size) * (height / b->cell_size) * 4 <= cells) b->cell_size /= 2;
+    b->columns = (int)(width / b->cell_size) + 1;
+    b->rows = (int)(height / b->cell_size) + 1;
+
+    size_t cell_count = (size_t)b->columns * b->rows;
+    b->cell_offsets = calloc(cell_count + 1, sizeof(uint32_t));
+    if (b->cell_offsets == NULL) return -1;
+
+    // 第一遍统计每格的多边形数，第二遍按偏移填入
+    for (int pass = 0; pass < 2; pass++) {
+        for (size_t i = 0; i < b->polygon_count; i++) {
+            const struct BoundaryPolygon* polygon = &b->polygons[i];
+            int x0 = (int)((polygon->min_x - b->min_x) / b->cell_size);
+            int x1 = (int)((polygon->max_x - b->min_x) / b->cell_size);
+            int y0 = (int)((polygon->min_y - b->min_y) / b->cell_size);
+            int y1 = (int)((polygon->max_y - b->min_y) / b->cell_size);
+            for (int y = y0; y <= y1; y++) {
+                for (int x = x0; x <= x1; x++) {
+                    size_t cell = (size_t)y * b->columns + x;
+                    if (pass == 0) {
+                        b->cell_offsets[cell + 1]++;
+                    } else {
+                        b->cell_items[b->cell_offsets[cell]++] = (uint32_t)i;
+                    }
+                }
+            }
+        }
+        if (pass == 0) {
+            for (size_t cell = 0; cell < cell_count; cell++) b->cell_offsets[cell + 1] += b->cell_offsets[cell];
+            b->cell_items = malloc(sizeof(uint32_t) * (b->cell_offsets[cell_count] + 1));
+            if (b->cell_items == NULL) return -1;
+        }
+    }
+    // 填充时偏移前移了一格，复原
+    memmove(b->cell_offsets + 1, b->cell_offsets, sizeof(uint32_t) * cell_count);
+    b->cell_offsets[0] = 0;
+    return 0;
+}
+
+int loadBoundaries(const char* filename) {
+    struct Boundaries* b = &g_boundaries;
+    clock_t start = clock();
+    size_t size;
+    char* text = readWholeFile(filename, &size);
+    if (text == NULL) return -1;
+
+    // 只识别FeatureCollection顶层的features数组，其余成员跳过
+    struct JsonCursor c = { text, 0 };
+    char key[32];
+    int first = 1, more, loaded = 0, skipped = 0, error = jsonExpect(&c, '{') != 0;
+    size_t polygons_before = b->polygon_count;
+    while (!error && (more = jsonNextMember(&c, &first, key, sizeof(key))) != 0) {
+        if (more < 0) {
+            error = 1;
+        } else if (strcmp(key, "features") != 0) {
+            error = jsonSkip(&c) != 0;
+        } else {
+            int element = 1;
+            error = jsonExpect(&c, '[') != 0;
+            while (!error && (more = jsonNextElement(&c, &element)) != 0) {
+                int result = more < 0 ? -1 : boundaryParseFeature(&c, b);
+                if (result < 0) error = 1;
+                if (result > 0) loaded++;
+                if (result == 0) skipped++;
+            }
+        }
+    }
+    if (error) {
+        printf("错误：边界文件 %s 格式有误或内存不足（位于第 %ld 字节附近）\n", filename, (long)(c.p - text));
+        free(text);
+        boundaryBuildGrid(b);
+        return -1;
+    }
+    free(text);
+    if (boundaryBuildGrid(b) != 0) {
+        perror("边界网格分配失败");
+        return -1;
+    }
+    printf("边界文件 %s 加载完成：%d 个区划（跳过 %d 个），%zu 个多边形，网格 %dx%d，耗时 %.0f 毫秒\n",
+           filename, loaded, skipped, b->polygon_count - polygons_before, b->columns, b->rows,
+           (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC);
+    return 0;
+}
+
+/**
+ * @brief 射线法判断点是否在多边形内：各环的穿越次数合计为奇数即在内（洞自然排除）
+ */
+static int boundaryContains(const struct Boundaries* b, const struct BoundaryPolygon* polygon, double x, double y) {
+    int inside = 0;
+    for (uint32_t r = polygon->ring_begin; r < polygon->ring_begin + polygon->ring_count; r++) {
+        const double* points = b->points;
+        uint32_t begin = b->rings[r], end = b->rings[r + 1];
+        for (uint32_t i = begin, j = end - 1; i < end; j = i++) {
+            double xi = points[2 * i], yi = points[2 * i + 1];
+            double xj = points[2 * j], yj = points[2 * j + 1];
+            if ((yi > y) != (yj > y) && x < (xj - xi) * (y - yi) / (yj - yi) + xi) inside = !inside;
+        }
+    }
+    return inside;
+}
+
+struct TreeNode* locatePoint(double lat, double lon) {
+    const struct Boundaries* b = &g_boundaries;
+    if (b->cell_offsets == NULL || lon < b->min_x || lon > b->max_x || lat < b->min_y || lat > b->max_y) return NULL;
+
+    int x = (int)((lon - b->min_x) / b->cell_size);
+    int y = (int)((lat - b->min_y) / b->cell_size);
+    size_t cell = (size_t)y * b->columns + x;
+    const struct BoundaryPolygon* best = NULL;
+
+    // 县级与乡级边界同时加载时，取包含该点的最深一级
+    for (uint32_t i = b->cell_offsets[cell]; i < b->cell_offsets[cell + 1]; i++) {
+        const struct BoundaryPolygon* polygon = &b->polygons[b->cell_items[i]];
+        if (best != NULL && polygon->level <= best->level) continue;
+        if (lon < polygon->min_x || lon > polygon->max_x || lat < polygon->min_y || lat > polygon->max_y) continue;
+        if (boundaryContains(b, polygon, lon, lat)) best = polygon;
+    }
+
+    const struct RegionIndex* index = currentIndex();
+    return best != NULL && best->node < index->count ? index->dfs_nodes[best->node] : NULL;
+}
+
+int parseLatLon(const char* text, double* lat, double* lon) {
+    char* end;
+    *lat = strtod(text, &end);
+    if (end == text) return -1;
+    text = end;
+    while (*text == ',' || *text == ' ' || *text == '\t') text++;
+    *lon = strtod(text, &end);
+    if (end == text) return -1;
+    return *lat >= -90 && *lat <= 90 && *lon >= -180 && *lon <= 180 ? 0 : -1;
+}
+
+void freeBoundaries(void) {
+    struct Boundaries* b = &g_boundaries;
+    free(b->polygons);
+    free(b->rings);
+    free(b->points);
+    free(b->cell_offsets);
+    free(b->cell_items);
+    memset(b, 0, sizeof(*b));
+}
+
+// 21. 区划质心函数组
+/**
+ * @brief 经纬度转为单位球面上的三维坐标，弦长与球面距离单调对应
+ */
+static void centroidVector(double lat, double lon, double v[3]) {
+    double phi = lat * M_PI / 180.0, lambda = lon * M_PI / 180.0;
+    v[0] = cos(phi) * cos(lambda);
+    v[1] = cos(phi) * sin(lambda);
+    v[2] = sin(phi);
+}
+
+static double centroidDistance2(const double a[3], const double b[3]) {
+    double dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+    return dx * dx + dy * dy + dz * dz;
+}
+
+/**
+ * @brief 弦长平方换算为球面距离（千米）
+ */
+static double centroidKilometers(double chord2) {
+    double half = sqrt(chord2) / 2;
+    return 2 * EARTH_RADIUS_KM * asin(half < 1 ? half : 1);
+}
+
+/**
+ * @brief 按axis轴快速选择，使区间中第k个位置就位，左侧不大于、右侧不小于它
+ */
+static void centroidSelect(struct CentroidPoint* points, int lo, int hi, int k, int axis) {
+    while (hi - lo > 1) {
+        double pivot = points[lo + (hi - lo) / 2].v[axis];
+        int i = lo, j = hi - 1;
+        while (i <= j) {
+            while (points[i].v[axis] < pivot) i++;
+            while (points[j].v[axis] > pivot) j--;
+            if (i <= j) {
+                struct CentroidPoint swap = points[i];
+                points[i++] = points[j];
+                points[j--] = swap;
+            }
+        }
+        if (k <= j) {
+            hi = j + 1;
+        } else if (k >= i) {
+            lo = i;
+        } else {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 递归构建隐式k-d树：区间[lo, hi)的中点为节点，按跨度最大的轴切分
+ * @details 同时记下每个子树内的DFS序号范围，限定所属区划时据此整枝跳过
+ */
+static void centroidBuild(struct CentroidTree* tree, int lo, int hi) {
+    if (lo >= hi) return;
+
+    double low[3], high[3];
+    for (int a = 0; a < 3; a++) low[a] = high[a] = tree->points[lo].v[a];
+    for (int i = lo + 1; i < hi; i++) {
+        for (int a = 0; a < 3; a++) {
+            if (tree->points[i].v[a] < low[a]) low[a] = tree->points[i].v[a];
+            if (tree->points[i].v[a] > high[a]) high[a] = tree->points[i].v[a];
+        }
+    }
+    int axis = 0;
+    for (int a = 1; a < 3; a++) {
+        if (high[a] - low[a] > high[axis] - low[axis]) axis = a;
+    }
+
+    int mid = lo + (hi - lo) / 2;
+    centroidSelect(tree->points, lo, hi, mid, axis);
+    tree->axes[mid] = (uint8_t)axis;
+    centroidBuild(tree, lo, mid);
+    centroidBuild(tree, mid + 1, hi);
+
+    int dfs_min = tree->points[mid].node, dfs_max = dfs_min;
+    if (lo < mid) {
+        int left = lo + (mid - lo) / 2;
+        if (tree->dfs_min[left] < dfs_min) dfs_min = tree->dfs_min[left];
+        if (tree->dfs_max[left] > dfs_max) dfs_max = tree->dfs_max[left];
+    }
+    if (mid + 1 < hi) {
+        int right = mid + 1 + (hi - mid - 1) / 2;
+        if (tree->dfs_min[right] < dfs_min) dfs_min = tree->dfs_min[right];
+        if (tree->dfs_max[right] > dfs_max) dfs_max = tree->dfs_max[right];
+    }
+    tree->dfs_min[mid] = dfs_min;
+    tree->dfs_max[mid] = dfs_max;
+}
+
+int loadCentroids(const char* filename) {
+    clock_t start = clock();
+    size_t size;
+    char* text = readWholeFile(filename, &size);
+    if (text == NULL) return -1;
+
+    freeCentroids();
+    // 按行切分（换行改为'\0'），第一遍统计各级点数，第二遍写入
+    for (char* p = text; (p = strchr(p, '\n')) != NULL;) *p++ = '\0';
+    int counts[CENTROID_LEVELS] = { 0 };
+    int skipped = 0, result = 0;
+    for (int pass = 0; pass < 2 && result == 0; pass++) {
+        int filled[CENTROID_LEVELS] = { 0 };
+        for (char* line = text; line < text + size; line += strlen(line) + 1) {
+            // 每行：代码,纬度,经度（逗号、空格或制表符分隔，无法识别的行如表头跳过）
+            char code[MAX_CODE_LENGTH];
+            size_t length = strcspn(line, ", \t\r");
+            double lat, lon;
+            struct TreeNode* node = NULL;
+            if (length < sizeof(code) && line[length] != '\0') {
+                memcpy(code, line, length);
+                code[length] = '\0';
+                if (validateCode(code) == 0 && parseLatLon(line + length + 1, &lat, &lon) == 0) {
+                    node = findNodeByCode(g_index.root, code);
+                }
+            }
+
+            if (node == NULL || node->dfs_index < 0 || node->data.level <= 0 || node->data.level >= CENTROID_LEVELS) {
+                if (pass == 0 && line[0] != '\0' && line[0] != '\r') skipped++;
+            } else if (pass == 0) {
+                counts[node->data.level]++;
+            } else {
+                struct CentroidPoint* point = &g_centroids.levels[node->data.level].points[filled[node->data.level]++];
+                centroidVector(lat, lon, point->v);
+                point->node = node->dfs_index;
+            }
+        }
+
+        for (int level = 0; pass == 0 && level < CENTROID_LEVELS; level++) {
+            struct CentroidTree* tree = &g_centroids.levels[level];
+            if (counts[level] == 0) continue;
+            tree->points = malloc(sizeof(struct CentroidPoint) * counts[level]);
+            tree->axes = malloc(counts[level]);
+            tree->dfs_min = malloc(sizeof(int) * counts[level]);
+            tree->dfs_max = malloc(sizeof(int) * counts[level]);
+            if (tree->points == NULL || tree->axes == NULL || tree->dfs_min == NULL || tree->dfs_max == NULL) result = -1;
+            tree->count = counts[level];
+        }
+    }
+    free(text);
+    if (result != 0) {
+        perror("质心索引分配失败");
+        freeCentroids();
+        return -1;
+    }
+
+    int total = 0;
+    for (int level = 0; level < CENTROID_LEVELS; level++) {
+        centroidBuild(&g_centroids.levels[level], 0, g_centroids.levels[level].count);
+        total += g_centroids.levels[level].count;
+    }
+    printf("质心文件 %s 加载完成：%d 个区划（跳过 %d 行），耗时 %.0f 毫秒\n",
+           filename, total, skipped, (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC);
+    return 0;
+}
+
+/**
+ * @brief 最近邻候选（最大堆，堆顶为当前第k近）
+ */
+struct NearestHeap {
+    double distance2[QUERY_MAX_RESULTS];
+    int node[QUERY_MAX_RESULTS];
+    int count;
+    int capacity;
+};
+
+static void nearestHeapPush(struct NearestHeap* heap, double distance2, int node) {
+    int i;
+    if (heap->count < heap->capacity) {
+        i = heap->count++;
+        while (i > 0 && heap->distance2[(i - 1) / 2] < distance2) {
+            heap->distance2[i] = heap->distance2[(i - 1) / 2];
+            heap->node[i] = heap->node[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+    } else {
+        if (distance2 >= heap->distance2[0]) return;
+        // 替换堆顶后下沉
+        i = 0;
+        for (;;) {
+            int child = 2 * i + 1;
+            if (child >= heap->count) break;
+            if (child + 1 < heap->count && heap->distance2[child + 1] > heap->distance2[child]) child++;
+            if (heap->distance2[child] <= distance2) break;
+            heap->distance2[i] = heap->distance2[child];
+            heap->node[i] = heap->node[child];
+            i = child;
+        }
+    }
+    heap->distance2[i] = distance2;
+    heap->node[i] = node;
+}
+
+static void centroidSearch(const struct CentroidTree* tree, int lo, int hi, const double query[3],
+                           int begin, int end, struct NearestHeap* heap) {
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (tree->dfs_max[mid] < begin || tree->dfs_min[mid] >= end) return;
+
+        const struct CentroidPoint* point = &tree->points[mid];
+        if (point->node >= begin && point->node < end) {
+            nearestHeapPush(heap, centroidDistance2(point->v, query), point->node);
+        }
+
+        // 先查询点所在一侧，另一侧只在切分面比当前第k近更近时才查
+        double diff = query[tree->axes[mid]] - point->v[tree->axes[mid]];
+        int near_lo = diff < 0 ? lo : mid + 1, near_hi = diff < 0 ? mid : hi;
+        int far_lo = diff < 0 ? mid + 1 : lo, far_hi = diff < 0 ? hi : mid;
+        centroidSearch(tree, near_lo, near_hi, query, begin, end, heap);
+        if (heap->count == heap->capacity && diff * diff >= heap->distance2[0]) return;
+        lo = far_lo;
+        hi = far_hi;
+    }
+}
+
+int nearestRegions(double lat, double lon, int level, const struct TreeNode* within, int k,
+                   struct TreeNode** results, double* kilometers) {
+    if (level <= 0 || level >= CENTROID_LEVELS || k <= 0) return 0;
+    const struct CentroidTree* tree = &g_centroids.levels[level];
+    struct NearestHeap heap = { .capacity = k < QUERY_MAX_RESULTS ? k : QUERY_MAX_RESULTS };
+    double query[3];
+    int begin = 0, end = INT32_MAX;
+
+    if (within != NULL) {
+        begin = within->dfs_index;
+        end = within->subtree_end;
+    }
+    centroidVector(lat, lon, query);
+    centroidSearch(tree, 0, tree->count, query, begin, end, &heap);
+
+    // 堆中至多k个，插入排序后由近到远输出
+    for (int i = 1; i < heap.count; i++) {
+        double distance2 = heap.distance2[i];
+        int node = heap.node[i], j = i;
+        for (; j > 0 && heap.distance2[j - 1] > distance2; j--) {
+            heap.distance2[j] = heap.distance2[j - 1];
+            heap.node[j] = heap.node[j - 1];
+        }
+        heap.distance2[j] = distance2;
+        heap.node[j] = node;
+    }
+    struct TreeNode* const* nodes = currentIndex()->dfs_nodes;
+    for (int i = 0; i < heap.count; i++) {
+        results[i] = nodes[heap.node[i]];
+        if (kilometers) kilometers[i] = centroidKilometers(heap.distance2[i]);
+    }
+    return heap.count;
+}
+
+int parseNearestQuery(const char* text, struct NearestQuery* query) {
+    // 纬度,经度,级别[,代码]
+    char* end;
+    query->lat = strtod(text, &end);
+    if (end == text || *end != ',') return -1;
+    query->lon = strtod(end + 1, &end);
+    if (*end != ',') return -1;
+    query->level = (int)strtol(end + 1, &end, 10);
+    query->within[0] = '\0';
+    if (*end == ',') {
+        size_t length = strlen(end + 1);
+        if (length >= sizeof(query->within)) return -1;
+        memcpy(query->within, end + 1, length + 1);
+        if (validateCode(query->within) != 0) return -1;
+    } else if (*end != '\0') {
+        return -1;
+    }
+    if (query->lat < -90 || query->lat > 90 || query->lon < -180 || query->lon > 180) return -1;
+    return query->level > 0 && query->level < CENTROID_LEVELS ? 0 : -1;
+}
+
+/**
+ * @brief 批量最近区划：解析一行查询并返回最近的一个区划，找不到时返回NULL
+ */
+struct TreeNode* resolveNearestLine(struct TreeNode* root, const char* line, double* kilometers) {
+    struct NearestQuery query;
+    struct TreeNode* within = NULL;
+    struct TreeNode* node;
+    if (parseNearestQuery(line, &query) != 0) return NULL;
+    if (query.within[0] != '\0' && (within = findNodeByCode(root, query.within)) == NULL) return NULL;
+    return nearestRegions(query.lat, query.lon, query.level, within, 1, &node, kilometers) == 1 ? node : NULL;
+}
+
+void freeCentroids(void) {
+    for (int level = 0; level < CENTROID_LEVELS; level++) {
+        struct CentroidTree* tree = &g_centroids.levels[level];
+        free(tree->points);
+        free(tree->axes);
+        free(tree->dfs_min);
+        free(tree->dfs_max);
+        memset(tree, 0, sizeof(*tree));
+    }
+}
+
+// 22. 区划邻接函数组
+static int compareEdges(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief DFS序号转为邻接图中的顶点号，不在图中时返回-1
+ */
+static int adjacencyVertex(int node) {
+    int lo = 0, hi = g_adjacency.vertex_count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (g_adjacency.vertex_nodes[mid] < node) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < g_adjacency.vertex_count && g_adjacency.vertex_nodes[lo] == node ? lo : -1;
+}
+
+/**
+ * @brief 读入相邻区划对，构建CSR邻接表
+ * @details 每行 "代码A,代码B"（逗号、空格或制表符分隔），按无向边双向登记；
+ *          边按(起点DFS序号, 终点DFS序号)排序去重后，起点相同的连续一段即为该顶点的邻接表
+ */
+int loadAdjacency(const char* filename) {
+    clock_t start = clock();
+    size_t size, capacity = 0, count = 0;
+    char* text = readWholeFile(filename, &size);
+    uint64_t* edges = NULL;
+    int skipped = 0;
+    if (text == NULL) return -1;
+
+    freeAdjacency();
+    for (char* p = text; (p = strchr(p, '\n')) != NULL;) *p++ = '\0';
+    for (char* line = text; line < text + size; line += strlen(line) + 1) {
+        // 两个代码都能找到且不同才登记，否则（包括表头）跳过
+        struct TreeNode* ends[2] = { NULL, NULL };
+        const char* p = line;
+        for (int i = 0; i < 2; i++) {
+            char code[MAX_CODE_LENGTH];
+            p += strspn(p, ", \t");
+            size_t length = strcspn(p, ", \t\r");
+            if (length == 0 || length >= sizeof(code)) break;
+            memcpy(code, p, length);
+            code[length] = '\0';
+            p += length;
+            if (validateCode(code) == 0) ends[i] = findNodeByCode(g_index.root, code);
+        }
+        if (ends[0] == NULL || ends[1] == NULL || ends[0] == ends[1] ||
+            ends[0]->dfs_index < 0 || ends[1]->dfs_index < 0) {
+            if (line[0] != '\0' && line[0] != '\r') skipped++;
+            continue;
+        }
+
+        uint64_t* grown = growArray(edges, &capacity, count + 2, sizeof(uint64_t));
+        if (grown == NULL) {
+            perror("邻接表分配失败");
+            free(edges);
+            free(text);
+            return -1;
+        }
+        edges = grown;
+        uint64_t a = (uint32_t)ends[0]->dfs_index, b = (uint32_t)ends[1]->dfs_index;
+        edges[count++] = a << 32 | b;
+        edges[count++] = b << 32 | a;
+    }
+    free(text);
+
+    qsort(edges, count, sizeof(uint64_t), compareEdges);
+    size_t unique = 0;
+    int vertices = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (unique > 0 && edges[unique - 1] == edges[i]) continue;
+        if (unique == 0 || edges[unique - 1] >> 32 != edges[i] >> 32) vertices++;
+        edges[unique++] = edges[i];
+    }
+
+    g_adjacency.vertex_nodes = malloc(sizeof(int) * (vertices + 1));
+    g_adjacency.offsets = malloc(sizeof(int) * (vertices + 1));
+    g_adjacency.targets = malloc(sizeof(int) * (unique + 1));
+    if (g_adjacency.vertex_nodes == NULL || g_adjacency.offsets == NULL || g_adjacency.targets == NULL) {
+        perror("邻接表分配失败");
+        free(edges);
+        freeAdjacency();
+        return -1;
+    }
+    int vertex = -1;
+    for (size_t i = 0; i < unique; i++) {
+        int from = (int)(edges[i] >> 32);
+        if (vertex < 0 || g_adjacency.vertex_nodes[vertex] != from) {
+            g_adjacency.vertex_nodes[++vertex] = from;
+            g_adjacency.offsets[vertex] = (int)i;
+        }
+    }
+    g_adjacency.offsets[vertices] = (int)unique;
+    g_adjacency.vertex_count = vertices;
+    g_adjacency.edge_count = (int)unique;
+    // 顶点号按DFS序分配，邻接表内的顶点号因此也有序
+    for (size_t i = 0; i < unique; i++) {
+        g_adjacency.targets[i] = adjacencyVertex((int)(uint32_t)edges[i]);
+    }
+    free(edges);
+
+    printf("邻接文件 %s 加载完成：%d 个区划，%d 条相邻关系（跳过 %d 行），耗时 %.0f 毫秒\n",
+           filename, vertices, (int)(unique / 2), skipped, (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC);
+    return 0;
+}
+
+int regionNeighbors(const struct TreeNode* source, int hops, int same_parent, struct TreeNode** results,
+                    int* distances, int max_results) {
+    int start = adjacencyVertex(source->dfs_index);
+    if (start < 0 || hops <= 0) return 0;
+
+    // 已访问位图与队列都按顶点数分配在临时区，队列中每一跳的顶点连续存放
+    size_t mark = scratchMark();
+    int words = (g_adjacency.vertex_count + 63) / 64;
+    uint64_t* visited = scratchAlloc(sizeof(uint64_t) * words);
+    int* queue = scratchAlloc(sizeof(int) * g_adjacency.vertex_count);
+    if (visited == NULL || queue == NULL) {
+        scratchReset(mark);
+        return 0;
+    }
+    memset(visited, 0, sizeof(uint64_t) * words);
+
+    struct TreeNode* const* nodes = currentIndex()->dfs_nodes;
+    int head = 0, tail = 0, count = 0;
+    visited[start / 64] |= 1ULL << (start % 64);
+    queue[tail++] = start;
+    for (int hop = 1; hop <= hops && head < tail; hop++) {
+        int ring_end = tail;
+        for (; head < ring_end; head++) {
+            int vertex = queue[head];
+            for (int e = g_adjacency.offsets[vertex]; e < g_adjacency.offsets[vertex + 1]; e++) {
+                int next = g_adjacency.targets[e];
+                if (visited[next / 64] & (1ULL << (next % 64))) continue;
+                visited[next / 64] |= 1ULL << (next % 64);
+                queue[tail++] = next;
+
+                // 同上级过滤只作用于结果，不同上级的区划仍可作为中转
+                struct TreeNode* node = nodes[g_adjacency.vertex_nodes[next]];
+                if (same_parent && node->parent != source->parent) continue;
+                if (count < max_results) {
+                    results[count] = node;
+                    if (distances) distances[count] = hop;
+                }
+                count++;
+            }
+        }
+    }
+    scratchReset(mark);
+    return count < max_results ? count : max_results;
+}
+
+int parseNeighborQuery(const char* text, struct NeighborQuery* query) {
+    // 代码[,跳数[,仅同上级]]
+    size_t length = strcspn(text, ",");
+    char* end;
+    if (length == 0 || length >= sizeof(query->code)) return -1;
+    memcpy(query->code, text, length);
+    query->code[length] = '\0';
+    query->hops = 1;
+    query->same_parent = 0;
+    text += length;
+    if (*text == ',') {
+        query->hops = (int)strtol(text + 1, &end, 10);
+        if (end == text + 1) return -1;
+        text = end;
+    }
+    if (*text == ',') {
+        query->same_parent = (int)strtol(text + 1, &end, 10) != 0;
+        if (end == text + 1) return -1;
+        text = end;
+    }
+    if (*text != '\0' && *text != '\r') return -1;
+    if (query->hops < 1 || query->hops > NEIGHBOR_MAX_HOPS) return -1;
+    return validateCode(query->code);
+}
+
+/**
+ * @brief 批量邻接查询：追加一行 原文\t代码\t层级路径\t邻居代码:跳数,...，找不到时代码与路径为空
+ * @return 找到起点返回1，否则返回0
+ */
+int appendNeighborLine(struct TreeNode* root, const char* line, struct QueryOutput* out) {
+    struct NeighborQuery query;
+    struct TreeNode* source = NULL;
+    char buffer[MAX_LINE_LENGTH * 2];
+
+    if (parseNeighborQuery(line, &query) == 0) source = findNodeByCode(root, query.code);
+    int length = snprintf(buffer, sizeof(buffer), "%s\t%s\t", line, source ? source->data.code : "");
+    if (source != NULL) {
+        int path = formatNodePath(source, buffer + length, sizeof(buffer) - 1 - length);
+        if (path > 0) length += path;
+    }
+    queryOutputAppend(out, buffer, (size_t)length);
+    if (source == NULL) {
+        queryOutputAppend(out, "\n", 1);
+        return 0;
+    }
+
+    size_t mark = scratchMark();
+    struct TreeNode** results = scratchAlloc(sizeof(struct TreeNode*) * (g_adjacency.vertex_count + 1));
+    int* hops = scratchAlloc(sizeof(int) * (g_adjacency.vertex_count + 1));
+    int count = results && hops ? regionNeighbors(source, query.hops, query.same_parent, results, hops,
+                                                  g_adjacency.vertex_count) : 0;
+    queryOutputAppend(out, "\t", 1);
+    for (int i = 0; i < count; i++) {
+        length = snprintf(buffer, sizeof(buffer), "%s%s:%d", i ? "," : "", results[i]->data.code, hops[i]);
+        queryOutputAppend(out, buffer, (size_t)length);
+    }
+    queryOutputAppend(out, "\n", 1);
+    scratchReset(mark);
+    return 1;
+}
+
+void freeAdjacency(void) {
+    free(g_adjacency.vertex_nodes);
+    free(g_adjacency.offsets);
+    free(g_adjacency.targets);
+    memset(&g_adjacency, 0, sizeof(g_adjacency));
+}
+
+// 23. 索引文件函数组
+static int writePadding(FILE* file, uint64_t* offset) {
+    static const char zeros[64];
+    size_t pad = (size_t)((64 - *offset % 64) % 64);
+    *offset += pad;
+    return fwrite(zeros, 1, pad, file) == pad ? 0 : -1;
+}
+
+static int writeSection(FILE* file, const void* data, size_t bytes, uint64_t* offset, uint64_t* section_offset) {
+    if (writePadding(file, offset) != 0) return -1;
+    *section_offset = *offset;
+    *offset += bytes;
+    return bytes == 0 || fwrite(data, 1, bytes, file) == bytes ? 0 : -1;
+}
+
+static int hasExtraData(const struct Region* data) {
+    return hasHousePrice(data) || hasEmploymentRate(data);
+}
+
+int writeIndexBlob(const char* filename) {
+    const struct RegionIndex* index = &g_index;
+    if (index->root == NULL || index->codes.count != index->count) {
+        printf("错误：代码列未建立（DFS序与代码序不一致），无法生成索引文件\n");
+        return -1;
+    }
+
+    int count = index->count;
+    struct IndexBlobRecord* records = calloc(count, sizeof(*records));
+    struct IndexBlobExtra* extras = calloc(count, sizeof(*extras));
+    size_t strings_cap = (size_t)count * 32, strings_size = 0;
+    char* strings = malloc(strings_cap);
+    if (records == NULL || extras == NULL || strings == NULL) {
+        perror("内存分配失败");
+        free(records);
+        free(extras);
+        free(strings);
+        return -1;
+    }
+
+    uint32_t extra_count = 0;
+    for (int i = 0; i < count && strings != NULL; i++) {
+        const struct Region* data = &index->dfs_nodes[i]->data;
+        const char* texts[2] = { data->name, NULL };
+        uint32_t offsets[2] = { 0, UINT32_MAX };
+
+        records[i].subtree_end = (uint32_t)index->dfs_nodes[i]->subtree_end;
+        records[i].type = (uint16_t)data->type;
+        records[i].level = (uint8_t)data->level;
+        records[i].extra = UINT32_MAX;
+        if (hasExtraData(data)) {
+            records[i].extra = extra_count;
+            extras[extra_count].avg_house_price = data->avg_house_price ? *data->avg_house_price : 0.0;
+            texts[1] = data->employment_rate;
+        }
+
+        for (int t = 0; t < 2; t++) {
+            if (texts[t] == NULL) continue;
+            size_t len = strlen(texts[t]) + 1;
+            if (strings_size + len > strings_cap) {
+                strings_cap *= 2;
+                char* grown = realloc(strings, strings_cap);
+                if (grown == NULL) {
+                    free(strings);
+                    strings = NULL;
+                    break;
+                }
+                strings = grown;
+            }
+            memcpy(strings + strings_size, texts[t], len);
+            offsets[t] = (uint32_t)strings_size;
+            strings_size += len;
+        }
+        records[i].name_offset = offsets[0];
+        if (records[i].extra != UINT32_MAX) {
+            extras[extra_count++].employment_offset = offsets[1];
+        }
+    }
+
+    FILE* file = strings ? fopen(filename, "wb") : NULL;
+    if (file == NULL) {
+        perror(strings ? "无法创建索引文件" : "内存分配失败");
+        free(records);
+        free(extras);
+        free(strings);
+        return -1;
+    }
+
+    const struct CodeColumn* col = &index->codes;
+    struct IndexBlobHeader header = { 0 };
+    memcpy(header.magic, INDEX_BLOB_MAGIC, sizeof(header.magic));
+    header.byte_order = INDEX_BLOB_BYTE_ORDER;
+    header.node_count = (uint32_t)count;
+    header.block_count = (uint32_t)col->block_count;
+    header.extra_count = extra_count;
+    header.packed_words = col->packed_words;
+    header.strings_size = strings_size;
+    header.code_levels = (uint32_t)g_code_scheme.level_count;
+    for (int l = 0; l < g_code_scheme.level_count; l++) header.code_digits[l] = (uint8_t)g_code_scheme.digits[l];
+
+    // 完美哈希在生成索引文件时离线构建，运行时只读
+    uint64_t* codes = malloc(count * sizeof(uint64_t));
+    struct CodeMph mph = { 0 };
+    for (int b = 0; codes != NULL && b < col->block_count; b++) {
+        uint64_t block_codes[CODE_BLOCK_SIZE];
+        decodeCodeValues(col, b, block_codes);
+        for (int j = 0; j < CODE_BLOCK_SIZE && b * CODE_BLOCK_SIZE + j < count; j++) {
+            codes[b * CODE_BLOCK_SIZE + j] = block_codes[j];
+        }
+    }
+    printf("正在构建代码完美哈希...");
+    fflush(stdout);
+    if (codes == NULL || buildCodeMph(&mph, codes, count) != 0) {
+        free(codes);
+        free(records);
+        free(extras);
+        free(strings);
+        fclose(file);
+        return -1;
+    }
+    free(codes);
+    printf("完成（%u 个桶，%.2f 位/键）\n", mph.bucket_count,
+           (mph.bucket_count * 16.0 + (mph.table_size - count + 1) * 32.0) / count);
+    header.mph_seed = mph.seed;
+    header.mph_table_size = mph.table_size;
+    header.mph_bucket_count = mph.bucket_count;
+
+    uint64_t offset = sizeof(header);
+    int failed = fwrite(&header, sizeof(header), 1, file) != 1;
+    failed = failed || writeSection(file, records, count * sizeof(*records), &offset, &header.records_offset);
+    failed = failed || writeSection(file, extras, extra_count * sizeof(*extras), &offset, &header.extras_offset);
+    failed = failed || writeSection(file, col->block_base, col->block_count * sizeof(uint64_t), &offset, &header.block_base_offset);
+    failed = failed || writeSection(file, col->block_offset, col->block_count * sizeof(uint32_t), &offset, &header.block_offset_offset);
+    failed = failed || writeSection(file, col->block_bits, col->block_count, &offset, &header.block_bits_offset);
+    failed = failed || writeSection(file, col->packed, col->packed_words * sizeof(uint32_t), &offset, &header.packed_offset);
+    failed = failed || writeSection(file, strings, strings_size, &offset, &header.strings_offset);
+    failed = failed || writeSection(file, mph.pilots, mph.bucket_count * sizeof(uint16_t), &offset, &header.mph_pilots_offset);
+    failed = failed || writeSection(file, mph.remap, (mph.table_size - count + 1) * sizeof(uint32_t), &offset, &header.mph_remap_offset);
+    failed = failed || writeSection(file, mph.slots, count * sizeof(uint32_t), &offset, &header.mph_slots_offset);
+    failed = failed || writePadding(file, &offset) != 0;
+    header.total_size = offset;
+
+    // 各段偏移确定后回写文件头
+    failed = failed || fseek(file, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(header), 1, file) != 1;
+    failed = fclose(file) != 0 || failed;
+
+    free(records);
+    free(extras);
+    free(strings);
+    freeCodeMph(&mph);
+
+    if (failed) {
+        perror("写入索引文件失败");
+        return -1;
+    }
+    printf("已生成索引文件 %s（%d 个节点，%.1f MB）\n", filename, count, offset / 1048576.0);
+    return 0;
+}
+
+static const void* blobSection(const unsigned char* blob, uint64_t offset, uint64_t bytes, uint64_t total) {
+    return (offset <= total && bytes <= total - offset) ? blob + offset : NULL;
+}
+
+/**
+ * @brief 建立节点前校验各记录中的偏移与区间，损坏或伪造的文件不致越界访问
+ * @details 字符串池须以'\0'结尾，此时池内任一偏移处的字符串都不会越过池尾；
+ *          子树区间须满足 i < subtree_end <= count 且逐层嵌套，根节点覆盖全部节点
+ */
+static int checkIndexBlob(const struct IndexBlobHeader* header, const struct IndexBlobRecord* records,
+                          const struct IndexBlobExtra* extras, const uint32_t* block_offset,
+                          const uint8_t* block_bits, const char* strings, int count) {
+    uint64_t strings_size = header->strings_size;
+    if (strings_size == 0 || strings[strings_size - 1] != '\0') return -1;
+
+    for (uint32_t b = 0; b < header->block_count; b++) {
+        int bits = block_bits[b];
+        uint64_t words = bits == CODE_BLOCK_RAW ? CODE_BLOCK_SIZE * 2 : (uint64_t)bits * 4;
+        if ((bits > 32 && bits != CODE_BLOCK_RAW) || block_offset[b] > header->packed_words ||
+            words > header->packed_words - block_offset[b]) {
+            return -1;
+        }
+    }
+
+    for (uint32_t e = 0; e < header->extra_count; e++) {
+        if (extras[e].employment_offset != UINT32_MAX && extras[e].employment_offset >= strings_size) return -1;
+    }
+
+    // 用栈记录尚未结束的各级子树末尾，检查区间逐层嵌套
+    uint32_t open_ends[CODE_SCHEME_MAX_LEVELS + 2];
+    int depth = 0;
+    if (records[0].subtree_end != (uint32_t)count) return -1;
+    for (int i = 0; i < count; i++) {
+        const struct IndexBlobRecord* record = &records[i];
+        if (record->name_offset >= strings_size ||
+            (record->extra != UINT32_MAX && record->extra >= header->extra_count) ||
+            record->subtree_end <= (uint32_t)i || record->subtree_end > (uint32_t)count) {
+            return -1;
+        }
+        while (depth > 0 && open_ends[depth - 1] <= (uint32_t)i) depth--;
+        if (depth > 0 && record->subtree_end > open_ends[depth - 1]) return -1;
+        if (depth == (int)(sizeof(open_ends) / sizeof(open_ends[0]))) return -1;
+        open_ends[depth++] = record->subtree_end;
+    }
+    return 0;
+}
+
+struct TreeNode* loadTreeFromBlob(const unsigned char* blob, size_t size) {
+    const struct IndexBlobHeader* header = (const struct IndexBlobHeader*)blob;
+    if (size < sizeof(*header) || memcmp(header->magic, INDEX_BLOB_MAGIC, sizeof(header->magic)) != 0 ||
+        header->byte_order != INDEX_BLOB_BYTE_ORDER || header->total_size > size) {
+        printf("错误：索引文件格式无效或版本不匹配\n");
+        return NULL;
+    }
+    // 总位数相同而分级不同（如4,4,4与cn12）时代码的级别与上级都会算错，须逐级比较
+    int same_layout = header->code_levels == (uint32_t)g_code_scheme.level_count;
+    for (int l = 0; same_layout && l < g_code_scheme.level_count; l++) {
+        same_layout = header->code_digits[l] == g_code_scheme.digits[l];
+    }
+    if (!same_layout) {
+        char layout[32] = "";
+        int levels = header->code_levels < sizeof(header->code_digits) ? (int)header->code_levels :
+                     (int)sizeof(header->code_digits);
+        for (int l = 0, length = 0; l < levels; l++) {
+            length += snprintf(layout + length, sizeof(layout) - length, l > 0 ? ",%u" : "%u", header->code_digits[l]);
+        }
+        printf("错误：索引文件的代码各级位数为 %s，与代码方案 %s 不符\n", layout, g_code_scheme.name);
+        return NULL;
+    }
+
+    uint64_t total = header->total_size;
+    // 各段字节数由头部字段相乘得出，先限定字段范围防止乘法溢出后绕过段检查
+    if (header->node_count > INT32_MAX || header->packed_words > total / sizeof(uint32_t) ||
+        header->mph_table_size > total) {
+        printf("错误：索引文件格式无效或版本不匹配\n");
+        return NULL;
+    }
+    int count = (int)header->node_count;
+    int blocks = (int)header->block_count;
+    const struct IndexBlobRecord* records = blobSection(blob, header->records_offset, (uint64_t)count * sizeof(*records), total);
+    const struct IndexBlobExtra* extras = blobSection(blob, header->extras_offset, (uint64_t)header->extra_count * sizeof(*extras), total);
+    const uint64_t* block_base = blobSection(blob, header->block_base_offset, (uint64_t)blocks * sizeof(uint64_t), total);
+    const uint32_t* block_offset = blobSection(blob, header->block_offset_offset, (uint64_t)blocks * sizeof(uint32_t), total);
+    const uint8_t* block_bits = blobSection(blob, header->block_bits_offset, (uint64_t)blocks, total);
+    const uint32_t* packed = blobSection(blob, header->packed_offset, header->packed_words * sizeof(uint32_t), total);
+    const char* strings = blobSection(blob, header->strings_offset, header->strings_size, total);
+    uint64_t remap_count = header->mph_table_size - count + 1;
+    const uint16_t* mph_pilots = blobSection(blob, header->mph_pilots_offset, (uint64_t)header->mph_bucket_count * sizeof(uint16_t), total);
+    const uint32_t* mph_remap = blobSection(blob, header->mph_remap_offset, remap_count * sizeof(uint32_t), total);
+    const uint32_t* mph_slots = blobSection(blob, header->mph_slots_offset, (uint64_t)count * sizeof(uint32_t), total);
+
+    if (count <= 0 || !records || !extras || !block_base || !block_offset || !block_bits || !packed || !strings ||
+        blocks != (count + CODE_BLOCK_SIZE - 1) / CODE_BLOCK_SIZE || header->mph_bucket_count == 0 ||
+        header->mph_table_size <= (uint64_t)count || !mph_pilots || !mph_remap || !mph_slots) {
+        printf("错误：索引文件已损坏\n");
+        return NULL;
+    }
+    if (checkIndexBlob(header, records, extras, block_offset, block_bits, strings, count) != 0) {
+        printf("错误：索引文件格式无效或版本不匹配\n");
+        return NULL;
+    }
+
+    // 代码列原样复制到索引区，无需重新编码
+    freeRegionIndex();
+    size_t column_bytes = header->packed_words * sizeof(uint32_t) + (size_t)blocks * 13 + 64;
+    size_t mph_bytes = header->mph_bucket_count * sizeof(uint16_t) + (remap_count + count) * sizeof(uint32_t) + 64;
+    if (arenaInit(&g_node_arena, (size_t)count * sizeof(struct TreeNode)) != 0 ||
+        arenaInit(&g_child_arena, (size_t)count * sizeof(struct TreeNode*)) != 0 ||
+        arenaInit(&g_index_arena, (size_t)count * sizeof(struct TreeNode*) + column_bytes + mph_bytes) != 0) {
+        arenaRelease(&g_node_arena);
+        arenaRelease(&g_child_arena);
+        return NULL;
+    }
+
+    struct CodeColumn* col = &g_index.codes;
+    g_index.dfs_nodes = arenaAlloc(&g_index_arena, (size_t)count * sizeof(struct TreeNode*), sizeof(struct TreeNode*));
+    col->block_base = arenaAlloc(&g_index_arena, blocks * sizeof(uint64_t), sizeof(uint64_t));
+    col->block_offset = arenaAlloc(&g_index_arena, blocks * sizeof(uint32_t), sizeof(uint32_t));
+    col->block_bits = arenaAlloc(&g_index_arena, blocks, 1);
+    col->packed = arenaAlloc(&g_index_arena, header->packed_words * sizeof(uint32_t), 16);
+    memcpy(col->block_base, block_base, blocks * sizeof(uint64_t));
+    memcpy(col->block_offset, block_offset, blocks * sizeof(uint32_t));
+    memcpy(col->block_bits, block_bits, blocks);
+    memcpy(col->packed, packed, header->packed_words * sizeof(uint32_t));
+    col->count = count;
+    col->block_count = blocks;
+    col->packed_words = header->packed_words;
+
+    struct CodeMph* mph = &g_index.mph;
+    mph->seed = header->mph_seed;
+    mph->key_count = (uint32_t)count;
+    mph->bucket_count = header->mph_bucket_count;
+    mph->table_size = header->mph_table_size;
+    mph->pilots = arenaAlloc(&g_index_arena, mph->bucket_count * sizeof(uint16_t), sizeof(uint16_t));
+    mph->remap = arenaAlloc(&g_index_arena, remap_count * sizeof(uint32_t), sizeof(uint32_t));
+    mph->slots = arenaAlloc(&g_index_arena, (size_t)count * sizeof(uint32_t), sizeof(uint32_t));
+    memcpy(mph->pilots, mph_pilots, mph->bucket_count * sizeof(uint16_t));
+    memcpy(mph->remap, mph_remap, remap_count * sizeof(uint32_t));
+    memcpy(mph->slots, mph_slots, (size_t)count * sizeof(uint32_t));
+    for (uint64_t i = 0; i < remap_count; i++) {
+        if (mph->remap[i] >= (uint32_t)count) mph->remap[i] = 0;
+    }
+    for (int i = 0; i < count; i++) {
+        if (mph->slots[i] >= (uint32_t)count) mph->slots[i] = 0;
+    }
+
+    // 节点按DFS序连续存放，子节点依次为 i+1、其子树末尾、……
+    struct TreeNode* nodes = arenaAlloc(&g_node_arena, (size_t)count * sizeof(struct TreeNode), 64);
+    uint64_t block_codes[CODE_BLOCK_SIZE];
+    for (int i = 0; i < count; i++) {
+        struct TreeNode* node = &nodes[i];
+        const struct IndexBlobRecord* record = &records[i];
+        struct Region data = { .level = record->level, .type = record->type };
+
+        if (i % CODE_BLOCK_SIZE == 0) {
+            decodeCodeValues(col, i / CODE_BLOCK_SIZE, block_codes);
+        }
+        formatSchemeCode(block_codes[i % CODE_BLOCK_SIZE], data.code);
+        strncpy(data.name, strings + record->name_offset, MAX_NAME_LENGTH - 1);
+
+        if (record->extra < header->extra_count) {
+            const struct IndexBlobExtra* extra = &extras[record->extra];
+            data.avg_house_price = malloc(sizeof(double));
+            if (data.avg_house_price) *data.avg_house_price = extra->avg_house_price;
+            data.employment_rate = extra->employment_offset == UINT32_MAX ? NULL :
+                strdup(strings + extra->employment_offset);
+        }
+
+        initNode(node, data);
+        node->dfs_index = i;
+        node->subtree_end = (int)record->subtree_end;
+        g_index.dfs_nodes[i] = node;
+    }
+
+    for (int i = 0; i < count; i++) {
+        struct TreeNode* node = &nodes[i];
+        for (int c = i + 1; c < node->subtree_end; c = nodes[c].subtree_end) {
+            node->child_capacity++;
+        }
+        if (node->child_capacity == 0) continue;
+
+        node->children = arenaAlloc(&g_child_arena, node->child_capacity * sizeof(struct TreeNode*), sizeof(struct TreeNode*));
+        for (int c = i + 1; c < node->subtree_end; c = nodes[c].subtree_end) {
+            node->children[node->child_count++] = &nodes[c];
+            nodes[c].parent = node;
+            strcpy(nodes[c].data.parent_code, i == 0 ? "0" : node->data.code);
+        }
+    }
+    strcpy(nodes[0].data.parent_code, "0");
+
+    g_index.root = &nodes[0];
+    g_index.count = count;
+    return g_index.root;
+}
+
+int isIndexBlobFile(const char* filename) {
+    char magic[8];
+    FILE* file = fopen(filename, "rb");
+    if (file == NULL) return 0;
+    // 只比较去掉版本号的标识，其他版本的索引文件交给加载函数报告版本不匹配
+    int match = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                memcmp(magic, INDEX_BLOB_MAGIC, sizeof(magic) - 3) == 0;
+    fclose(file);
+    return match;
+}
+
+struct TreeNode* loadTreeFromBlobFile(const char* filename) {
+    size_t size;
+    unsigned char* blob = (unsigned char*)readWholeFile(filename, &size);
+    if (blob == NULL) return NULL;
+
+    struct TreeNode* root = loadTreeFromBlob(blob, size);
+    free(blob);
+    return root;
+}
+
+// 24. 共享内存IPC函数组
+static void handleStopSignal(int sig) {
+    (void)sig;
+    g_stop_requested = 1;
+}
+
+static void installStopHandlers(void) {
+    signal(SIGINT, handleStopSignal);
+    signal(SIGTERM, handleStopSignal);
+}
+
+static int compareDouble(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+#ifdef __linux__
+static inline void cpuRelax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __asm__ __volatile__("pause");
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+static void futexWait(uint32_t* addr, uint32_t expected, long timeout_ms) {
+    struct timespec timeout = { timeout_ms / 1000, (timeout_ms % 1000) * 1000000L };
+    syscall(SYS_futex, addr, FUTEX_WAIT, expected, &timeout, NULL, 0);
+}
+
+static void futexWake(uint32_t* addr) {
+    syscall(SYS_futex, addr, FUTEX_WAKE, INT32_MAX, NULL, NULL, 0);
+}
+
+/**
+ * @brief 发布一次环更新：推进序号并在对方休眠时唤醒
+ */
+static void ipcNotify(uint32_t* sequence, uint32_t* waiting) {
+    __atomic_add_fetch(sequence, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(waiting, __ATOMIC_SEQ_CST)) {
+        futexWake(sequence);
+    }
+}
+
+/**
+ * @brief 等待序号变化
+ * @details 忙等模式只自旋；futex模式先自旋一段时间，再声明休眠并在序号上等待
+ */
+static void ipcWait(uint32_t* sequence, uint32_t* waiting, uint32_t seen, int wait_mode) {
+    // 单核机器上自旋只会拖延对方，改为让出CPU
+    static int single_cpu = -1;
+    if (single_cpu < 0) single_cpu = sysconf(_SC_NPROCESSORS_ONLN) <= 1;
+
+    int spin_limit = single_cpu ? 0 : IPC_SPIN_LIMIT;
+    for (int spin = 0; spin < spin_limit || wait_mode == IPC_WAIT_POLL; spin++) {
+        if (__atomic_load_n(sequence, __ATOMIC_ACQUIRE) != seen) return;
+        if (single_cpu) {
+            sched_yield();
+        } else {
+            cpuRelax();
+        }
+        if (wait_mode == IPC_WAIT_POLL && (spin & 0xFFFF) == 0xFFFF && g_stop_requested) return;
+    }
+    __atomic_store_n(waiting, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(sequence, __ATOMIC_SEQ_CST) == seen) {
+        futexWait(sequence, seen, IPC_WAIT_TIMEOUT_MS);
+    }
+    __atomic_store_n(waiting, 0, __ATOMIC_RELAXED);
+}
+
+static void ipcSegmentPath(const char* name, char* path, size_t cap) {
+    snprintf(path, cap, "/adiv_%s", name);
+}
+
+static int processAlive(uint32_t pid) {
+    return pid != 0 && (kill((pid_t)pid, 0) == 0 || errno != ESRCH);
+}
+
+int runIpcServer(struct TreeNode* root, const char* name, int wait_mode) {
+    char path[128];
+    ipcSegmentPath(name, path, sizeof(path));
+
+    shm_unlink(path);
+    int fd = shm_open(path, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0 || ftruncate(fd, sizeof(struct IpcSegment)) != 0) {
+        perror("无法创建共享内存");
+        if (fd >= 0) close(fd);
+        return 1;
+    }
+    struct IpcSegment* segment = mmap(NULL, sizeof(*segment), PROT_READ | PROT_WRITE,
+                                      MAP_SHARED | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (segment == MAP_FAILED) {
+        perror("无法映射共享内存");
+        shm_unlink(path);
+        return 1;
+    }
+
+    memset(segment, 0, sizeof(*segment));
+    segment->server_pid = (uint32_t)getpid();
+    segment->wait_mode = (uint32_t)wait_mode;
+    __atomic_store_n(&segment->magic, IPC_MAGIC, __ATOMIC_RELEASE);
+
+    installStopHandlers();
+    printf("IPC服务已启动：/dev/shm%s，%d 个通道，等待方式：%s（Ctrl+C 退出）\n", path, IPC_MAX_CHANNELS,
+           wait_mode == IPC_WAIT_POLL ? "忙等" : "futex");
+    fflush(stdout);
+
+    uint64_t served = 0;
+    while (!g_stop_requested) {
+        uint32_t doorbell = __atomic_load_n(&segment->doorbell, __ATOMIC_ACQUIRE);
+        int progressed = 0;
+
+        for (int c = 0; c < IPC_MAX_CHANNELS; c++) {
+            struct IpcChannel* channel = &segment->channels[c];
+            uint32_t head = channel->req_head;
+            uint32_t tail = __atomic_load_n(&channel->req_tail, __ATOMIC_ACQUIRE);
+            uint32_t resp_tail = channel->resp_tail;
+
+            // 响应环满时暂不取新请求，等客户端消费
+            while (head != tail && resp_tail - __atomic_load_n(&channel->resp_head, __ATOMIC_ACQUIRE) < IPC_RING_SIZE) {
+                const struct IpcRequest* request = &channel->requests[head % IPC_RING_SIZE];
+                struct IpcResponse* response = &channel->responses[resp_tail % IPC_RING_SIZE];
+                struct QueryOutput out = { .data = response->data, .capacity = IPC_RESPONSE_MAX };
+                char arg[IPC_ARG_MAX];
+
+                memcpy(arg, request->arg, IPC_ARG_MAX);
+                arg[IPC_ARG_MAX - 1] = '\0';
+                response->id = request->id;
+                response->status = executeQuery(root, (int)request->op, arg, (int)request->limit, NULL, &out);
+                response->length = (uint32_t)out.length;
+                scratchReset(0);
+
+                head++;
+                resp_tail++;
+                __atomic_store_n(&channel->req_head, head, __ATOMIC_RELEASE);
+                __atomic_store_n(&channel->resp_tail, resp_tail, __ATOMIC_RELEASE);
+                ipcNotify(&channel->resp_seq, &channel->client_waiting);
+                progressed = 1;
+                served++;
+            }
+        }
+
+        if (!progressed) {
+            ipcWait(&segment->doorbell, &segment->server_waiting, doorbell, wait_mode);
+        }
+    }
+
+    printf("\nIPC服务停止，共处理 %llu 个请求\n", (unsigned long long)served);
+    munmap(segment, sizeof(*segment));
+    shm_unlink(path);
+    return 0;
+}
+
+int runIpcClient(const char* name, int wait_mode, int repeat) {
+    char path[128];
+    ipcSegmentPath(name, path, sizeof(path));
+
+    int fd = shm_open(path, O_RDWR, 0600);
+    if (fd < 0) {
+        perror("无法连接IPC服务");
+        return 1;
+    }
+    struct IpcSegment* segment = mmap(NULL, sizeof(*segment), PROT_READ | PROT_WRITE,
+                                      MAP_SHARED | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (segment == MAP_FAILED || __atomic_load_n(&segment->magic, __ATOMIC_ACQUIRE) != IPC_MAGIC) {
+        printf("错误：共享内存不是有效的IPC服务\n");
+        if (segment != MAP_FAILED) munmap(segment, sizeof(*segment));
+        return 1;
+    }
+
+    // 认领一个空闲通道；原持有进程已退出的通道可回收
+    struct IpcChannel* channel = NULL;
+    uint32_t self = (uint32_t)getpid();
+    for (int c = 0; c < IPC_MAX_CHANNELS && channel == NULL; c++) {
+        struct IpcChannel* candidate = &segment->channels[c];
+        uint32_t owner = __atomic_load_n(&candidate->owner, __ATOMIC_ACQUIRE);
+        if (processAlive(owner)) continue;
+        if (__atomic_compare_exchange_n(&candidate->owner, &owner, self, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            // 丢弃上一持有者遗留的未读响应
+            __atomic_store_n(&candidate->resp_head, __atomic_load_n(&candidate->resp_tail, __ATOMIC_ACQUIRE),
+                             __ATOMIC_RELEASE);
+            channel = candidate;
+        }
+    }
+    if (channel == NULL) {
+        printf("错误：IPC通道已满\n");
+        munmap(segment, sizeof(*segment));
+        return 1;
+    }
+
+    printf("已连接IPC服务 %s，输入%d位代码或名称查询（Ctrl+D 结束）\n", path, g_code_scheme.total_digits);
+    char line[IPC_ARG_MAX];
+    // 请求号高位取进程号，与通道上一持有者的请求号不会重复
+    uint64_t next_id = (uint64_t)self << 32 | 1;
+    double* samples = repeat > 1 ? malloc(repeat * sizeof(double)) : NULL;
+
+    while (fgets(line, sizeof(line), stdin)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0') continue;
+
+        int op = validateCode(line) == 0 ? QUERY_OP_CODE : QUERY_OP_NAME;
+        const struct IpcResponse* response = NULL;
+
+        for (int r = 0; r < repeat; r++) {
+            struct timespec start, end;
+            clock_gettime(CLOCK_MONOTONIC, &start);
+
+            // 请求环满时（上一持有者遗留的请求尚未处理完）等服务端取走，不覆盖未消费的槽位；
+            // 此时本客户端没有在途请求，已有的响应都是遗留的，丢弃后服务端才能继续取请求
+            uint32_t tail = channel->req_tail;
+            while (tail - __atomic_load_n(&channel->req_head, __ATOMIC_ACQUIRE) >= IPC_RING_SIZE) {
+                uint32_t seq = __atomic_load_n(&channel->resp_seq, __ATOMIC_ACQUIRE);
+                __atomic_store_n(&channel->resp_head, __atomic_load_n(&channel->resp_tail, __ATOMIC_ACQUIRE),
+                                 __ATOMIC_RELEASE);
+                ipcNotify(&segment->doorbell, &segment->server_waiting);
+                if (tail - __atomic_load_n(&channel->req_head, __ATOMIC_ACQUIRE) < IPC_RING_SIZE) break;
+                ipcWait(&channel->resp_seq, &channel->client_waiting, seq, wait_mode);
+            }
+            struct IpcRequest* request = &channel->requests[tail % IPC_RING_SIZE];
+            uint64_t id = next_id++;
+            request->id = id;
+            request->op = (uint32_t)op;
+            request->limit = 5;
+            memcpy(request->arg, line, strlen(line) + 1);
+            __atomic_store_n(&channel->req_tail, tail + 1, __ATOMIC_RELEASE);
+            ipcNotify(&segment->doorbell, &segment->server_waiting);
+
+            // 单请求往返：等待编号相符的响应；上一持有者遗留请求的响应直接丢弃
+            uint32_t head = channel->resp_head;
+            for (;;) {
+                uint32_t seq = __atomic_load_n(&channel->resp_seq, __ATOMIC_ACQUIRE);
+                if (__atomic_load_n(&channel->resp_tail, __ATOMIC_ACQUIRE) != head) {
+                    if (channel->responses[head % IPC_RING_SIZE].id == id) break;
+                    __atomic_store_n(&channel->resp_head, ++head, __ATOMIC_RELEASE);
+                    continue;
+                }
+                ipcWait(&channel->resp_seq, &channel->client_waiting, seq, wait_mode);
+            }
+            response = &channel->responses[head % IPC_RING_SIZE];
+
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            double micros = (end.tv_sec - start.tv_sec) * 1e6 + (end.tv_nsec - start.tv_nsec) / 1e3;
+            if (samples) samples[r] = micros;
+            if (r + 1 < repeat) {
+                __atomic_store_n(&channel->resp_head, head + 1, __ATOMIC_RELEASE);
+            } else if (samples == NULL) {
+                printf("（往返 %.1f 微秒）\n", micros);
+            }
+        }
+
+        if (response->status == QUERY_STATUS_OK) {
+            fwrite(response->data, 1, response->length, stdout);
+        } else {
+            printf(response->status == QUERY_STATUS_INVALID ? "请求无效\n" : "未找到\n");
+        }
+        __atomic_store_n(&channel->resp_head, channel->resp_head + 1, __ATOMIC_RELEASE);
+
+        if (samples) {
+            qsort(samples, repeat, sizeof(double), compareDouble);
+            printf("（%d 次往返：p50 %.1f 微秒，p99 %.1f 微秒）\n", repeat,
+                   samples[repeat / 2], samples[repeat * 99 / 100]);
+        }
+        fflush(stdout);
+    }
+
+    free(samples);
+    __atomic_store_n(&channel->owner, 0, __ATOMIC_RELEASE);
+    munmap(segment, sizeof(*segment));
+    return 0;
+}
+#else
+int runIpcServer(struct TreeNode* root, const char* name, int wait_mode) {
+    (void)root;
+    (void)name;
+    (void)wait_mode;
+    printf("共享内存IPC仅支持Linux\n");
+    return 1;
+}
+
+int runIpcClient(const char* name, int wait_mode, int repeat) {
+    (void)name;
+    (void)wait_mode;
+    (void)repeat;
+    printf("共享内存IPC仅支持Linux\n");
+    return 1;
+}
+#endif
+
+// 25. 网络服务函数组
+#ifndef _WIN32
+static void netPut32(unsigned char* p, uint32_t value) {
+    p[0] = (unsigned char)(value >> 24);
+    p[1] = (unsigned char)(value >> 16);
+    p[2] = (unsigned char)(value >> 8);
+    p[3] = (unsigned char)value;
+}
+
+static uint32_t netGet32(const unsigned char* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static int netSendAll(int fd, const void* data, size_t length, int flags) {
+    const char* p = data;
+    while (length > 0) {
+        ssize_t sent = send(fd, p, length, flags | MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        p += sent;
+        length -= (size_t)sent;
+    }
+    return 0;
+}
+
+/**
+ * @brief 写回一个响应帧；同一连接的响应由写锁串行化，不同请求之间不保证顺序
+ */
+static void netSendResponse(struct NetConnection* conn, uint32_t id, int status, const struct QueryOutput* out) {
+    unsigned char header[NET_RESPONSE_HEADER];
+    netPut32(header, (uint32_t)(NET_RESPONSE_HEADER - 4 + out->length));
+    netPut32(header + 4, id);
+    header[8] = (unsigned char)status;
+    header[9] = out->truncated ? NET_FLAG_TRUNCATED : 0;
+    header[10] = header[11] = 0;
+
+    pthread_mutex_lock(&conn->write_lock);
+    if (!conn->broken) {
+        if (netSendAll(conn->fd, header, sizeof(header), out->length > 0 ? MSG_MORE : 0) != 0 ||
+            (out->length > 0 && netSendAll(conn->fd, out->data, out->length, 0) != 0)) {
+            conn->broken = 1;
+        }
+    }
+    pthread_mutex_unlock(&conn->write_lock);
+}
+
+/**
+ * @brief 归还请求槽位，唤醒因在途请求过多而暂停读取的连接
+ */
+static void netReleaseJob(struct NetConnection* conn, struct NetJob* job) {
+    pthread_mutex_lock(&conn->slot_lock);
+    job->next = conn->free_jobs;
+    conn->free_jobs = job;
+    conn->inflight--;
+    pthread_cond_signal(&conn->slot_freed);
+    pthread_mutex_unlock(&conn->slot_lock);
+}
+
+/**
+ * @brief 从队列取下一个请求：轻量类优先，重量类受并发上限约束（调用时持有服务锁）
+ */
+static struct NetJob* netTakeJob(struct NetServer* server) {
+    int query_class = QUERY_CLASS_CHEAP;
+    if (server->queue_head[query_class] == NULL) {
+        query_class = QUERY_CLASS_HEAVY;
+        if (server->queue_head[query_class] == NULL || server->heavy_running >= server->heavy_limit) {
+            return NULL;
+        }
+    }
+
+    struct NetJob* job = server->queue_head[query_class];
+    server->queue_head[query_class] = job->next;
+    if (job->next == NULL) server->queue_tail[query_class] = NULL;
+    if (query_class == QUERY_CLASS_HEAVY) {
+        server->heavy_backlog -= job->cost;
+        server->heavy_running++;
+    }
+    return job;
+}
+
+/**
+ * @brief 工作线程：按类别从队列取请求执行，完成即写回
+ */
+static void* netWorkerMain(void* arg) {
+    struct NetServer* server = arg;
+    struct QueryOutput out = { .growable = 1 };
+
+    bindLocalReplica();
+    struct TreeNode* root = localRoot(server->root);
+
+    pthread_mutex_lock(&server->lock);
+    for (;;) {
+        struct NetJob* job = netTakeJob(server);
+        if (job == NULL) {
+            // 连接全部关闭后才会停止，此时队列已空
+            if (server->stopping) break;
+            pthread_cond_wait(&server->ready, &server->lock);
+            continue;
+        }
+        pthread_mutex_unlock(&server->lock);
+
+        struct NetConnection* conn = job->conn;
+        int status = executeQuery(root, job->op, job->arg, job->limit,
+                                  job->op == QUERY_OP_QL ? job->prepared : NULL, &out);
+        netSendResponse(conn, job->id, status, &out);
+        // 每个请求结束时整体重置临时区，执行路径不调用malloc/free
+        scratchReset(0);
+
+        pthread_mutex_lock(&server->lock);
+        if (job->query_class == QUERY_CLASS_HEAVY) {
+            server->heavy_running--;
+            conn->heavy_inflight--;
+            pthread_cond_signal(&server->ready);
+        }
+        server->served++;
+        pthread_mutex_unlock(&server->lock);
+
+        netReleaseJob(conn, job);
+        pthread_mutex_lock(&server->lock);
+    }
+    pthread_mutex_unlock(&server->lock);
+
+    free(out.data);
+    scratchRelease();
+    return NULL;
+}
+
+/**
+ * @brief 连接读取线程：解析流水线请求帧并投递到工作队列
+ */
+static void* netConnectionMain(void* arg) {
+    struct NetConnection* conn = arg;
+    struct NetServer* server = conn->server;
+    unsigned char* buffer = malloc(NET_READ_BUFFER);
+    size_t filled = 0;
+
+    while (buffer != NULL) {
+        ssize_t got = recv(conn->fd, buffer + filled, NET_READ_BUFFER - filled, 0);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) break;
+        filled += (size_t)got;
+
+        size_t offset = 0;
+        int bad_frame = 0;
+        while (filled - offset >= 4) {
+            uint32_t length = netGet32(buffer + offset);
+            if (length < NET_REQUEST_HEADER - 4 || length > NET_READ_BUFFER - 4) {
+                bad_frame = 1;
+                break;
+            }
+            if (filled - offset < 4 + (size_t)length) break;
+
+            const unsigned char* frame = buffer + offset + 4;
+            size_t arg_length = length - (NET_REQUEST_HEADER - 4);
+
+            // 在途请求达到上限时停止读取，由TCP窗口把压力传回客户端
+            pthread_mutex_lock(&conn->slot_lock);
+            while (conn->free_jobs == NULL) {
+                pthread_cond_wait(&conn->slot_freed, &conn->slot_lock);
+            }
+            struct NetJob* job = conn->free_jobs;
+            conn->free_jobs = job->next;
+            conn->inflight++;
+            pthread_mutex_unlock(&conn->slot_lock);
+
+            job->conn = conn;
+            job->next = NULL;
+            job->id = netGet32(frame);
+            job->op = frame[4];
+            job->limit = ((int)frame[6] << 8) | frame[7];
+            if (arg_length < sizeof(job->arg)) {
+                memcpy(job->arg, frame + 8, arg_length);
+                job->arg[arg_length] = '\0';
+            } else {
+                job->op = 0;  // 参数过长，按无效请求应答
+                job->arg[0] = '\0';
+            }
+
+            // 执行前估算代价：重量类请求受每连接上限和全局排队代价约束，超出即明确拒绝
+            if (job->op == QUERY_OP_QL && job->prepared == NULL) job->prepared = malloc(sizeof(*job->prepared));
+            job->cost = estimateQueryCost(server->root, job->op, job->arg, job->limit,
+                                          job->op == QUERY_OP_QL ? job->prepared : NULL);
+            job->query_class = job->cost > NET_CHEAP_COST ? QUERY_CLASS_HEAVY : QUERY_CLASS_CHEAP;
+
+            pthread_mutex_lock(&server->lock);
+            int admitted = job->query_class == QUERY_CLASS_CHEAP ||
+                           (conn->heavy_inflight < NET_CONN_HEAVY_LIMIT &&
+                            server->heavy_backlog + job->cost <= NET_HEAVY_BACKLOG);
+            if (admitted) {
+                int query_class = job->query_class;
+                if (query_class == QUERY_CLASS_HEAVY) {
+                    conn->heavy_inflight++;
+                    server->heavy_backlog += job->cost;
+                }
+                if (server->queue_tail[query_class] != NULL) {
+                    server->queue_tail[query_class]->next = job;
+                } else {
+                    server->queue_head[query_class] = job;
+                }
+                server->queue_tail[query_class] = job;
+                pthread_cond_signal(&server->ready);
+            } else {
+                server->shed++;
+            }
+            pthread_mutex_unlock(&server->lock);
+
+            if (!admitted) {
+                struct QueryOutput empty = { 0 };
+                netSendResponse(conn, job->id, QUERY_STATUS_OVERLOADED, &empty);
+                netReleaseJob(conn, job);
+            }
+
+            offset += 4 + (size_t)length;
+        }
+        if (bad_frame) break;
+
+        memmove(buffer, buffer + offset, filled - offset);
+        filled -= offset;
+    }
+    free(buffer);
+
+    // 等本连接的请求全部写回后再关闭
+    pthread_mutex_lock(&conn->slot_lock);
+    while (conn->inflight > 0) {
+        pthread_cond_wait(&conn->slot_freed, &conn->slot_lock);
+    }
+    pthread_mutex_unlock(&conn->slot_lock);
+
+    __atomic_store_n(&conn->finished, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+/**
+ * @brief 解析一条RESP命令（多条批量字符串数组，或以空白分隔的内联命令）
+ * @return 已消费字节数；数据不完整返回0，协议错误返回-1
+ * @note 参数指向输入缓冲区，未以'\0'结尾；超出RESP_MAX_ARGS的参数只计数
+ */
+static long respParseCommand(const char* buf, size_t len, const char** args, size_t* arg_lens, int* argc) {
+    const char* end = buf + len;
+    const char* line_end = memchr(buf, '\n', len);
+    *argc = 0;
+    if (line_end == NULL) return len >= NET_READ_BUFFER ? -1 : 0;
+
+    if (buf[0] != '*') {
+        // 内联命令，便于telnet/nc调试
+        const char* p = buf;
+        while (p < line_end) {
+            while (p < line_end && isspace((unsigned char)*p)) p++;
+            const char* start = p;
+            while (p < line_end && !isspace((unsigned char)*p)) p++;
+            if (p > start) {
+                if (*argc < RESP_MAX_ARGS) {
+                    args[*argc] = start;
+                    arg_lens[*argc] = (size_t)(p - start);
+                }
+                (*argc)++;
+            }
+        }
+        return line_end + 1 - buf;
+    }
+
+    long count = strtol(buf + 1, NULL, 10);
+    if (count < 0 || count > 1024) return -1;
+    const char* p = line_end + 1;
+    for (long i = 0; i < count; i++) {
+        line_end = p < end ? memchr(p, '\n', (size_t)(end - p)) : NULL;
+        if (line_end == NULL) return 0;
+        if (*p != '$') return -1;
+        long size = strtol(p + 1, NULL, 10);
+        if (size < 0 || size > (long)NET_READ_BUFFER) return -1;
+        p = line_end + 1;
+        if (end - p < size + 2) return 0;
+        if (*argc < RESP_MAX_ARGS) {
+            args[*argc] = p;
+            arg_lens[*argc] = (size_t)size;
+        }
+        (*argc)++;
+        p += size + 2;
+    }
+    return p - buf;
+}
+
+static int respArgEquals(const char* arg, size_t length, const char* word) {
+    return strlen(word) == length && strncasecmp(arg, word, length) == 0;
+}
+
+static void respAppendText(struct QueryOutput* reply, const char* text) {
+    queryOutputAppend(reply, text, strlen(text));
+}
+
+static void respAppendBulk(struct QueryOutput* reply, const char* data, size_t length) {
+    char header[32];
+    int n = snprintf(header, sizeof(header), "$%zu\r\n", length);
+    queryOutputAppend(reply, header, (size_t)n);
+    queryOutputAppend(reply, data, length);
+    respAppendText(reply, "\r\n");
+}
+
+/**
+ * @brief 把查询结果逐行转为RESP应答：单条查询返回批量字符串，其余返回数组
+ */
+static void respAppendResult(struct QueryOutput* reply, int status, const struct QueryOutput* out, int single) {
+    char header[32];
+    if (status == QUERY_STATUS_INVALID) {
+        // 查询语句的编译错误放在输出中，原样作为错误信息返回
+        if (out->length > 0) {
+            respAppendText(reply, "-ERR ");
+            queryOutputAppend(reply, out->data, out->length);
+            respAppendText(reply, "\r\n");
+        } else {
+            respAppendText(reply, "-ERR invalid argument\r\n");
+        }
+        return;
+    }
+    if (single) {
+        if (status != QUERY_STATUS_OK || out->length == 0) {
+            respAppendText(reply, "$-1\r\n");
+        } else {
+            respAppendBulk(reply, out->data, out->length - 1);
+        }
+        return;
+    }
+
+    int lines = 0;
+    for (size_t i = 0; i < out->length; i++) {
+        if (out->data[i] == '\n') lines++;
+    }
+    int n = snprintf(header, sizeof(header), "*%d\r\n", lines);
+    queryOutputAppend(reply, header, (size_t)n);
+    const char* line = out->data;
+    for (int i = 0; i < lines; i++) {
+        const char* line_end = strchr(line, '\n');
+        respAppendBulk(reply, line, (size_t)(line_end - line));
+        line = line_end + 1;
+    }
+}
+
+/**
+ * @brief 执行一条RESP命令并追加应答
+ * @return 收到QUIT时返回1，否则返回0
+ */
+static int respExecute(struct NetServer* server, struct TreeNode* root, const char** args,
+                       const size_t* arg_lens, int argc, struct QueryOutput* out, struct QueryOutput* reply) {
+    static const struct {
+        const char* name;
+        int op;
+        int min_args;
+        int max_args;
+    } commands[] = {
+        { "REGION.GET", QUERY_OP_CODE, 2, 2 },
+        { "REGION.SEARCH", QUERY_OP_NAME, 2, 3 },
+        { "REGION.CHILDREN", QUERY_OP_CHILDREN, 2, 3 },
+        { "REGION.SIBLINGS", QUERY_OP_SIBLINGS, 2, 3 },
+        { "REGION.ANCESTORS", QUERY_OP_ANCESTORS, 2, 2 },
+        { "REGION.SAMPLE", QUERY_OP_SAMPLE, 2, 3 },
+        { "REGION.CONVERT", QUERY_OP_CONVERT, 2, 2 },
+        { "REGION.SUBTREE", QUERY_OP_SUBTREE, 2, 3 },
+        { "REGION.STATS", QUERY_OP_STATS, 2, 2 },
+        { "REGION.QUERY", QUERY_OP_QL, 2, 2 },
+        { "REGION.LOCATE", QUERY_OP_LOCATE, 2, 2 },
+        { "REGION.NEAREST", QUERY_OP_NEAREST, 2, 3 },
+        { "REGION.NEIGHBORS", QUERY_OP_NEIGHBORS, 2, 3 },
+    };
+
+    if (argc == 0) return 0;
+    if (respArgEquals(args[0], arg_lens[0], "PING")) {
+        respAppendText(reply, "+PONG\r\n");
+        return 0;
+    }
+    if (respArgEquals(args[0], arg_lens[0], "QUIT")) {
+        respAppendText(reply, "+OK\r\n");
+        return 1;
+    }
+    if (respArgEquals(args[0], arg_lens[0], "COMMAND")) {
+        // redis-cli启动时查询命令表，返回空表即可
+        respAppendText(reply, "*0\r\n");
+        return 0;
+    }
 
-    printf("正在对节点进行排序...");
-    qsort(codeToNode, size, sizeof(*codeToNode), compareCodeToNode);
-    printf("完成\n");
+    for (size_t c = 0; c < sizeof(commands) / sizeof(commands[0]); c++) {
+        if (!respArgEquals(args[0], arg_lens[0], commands[c].name)) continue;
+        if (argc < commands[c].min_args || argc > commands[c].max_args) {
+            respAppendText(reply, "-ERR wrong number of arguments\r\n");
+            return 0;
+        }
 
-    // 创建虚拟的全国根节点
-    struct Region china = {
-        .code = "000000000000",
-        .name = "中华人民共和国",
-        .level = 0,
-        .parent_code = "0",
-        .type = 0,
-        .avg_house_price = NULL,
-        .employment_rate = NULL
-    };
-    
-    struct TreeNode* root = createNode(china);
-    if (root == NULL) {
-        printf("创建根节点失败\n");
-        for (int i = 0; i < size; i++) {
-            free(nodes[i]->children);
-            free(nodes[i]);
+        char arg[QUERY_ARG_MAX];
+        int limit = 0;
+        if (arg_lens[1] >= sizeof(arg)) {
+            respAppendText(reply, "-ERR invalid argument\r\n");
+            return 0;
+        }
+        memcpy(arg, args[1], arg_lens[1]);
+        arg[arg_lens[1]] = '\0';
+        if (argc == 3) {
+            char number[16];
+            size_t length = arg_lens[2] < sizeof(number) - 1 ? arg_lens[2] : sizeof(number) - 1;
+            memcpy(number, args[2], length);
+            number[length] = '\0';
+            limit = atoi(number);
         }
-        free(nodes);
-        free(codeToNode);
-        return NULL;
-    }
 
-    printf("开始建立父子关系...");
-    // 使用二分查找建立父子关系
-    for (int i = 0; i < size; i++) {
-        if (strcmp(regions[i].parent_code, "0") == 0) {
-            // 省级节点直接添加到根节点下
-            addChild(root, nodes[i]);
-        } else {
-            // 使用二分查找快速定位父节点
-            struct TreeNode* parent = NULL;
-            int left = 0, right = size - 1;
-            
-            while (left <= right) {
-                int mid = (left + right) / 2;
-                int cmp = strcmp(codeToNode[mid].code, regions[i].parent_code);
-                
-                if (cmp == 0) {
-                    parent = codeToNode[mid].node;
-                    break;
-                } else if (cmp < 0) {
-                    left = mid + 1;
-                } else {
-                    right = mid - 1;
-                }
+        // RESP按连接顺序执行，重量类请求只限制全局并发，超出时返回BUSY由客户端重试
+        struct PreparedQuery prepared;
+        int heavy = estimateQueryCost(root, commands[c].op, arg, limit, &prepared) > NET_CHEAP_COST;
+        if (heavy) {
+            pthread_mutex_lock(&server->lock);
+            int admitted = server->heavy_running < server->heavy_limit;
+            if (admitted) {
+                server->heavy_running++;
+            } else {
+                server->shed++;
             }
-            
-            // 找到父节点后建立关系
-            if (parent) {
-                addChild(parent, nodes[i]);
+            pthread_mutex_unlock(&server->lock);
+            if (!admitted) {
+                respAppendText(reply, "-BUSY server overloaded, retry later\r\n");
+                return 0;
             }
         }
-        
-        if (i % 1000 == 0 || i == size - 1) {
-            printf("\r已处理 %d/%d 个节点的父子关系... (%.1f%%)", 
-                   i + 1, size, (float)(i + 1)/size*100);
-            fflush(stdout);
+
+        int status = executeQuery(root, commands[c].op, arg, limit,
+                                  commands[c].op == QUERY_OP_QL ? &prepared : NULL, out);
+        respAppendResult(reply, status, out, commands[c].op == QUERY_OP_CODE);
+
+        if (heavy) {
+            pthread_mutex_lock(&server->lock);
+            server->heavy_running--;
+            pthread_mutex_unlock(&server->lock);
         }
+        return 0;
     }
-    printf("\n父子关系建立完成\n");
 
-    // 清理临时数据结构
-    free(codeToNode);
-    free(nodes);
-    return root;
+    respAppendText(reply, "-ERR unknown command\r\n");
+    return 0;
 }
 
-void freeTree(struct TreeNode* root) {
-    if (root == NULL) return;
-    
-    // 递归释放所有子节点
-    for (int i = 0; i < root->child_count; i++) {
-        freeTree(root->children[i]);
-    }
-    
-    // 释放当前节点的资源
-    free(root->children);
-    free(root);
-}
+/**
+ * @brief RESP连接线程：流水线命令按顺序执行，一批输入处理完后合并写出应答
+ */
+static void* respConnectionMain(void* arg) {
+    struct NetConnection* conn = arg;
+    struct QueryOutput out = { .growable = 1 };
+    struct QueryOutput reply = { .growable = 1 };
+    char* buffer = malloc(NET_READ_BUFFER);
+    size_t filled = 0;
+    int closing = 0;
 
-// 2. 数据查询函数组
-struct TreeNode* findNodeByCode(struct TreeNode* root, const char* code) {
-    if (root == NULL) return NULL;
-    if (strcmp(root->data.code, code) == 0) return root;
+    bindLocalReplica();
+    struct TreeNode* root = localRoot(conn->server->root);
 
-    for (int i = 0; i < root->child_count; i++) {
-        struct TreeNode* found = findNodeByCode(root->children[i], code);
-        if (found != NULL) return found;
+    while (buffer != NULL && !closing) {
+        ssize_t got = recv(conn->fd, buffer + filled, NET_READ_BUFFER - filled, 0);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) break;
+        filled += (size_t)got;
+
+        size_t offset = 0;
+        while (offset < filled && !closing) {
+            const char* args[RESP_MAX_ARGS];
+            size_t arg_lens[RESP_MAX_ARGS];
+            int argc;
+            long used = respParseCommand(buffer + offset, filled - offset, args, arg_lens, &argc);
+            if (used == 0) break;
+            if (used < 0) {
+                respAppendText(&reply, "-ERR protocol error\r\n");
+                closing = 1;
+                break;
+            }
+            offset += (size_t)used;
+
+            if (argc > RESP_MAX_ARGS) {
+                respAppendText(&reply, "-ERR wrong number of arguments\r\n");
+            } else {
+                closing = respExecute(conn->server, root, args, arg_lens, argc, &out, &reply);
+                scratchReset(0);
+            }
+            if (reply.length >= RESP_FLUSH_BYTES) {
+                if (netSendAll(conn->fd, reply.data, reply.length, 0) != 0) closing = 1;
+                queryOutputReset(&reply);
+            }
+        }
+        // 缓冲区已满仍不是完整命令：先回复错误再关闭，不静默断开
+        if (offset == 0 && filled == NET_READ_BUFFER && !closing) {
+            respAppendText(&reply, "-ERR command too long\r\n");
+            closing = 1;
+        }
+
+        if (reply.length > 0) {
+            if (netSendAll(conn->fd, reply.data, reply.length, 0) != 0) closing = 1;
+            queryOutputReset(&reply);
+        }
+        memmove(buffer, buffer + offset, filled - offset);
+        filled -= offset;
     }
+
+    free(buffer);
+    free(out.data);
+    free(reply.data);
+    scratchRelease();
+    __atomic_store_n(&conn->finished, 1, __ATOMIC_RELEASE);
     return NULL;
 }
 
-void findByNameRecursive(struct TreeNode* root, const char* name, int* found) {
-    if (root == NULL || *found >= 5) return;
-    
-    if (strstr(root->data.name, name) != NULL) {
-        displayNodeInfo(root, *found > 0);
-        (*found)++;
-        if (*found >= 5) {
-            printf("\n结果过多，仅显示前5条...\n");
-            return;
-        }
-    }
-    
-    for (int i = 0; i < root->child_count; i++) {
-        findByNameRecursive(root->children[i], name, found);
+static void netFreeConnection(struct NetConnection* conn) {
+    pthread_join(conn->reader, NULL);
+    close(conn->fd);
+    for (int i = 0; i < NET_MAX_INFLIGHT; i++) {
+        free(conn->jobs[i].prepared);
     }
+    pthread_mutex_destroy(&conn->write_lock);
+    pthread_mutex_destroy(&conn->slot_lock);
+    pthread_cond_destroy(&conn->slot_freed);
+    free(conn);
 }
 
-void findByCode(struct TreeNode* node, const char* code) {
-    if (validateCode(code) != 0) {
-        printf("错误：无效的区划代码格式\n");
-        return;
+static struct NetConnection* netOpenConnection(struct NetServer* server, int fd) {
+    struct NetConnection* conn = calloc(1, sizeof(*conn));
+    if (conn == NULL) return NULL;
+
+    conn->fd = fd;
+    conn->server = server;
+    pthread_mutex_init(&conn->write_lock, NULL);
+    pthread_mutex_init(&conn->slot_lock, NULL);
+    pthread_cond_init(&conn->slot_freed, NULL);
+    for (int i = 0; i < NET_MAX_INFLIGHT; i++) {
+        conn->jobs[i].next = conn->free_jobs;
+        conn->free_jobs = &conn->jobs[i];
     }
-    
-    struct TreeNode* found = findNodeByCode(node, code);
-    if (found) {
-        displayNodeInfo(found, 0);
-    } else {
-        printf("未找到代码为 %s 的地区\n", code);
+
+    void* (*entry)(void*) = server->protocol == NET_PROTO_RESP ? respConnectionMain : netConnectionMain;
+    if (pthread_create(&conn->reader, NULL, entry, conn) != 0) {
+        pthread_mutex_destroy(&conn->write_lock);
+        pthread_mutex_destroy(&conn->slot_lock);
+        pthread_cond_destroy(&conn->slot_freed);
+        free(conn);
+        return NULL;
     }
+    return conn;
 }
 
-void findByName(struct TreeNode* root, const char* name) {
-    if (!root || !name || validateName(name) != 0) {
-        printf("错误：无效的查询名称\n");
-        return;
-    }
-    
-    int count = 0;
-    findByNameRecursive(root, name, &count);
-    
-    if (count == 0) {
-        printf("未找到包含 '%s' 的地区\n", name);
+/**
+ * @brief 创建监听套接字：纯数字按TCP端口处理，否则作为Unix域套接字路径
+ */
+static int netListen(const char* endpoint, int* is_unix) {
+    int fd;
+    const char* p = endpoint;
+    while (isdigit((unsigned char)*p)) p++;
+    *is_unix = *p != '\0';
+
+    if (*is_unix) {
+        struct sockaddr_un addr = { .sun_family = AF_UNIX };
+        if (strlen(endpoint) >= sizeof(addr.sun_path)) {
+            printf("错误：套接字路径过长\n");
+            return -1;
+        }
+        memcpy(addr.sun_path, endpoint, strlen(endpoint) + 1);
+        unlink(endpoint);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+            perror("无法绑定套接字");
+            if (fd >= 0) close(fd);
+            return -1;
+        }
     } else {
-        printf("\n共找到 %d 个匹配项\n", count);
+        int port = atoi(endpoint);
+        int on = 1;
+        struct sockaddr_in addr = { .sin_family = AF_INET, .sin_port = htons((uint16_t)port),
+                                    .sin_addr.s_addr = htonl(INADDR_ANY) };
+        if (port <= 0 || port > 65535) {
+            printf("错误：端口号无效\n");
+            return -1;
+        }
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd >= 0) setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        if (fd < 0 || bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+            perror("无法绑定端口");
+            if (fd >= 0) close(fd);
+            return -1;
+        }
     }
-}
 
-// 3. 数据验证函数组
-static int validateCode(const char* code) {
-    if (strlen(code) != 12) return -1;
-    
-    for (int i = 0; i < 12; i++) {
-        if (!isdigit(code[i])) return -2;
+    if (listen(fd, 128) != 0) {
+        perror("监听失败");
+        close(fd);
+        return -1;
     }
-    return 0;
+    return fd;
 }
 
-static int validateName(const char* name) {
-    if (name == NULL || *name == '\0') return -1;
-    
-    int len = strlen(name);
-    if (len >= MAX_NAME_LENGTH) return -2;
-    
-    // 检查是否只包含空白字符
-    for (int i = 0; i < len; i++) {
-        if (!isspace(name[i])) return 0;
-    }
-    return -3;
-}
+int runQueryServer(struct TreeNode* root, const char* endpoint, int protocol) {
+    int is_unix;
+    int listen_fd = netListen(endpoint, &is_unix);
+    if (listen_fd < 0) return 1;
 
-// 4. 数据显示函数组
-static void displayNodeInfo(struct TreeNode* node, int show_separator) {
-    if (node == NULL) return;
-    
-    if (show_separator) {
-        printf("----------------------------------------\n");
+    struct NetServer server = { .protocol = protocol, .root = root };
+    pthread_mutex_init(&server.lock, NULL);
+    pthread_cond_init(&server.ready, NULL);
+
+    // RESP连接在各自线程内按序执行，只有二进制协议需要工作线程池
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int worker_count = protocol == NET_PROTO_BINARY ? (cpus < 2 ? 2 : (int)cpus) : 0;
+    server.heavy_limit = cpus > 2 ? (int)cpus - 1 : 1;
+    pthread_t* workers = malloc(sizeof(pthread_t) * (worker_count + 1));
+    int started = 0;
+    while (workers != NULL && started < worker_count &&
+           pthread_create(&workers[started], NULL, netWorkerMain, &server) == 0) {
+        started++;
     }
-    
-    // 基本信息显示
-    printf("名称: %s\n", node->data.name);
-    printf("代码: %s\n", node->data.code);
-    printf("级别: %s\n", 
-        (node->data.level >= 0 && node->data.level <= 5) ? 
-        LEVEL_NAMES[node->data.level] : "未知级别");
-    
-    // 修改扩展数据显示部分
-    if (node->data.avg_house_price && *node->data.avg_house_price > 0) {
-        printf("平均房价: %.2f 元/平方米\n", *node->data.avg_house_price);
+    if (workers == NULL || started < worker_count) {
+        printf("错误：无法创建工作线程\n");
+        server.stopping = 1;
+        pthread_cond_broadcast(&server.ready);
+        for (int i = 0; i < started; i++) pthread_join(workers[i], NULL);
+        free(workers);
+        close(listen_fd);
+        return 1;
+    }
+
+    installStopHandlers();
+    if (protocol == NET_PROTO_RESP) {
+        printf("RESP服务已启动：%s %s，每连接一个线程按序应答（Ctrl+C 退出）\n",
+               is_unix ? "Unix套接字" : "TCP端口", endpoint);
     } else {
-        printf("平均房价: 暂无数据\n");
+        printf("二进制协议服务已启动：%s %s，%d 个工作线程（重量类最多占 %d 个），每连接最多 %d 个在途请求（Ctrl+C 退出）\n",
+               is_unix ? "Unix套接字" : "TCP端口", endpoint, started, server.heavy_limit, NET_MAX_INFLIGHT);
     }
-    
-    printf("就业率: %s\n", 
-        (node->data.employment_rate && strcmp(node->data.employment_rate, "N/A") != 0) ? 
-        node->data.employment_rate : "暂无数据");
-    
-    // 显示层级关系
-    printf("行政区划层级关系：\n");
-    struct TreeNode* current = node;
-    int level = 0;
-    
-    while (current && current->parent) {
-        for (int i = 0; i < level; i++) {
-            printf("   ");
+    fflush(stdout);
+
+    struct NetConnection* connections = NULL;
+    struct pollfd listener = { .fd = listen_fd, .events = POLLIN };
+    while (!g_stop_requested) {
+        // 回收已断开的连接
+        for (struct NetConnection** link = &connections; *link != NULL;) {
+            struct NetConnection* conn = *link;
+            if (__atomic_load_n(&conn->finished, __ATOMIC_ACQUIRE)) {
+                *link = conn->next;
+                netFreeConnection(conn);
+            } else {
+                link = &conn->next;
+            }
         }
-        printf("└─ %s\n", current->data.name);
-        current = current->parent;
-        level++;
+
+        if (poll(&listener, 1, NET_POLL_INTERVAL_MS) <= 0) continue;
+        int fd = accept(listen_fd, NULL, NULL);
+        if (fd < 0) continue;
+        if (!is_unix) {
+            int on = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        }
+
+        struct NetConnection* conn = netOpenConnection(&server, fd);
+        if (conn == NULL) {
+            close(fd);
+            continue;
+        }
+        conn->next = connections;
+        connections = conn;
     }
-}
 
-// 5. 数据加载函数组
-int loadRegionsFromCSV(struct Region regions[], const char* filename) {
-    FILE* file = fopen(filename, "r");
-    if (file == NULL) {
-        perror("无法打开文件");
-        return 0;
+    // 先断开所有连接并等待在途请求完成，再停止工作线程
+    close(listen_fd);
+    if (is_unix) unlink(endpoint);
+    for (struct NetConnection* conn = connections; conn != NULL; conn = conn->next) {
+        shutdown(conn->fd, SHUT_RDWR);
+    }
+    while (connections != NULL) {
+        struct NetConnection* conn = connections;
+        connections = conn->next;
+        netFreeConnection(conn);
     }
 
-    char line[MAX_LINE_LENGTH];
-    int count = 0;
-    
-    // 跳过标题行
-    fgets(line, MAX_LINE_LENGTH, file);
-    
-    while (fgets(line, MAX_LINE_LENGTH, file) && count < MAX_REGIONS) {
-        char* token = strtok(line, ",");
-        if (!token) continue;
-        
-        // 基本字段解析
-        strncpy(regions[count].code, token, MAX_CODE_LENGTH - 1);
-        
-        if (!(token = strtok(NULL, ","))) continue;
-        strncpy(regions[count].name, token, MAX_NAME_LENGTH - 1);
-        
-        if (!(token = strtok(NULL, ","))) continue;
-        regions[count].level = atoi(token);
-        
-        if (!(token = strtok(NULL, ","))) continue;
-        strncpy(regions[count].parent_code, token, MAX_CODE_LENGTH - 1);
-        
-        if (!(token = strtok(NULL, ","))) continue;
-        regions[count].type = atoi(token);
-        
-        // 可选字段处理
-        regions[count].avg_house_price = malloc(sizeof(double));
-        *regions[count].avg_house_price = (token = strtok(NULL, ",")) ? atof(token) : 0.0;
-        
-        regions[count].employment_rate = strdup((token = strtok(NULL, ",")) ? token : "N/A");
-        
-        count++;
+    pthread_mutex_lock(&server.lock);
+    server.stopping = 1;
+    pthread_cond_broadcast(&server.ready);
+    pthread_mutex_unlock(&server.lock);
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
     }
-    
-    fclose(file);
-    return count;
+    free(workers);
+
+    if (protocol == NET_PROTO_RESP) {
+        printf("\nRESP服务停止，过载拒绝 %llu 个请求\n", (unsigned long long)server.shed);
+    } else {
+        printf("\n二进制协议服务停止，共处理 %llu 个请求，过载拒绝 %llu 个\n",
+               (unsigned long long)server.served, (unsigned long long)server.shed);
+    }
+    pthread_mutex_destroy(&server.lock);
+    pthread_cond_destroy(&server.ready);
+    return 0;
 }
+#else
+int runQueryServer(struct TreeNode* root, const char* endpoint, int protocol) {
+    (void)root;
+    (void)endpoint;
+    (void)protocol;
+    printf("网络查询服务暂不支持Windows\n");
+    return 1;
+}
+#endif
 
-// 6. 用户界面函数组
+// 26. 用户界面函数组
 static int getInput(char* buffer, int max_len, const char* prompt) {
     printf("%s", prompt);
     if (!fgets(buffer, max_len, stdin)) {
@@ -470,6 +9829,8 @@ static int getInput(char* buffer, int max_len, const char* prompt) {
 int showMainMenu(struct TreeNode* root) {
     int choice;
     char search_term[MAX_NAME_LENGTH];
+    char prompt[64];
+    char query_text[QUERY_ARG_MAX];
     
     while (1) {
         printf("\n┌────────────────────────────────┐\n");
@@ -478,20 +9839,21 @@ int showMainMenu(struct TreeNode* root) {
         printf("│  1. 按代码查询地区信息         │\n");
         printf("│  2. 按名称查询地区信息         │\n");
         printf("│  3. 退出系统                   │\n");
+        printf("│  4. 条件查询（查询语句）       │\n");
         printf("└────────────────────────────────┘\n");
-        printf("\n请输入选项编号 [1-3]: ");
+        printf("\n请输入选项编号 [1-4]: ");
 
         if (scanf("%d", &choice) != 1) {
             while (getchar() != '\n');
-            printf("\n输入无效，请输入数字 1-3\n");
+            printf("\n输入无效，请输入数字 1-4\n");
             continue;
         }
         while (getchar() != '\n');
 
         switch (choice) {
             case 1:
-                if (getInput(search_term, MAX_NAME_LENGTH, 
-                    "\n=== 按代码查询 ===\n请输入12位区划代码：") != 0) {
+                snprintf(prompt, sizeof(prompt), "\n=== 按代码查询 ===\n请输入%d位区划代码：", g_code_scheme.total_digits);
+                if (getInput(search_term, MAX_NAME_LENGTH, prompt) != 0) {
                     printf("\n代码不能为空\n");
                     continue;
                 }
@@ -514,46 +9876,219 @@ int showMainMenu(struct TreeNode* root) {
             case 3:
                 return 0;
 
+            case 4: {
+                if (getInput(query_text, QUERY_ARG_MAX,
+                    "\n=== 条件查询 ===\n例：name CONTAINS \"新\" AND level = 5 AND type IN (111,112) UNDER 650100000000 LIMIT 10 RETURN code,name,path\n"
+                    "请输入查询语句：") != 0) {
+                    printf("\n查询语句不能为空\n");
+                    continue;
+                }
+                struct QueryOutput out = { .growable = 1 };
+                int status = executeQuery(root, QUERY_OP_QL, query_text, 0, NULL, &out);
+                printf("\n┌────────────── 查询结果 ──────────────┐\n\n");
+                if (status == QUERY_STATUS_INVALID) {
+                    printf("查询语句错误：%s\n", out.length > 0 ? out.data : "未知错误");
+                } else if (status == QUERY_STATUS_NOT_FOUND) {
+                    printf("未找到符合条件的地区\n");
+                } else {
+                    fputs(out.data, stdout);
+                }
+                printf("\n└─────────────────────────────────────┘\n");
+                free(out.data);
+                break;
+            }
+
             default:
-                printf("\n无效的选择，请输入 1-3\n");
+                printf("\n无效的选择，请输入 1-4\n");
         }
     }
 }
 
-// 7. 主函数
-int main() {
-    struct Region *regions = malloc(MAX_REGIONS * sizeof(struct Region));
-    if (regions == NULL) {
-        perror("内存分配失败");
-        return 1;
+// 27. 主函数
+int main(int argc, char* argv[]) {
+    int numa_replicate = 0;
+    const char* data_file = NULL;
+    const char* index_output = NULL;
+    const char* ipc_serve = NULL;
+    const char* ipc_client = NULL;
+    const char* server_endpoint = NULL;
+    const char* resolve_input = NULL;
+    const char* resolve_output = NULL;
+    const char* locate_input = NULL;
+    const char* locate_output = NULL;
+    const char* nearest_input = NULL;
+    const char* nearest_output = NULL;
+    const char* centroid_file = NULL;
+    const char* adjacency_file = NULL;
+    const char* sample_spec = NULL;
+    const char* sample_output = NULL;
+    const char* neighbors_input = NULL;
+    const char* neighbors_output = NULL;
+    const char* convert_input = NULL;
+    const char* convert_output = NULL;
+    const char* boundary_files[BOUNDARY_MAX_FILES];
+    int boundary_count = 0;
+    int server_protocol = NET_PROTO_BINARY;
+    int ipc_wait = IPC_WAIT_FUTEX;
+    int ipc_repeat = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--numa-replicate") == 0) {
+            numa_replicate = 1;
+        } else if (strcmp(argv[i], "--build-index") == 0 && i + 1 < argc) {
+            index_output = argv[++i];
+        } else if (strcmp(argv[i], "--ipc-serve") == 0 && i + 1 < argc) {
+            ipc_serve = argv[++i];
+        } else if (strcmp(argv[i], "--serve-binary") == 0 && i + 1 < argc) {
+            server_endpoint = argv[++i];
+            server_protocol = NET_PROTO_BINARY;
+        } else if (strcmp(argv[i], "--serve-resp") == 0 && i + 1 < argc) {
+            server_endpoint = argv[++i];
+            server_protocol = NET_PROTO_RESP;
+        } else if (strcmp(argv[i], "--resolve") == 0 && i + 2 < argc) {
+            resolve_input = argv[++i];
+            resolve_output = argv[++i];
+        } else if (strcmp(argv[i], "--boundaries") == 0 && i + 1 < argc && boundary_count < BOUNDARY_MAX_FILES) {
+            boundary_files[boundary_count++] = argv[++i];
+        } else if (strcmp(argv[i], "--centroids") == 0 && i + 1 < argc) {
+            centroid_file = argv[++i];
+        } else if (strcmp(argv[i], "--code-scheme") == 0 && i + 1 < argc) {
+            // 须在加载数据前生效
+            if (setCodeScheme(argv[++i]) != 0) {
+                printf("错误：无效的代码方案 %s（可用 cn12、cn6 或 各级位数[:根代码]，最多%d级%d位）\n",
+                       argv[i], CODE_SCHEME_MAX_LEVELS, CODE_SCHEME_MAX_DIGITS);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--sample") == 0 && i + 2 < argc) {
+            sample_spec = argv[++i];
+            sample_output = argv[++i];
+        } else if (strcmp(argv[i], "--adjacency") == 0 && i + 1 < argc) {
+            adjacency_file = argv[++i];
+        } else if (strcmp(argv[i], "--convert-codes") == 0 && i + 2 < argc) {
+            convert_input = argv[++i];
+            convert_output = argv[++i];
+        } else if (strcmp(argv[i], "--neighbors") == 0 && i + 2 < argc) {
+            neighbors_input = argv[++i];
+            neighbors_output = argv[++i];
+        } else if (strcmp(argv[i], "--nearest") == 0 && i + 2 < argc) {
+            nearest_input = argv[++i];
+            nearest_output = argv[++i];
+        } else if (strcmp(argv[i], "--locate") == 0 && i + 2 < argc) {
+            locate_input = argv[++i];
+            locate_output = argv[++i];
+        } else if (strcmp(argv[i], "--ipc-client") == 0 && i + 1 < argc) {
+            ipc_client = argv[++i];
+        } else if (strcmp(argv[i], "--ipc-wait") == 0 && i + 1 < argc) {
+            ipc_wait = strcmp(argv[++i], "poll") == 0 ? IPC_WAIT_POLL : IPC_WAIT_FUTEX;
+        } else if (strcmp(argv[i], "--ipc-bench") == 0 && i + 1 < argc) {
+            ipc_repeat = atoi(argv[++i]);
+            if (ipc_repeat < 1) ipc_repeat = 1;
+        } else if (argv[i][0] != '-' && data_file == NULL) {
+            data_file = argv[i];
+        } else {
+            printf("未知参数: %s\n", argv[i]);
+            printf("用法: %s [数据文件(.csv/.idx)] [--code-scheme cn12|cn6|各级位数[:根代码]]\n"
+                   "       [--build-index 输出文件] [--numa-replicate]\n"
+                   "       [--ipc-serve 名称 | --ipc-client 名称 [--ipc-bench 次数]] [--ipc-wait poll|futex]\n"
+                   "       [--serve-binary 端口|套接字路径 | --serve-resp 端口|套接字路径]\n"
+                   "       [--resolve 地址文件 输出文件|-]\n"
+                   "       [--boundaries 边界文件(GeoJSON) ...] [--locate 坐标文件 输出文件|-]\n"
+                   "       [--centroids 质心文件] [--nearest 查询文件 输出文件|-]\n"
+                   "       [--adjacency 邻接文件] [--neighbors 查询文件 输出文件|-]\n"
+                   "       [--convert-codes 代码文件 输出文件|-]\n"
+                   "       [--sample 所属代码,级别,分组级别,每层条数[,按类型[,种子]] 输出文件|-]\n",
+                   argv[0]);
+            return 1;
+        }
     }
 
-    printf("\n=== 中国行政区划数据管理与查询系统 ===\n");
-    
-    int size = loadRegionsFromCSV(regions, "area_data.csv");
+    // 客户端不加载数据，直接连接服务端
+    if (ipc_client != NULL) {
+        return runIpcClient(ipc_client, ipc_wait, ipc_repeat);
+    }
 
-    if (size == 0) {
-        printf("错误：数据加载失败\n");
-        free(regions);
-        return 1;
+#ifndef _WIN32
+    // 批量结果写到标准输出时，标准输出只留结果：另存一份原标准输出写结果，加载进度等提示改写到标准错误
+    const char* batch_outputs[] = { resolve_output, locate_output, nearest_output, neighbors_output, convert_output,
+                                    sample_output };
+    for (size_t i = 0; i < sizeof(batch_outputs) / sizeof(batch_outputs[0]); i++) {
+        if (batch_outputs[i] == NULL || strcmp(batch_outputs[i], "-") != 0) continue;
+        int fd = dup(STDOUT_FILENO);
+        g_result_output = fd >= 0 ? fdopen(fd, "wb") : NULL;
+        if (g_result_output != NULL) dup2(STDERR_FILENO, STDOUT_FILENO);
+        break;
     }
+#endif
 
-    printf("成功加载 %d 条区划数据\n", size);
+    printf("\n=== 中国行政区划数据管理与查询系统 ===\n");
 
-    struct TreeNode* root = buildTree(regions, size);
+    struct TreeNode* root = loadDataset(data_file);
     if (root == NULL) {
-        printf("错误：树结构构建失败\n");
-        free(regions);
         return 1;
     }
-    printf("树结构构建完成\n");
+    reportArenas();
+
+    int result = 0;
+    for (int i = 0; i < boundary_count && result == 0; i++) {
+        if (loadBoundaries(boundary_files[i]) != 0) result = 1;
+    }
+    if (result == 0 && centroid_file != NULL && loadCentroids(centroid_file) != 0) result = 1;
+    if (result == 0 && adjacency_file != NULL && loadAdjacency(adjacency_file) != 0) result = 1;
+
+    if (result != 0) {
+        // 边界文件有误时不继续，避免批量反查得到不完整的结果
+    } else if (index_output != NULL) {
+        // 仅生成预构建索引文件，供嵌入可执行文件或直接加载
+        result = writeIndexBlob(index_output) == 0 ? 0 : 1;
+    } else if (resolve_input != NULL) {
+        // 地址解析按名称索引查找各段文字的候选节点，先同步构建
+        buildNameIndex();
+        result = runResolvePipeline(root, resolve_input, resolve_output, RESOLVE_INPUT_ADDRESS);
+    } else if (locate_input != NULL) {
+        result = runResolvePipeline(root, locate_input, locate_output, RESOLVE_INPUT_POINT);
+    } else if (nearest_input != NULL) {
+        result = runResolvePipeline(root, nearest_input, nearest_output, RESOLVE_INPUT_NEAREST);
+    } else if (neighbors_input != NULL) {
+        result = runResolvePipeline(root, neighbors_input, neighbors_output, RESOLVE_INPUT_NEIGHBORS);
+    } else if (convert_input != NULL) {
+        if (g_code_scheme.total_digits != 12) {
+            printf("错误：6位与12位代码互换需使用12位代码方案（当前为 %s）\n", g_code_scheme.name);
+            result = 1;
+        } else {
+            result = runResolvePipeline(root, convert_input, convert_output, RESOLVE_INPUT_CODES);
+        }
+    } else if (sample_spec != NULL) {
+        // 分层抽样按级别与级别类型倒排链截取各层，先同步构建
+        buildNameIndex();
+        result = runSampleCommand(root, sample_spec, sample_output);
+    } else {
+        // 名称与级别索引只在查询时需要，生成索引文件时不构建
+        startNameIndexBuild();
 
-    int result = showMainMenu(root);
-    printf("\n系统退出\n");
+        // 多路服务器上按NUMA节点复制只读索引，各查询线程启动时分到一个节点并使用其副本
+        if (numa_replicate) replicateIndexPerNode();
+
+        if (ipc_serve != NULL) {
+            result = runIpcServer(localRoot(root), ipc_serve, ipc_wait);
+        } else if (server_endpoint != NULL) {
+            // 服务线程各自绑定本地副本，这里传主索引
+            result = runQueryServer(root, server_endpoint, server_protocol);
+        } else {
+            result = showMainMenu(localRoot(root));
+            printf("\n系统退出\n");
+        }
+    }
     
     // 释放资源
+    parallelShutdown();
+    scratchRelease();
+    freeNameIndex();
+    freeBoundaries();
+    freeCentroids();
+    freeAdjacency();
+    freeIndexReplicas();
+    freeRegionIndex();
     freeTree(root);
-    free(regions);
     
     return result;
-}
\ No newline at end of file
+}